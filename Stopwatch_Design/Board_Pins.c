@@ -0,0 +1,115 @@
+/**
+ * @file Board_Pins.c
+ *
+ * @brief Source code for the Board_Pins driver.
+ *
+ * This file contains the function definitions for the Board_Pins driver.
+ * It configures every pin in the board pin table (BOARD_PINS in Board_Pins.h).
+ * The register values of each port are constant expressions that are evaluated at build time,
+ * and the table is checked for conflicts at build time.
+ *
+ * @author Katherine Poz
+ */
+
+#include "Board_Pins.h"
+
+// Pins that must be unlocked through the GPIOLOCK and GPIOCR registers (PD7 and PF0)
+#define BOARD_LOCKED_PINS_D				0x80
+#define BOARD_LOCKED_PINS_F				0x01
+
+// Counts the table entries with an invalid pin number, PCTL value or mode
+#define BOARD_PIN_INVALID(a, port, pin, mode, pctl) \
+	+ (((pin) > 7) || ((pctl) > 15) || \
+	   (((mode) & BOARD_PIN_ALTERNATE) ? ((pctl) == 0) : ((pctl) != 0)) || \
+	   (((mode) & BOARD_PIN_PULL_DOWN) && ((mode) & BOARD_PIN_PULL_UP)))
+
+_Static_assert((0 BOARD_PINS(BOARD_PIN_INVALID, 0)) == 0, "Board pin table: invalid pin number, PCTL value or mode");
+
+_Static_assert(BOARD_PORT_PIN_SUM(BOARD_PORT_A) == BOARD_PORT_PINS(BOARD_PORT_A), "Board pin table: a pin of Port A is used twice");
+_Static_assert(BOARD_PORT_PIN_SUM(BOARD_PORT_B) == BOARD_PORT_PINS(BOARD_PORT_B), "Board pin table: a pin of Port B is used twice");
+_Static_assert(BOARD_PORT_PIN_SUM(BOARD_PORT_C) == BOARD_PORT_PINS(BOARD_PORT_C), "Board pin table: a pin of Port C is used twice");
+_Static_assert(BOARD_PORT_PIN_SUM(BOARD_PORT_D) == BOARD_PORT_PINS(BOARD_PORT_D), "Board pin table: a pin of Port D is used twice");
+_Static_assert(BOARD_PORT_PIN_SUM(BOARD_PORT_E) == BOARD_PORT_PINS(BOARD_PORT_E), "Board pin table: a pin of Port E is used twice");
+_Static_assert(BOARD_PORT_PIN_SUM(BOARD_PORT_F) == BOARD_PORT_PINS(BOARD_PORT_F), "Board pin table: a pin of Port F is used twice");
+
+// PC0 to PC3 are the JTAG/SWD pins used by the debugger
+_Static_assert((BOARD_PORT_PINS(BOARD_PORT_C) & 0x0F) == 0, "Board pin table: PC0 to PC3 are reserved for JTAG");
+
+// Port E and Port F only have pins 0 to 5 and 0 to 4
+_Static_assert((BOARD_PORT_PINS(BOARD_PORT_E) & 0xC0) == 0, "Board pin table: Port E only has PE0 to PE5");
+_Static_assert((BOARD_PORT_PINS(BOARD_PORT_F) & 0xE0) == 0, "Board pin table: Port F only has PF0 to PF4");
+
+typedef struct
+{
+	GPIOA_Type *port;				// Base address of the port
+	uint8_t pins;					// Pins of the port in the table
+	uint8_t output;					// DIR
+	uint8_t alternate;				// AFSEL
+	uint8_t pull_down;				// PDR
+	uint8_t pull_up;				// PUR
+	uint8_t high;					// Initial DATA
+	uint8_t locked;					// Pins that must be committed through GPIOCR
+	uint32_t pctl_mask;				// PCTL fields of the pins
+	uint32_t pctl;					// PCTL values of the pins
+} Board_Port_Config;
+
+#define BOARD_PORT_CONFIG(p, gpio, locked_pins) \
+	{ gpio, BOARD_PORT_PINS(p), \
+	  BOARD_PORT_FLAGS(p, BOARD_PIN_OUTPUT), BOARD_PORT_FLAGS(p, BOARD_PIN_ALTERNATE), \
+	  BOARD_PORT_FLAGS(p, BOARD_PIN_PULL_DOWN), BOARD_PORT_FLAGS(p, BOARD_PIN_PULL_UP), \
+	  BOARD_PORT_FLAGS(p, BOARD_PIN_HIGH), (locked_pins) & BOARD_PORT_PINS(p), \
+	  BOARD_PORT_PCTL_MASK(p), BOARD_PORT_PCTL(p) }
+
+// Register values of every port, derived from the pin table at build time
+static const Board_Port_Config board_ports[BOARD_PORT_COUNT] =
+{
+	BOARD_PORT_CONFIG(BOARD_PORT_A, GPIOA, 0x00),
+	BOARD_PORT_CONFIG(BOARD_PORT_B, GPIOB, 0x00),
+	BOARD_PORT_CONFIG(BOARD_PORT_C, GPIOC, 0x00),
+	BOARD_PORT_CONFIG(BOARD_PORT_D, GPIOD, BOARD_LOCKED_PINS_D),
+	BOARD_PORT_CONFIG(BOARD_PORT_E, GPIOE, 0x00),
+	BOARD_PORT_CONFIG(BOARD_PORT_F, GPIOF, BOARD_LOCKED_PINS_F)
+};
+
+void Board_Pins_Init(void)
+{
+	// Acquire the clocks to all used ports with a single write per mode and wait until they are ready
+	// The ports stay clocked in deep-sleep mode so that the button interrupts can wake the processor
+	Clock_Gating_Acquire(CLOCK_GATING_GPIO, BOARD_PORT_CLOCKS, CLOCK_GATING_ALL_MODES);
+
+	for (uint8_t i = 0; i < BOARD_PORT_COUNT; i++)
+	{
+		const Board_Port_Config *config = &board_ports[i];
+		GPIOA_Type *port = config->port;
+		uint32_t pins = config->pins;
+
+		if (pins == 0)
+		{
+			continue;
+		}
+
+		if (config->locked != 0)
+		{
+			// Unlock the port and allow changes to the locked pins
+			port->LOCK = 0x4C4F434B;
+			port->CR |= config->locked;
+		}
+
+		// Set the initial output level before the pins are switched to outputs
+		port->DATA = (port->DATA & ~pins) | config->high;
+
+		// Select the direction of the pins
+		port->DIR = (port->DIR & ~pins) | config->output;
+
+		// Select the weak pull-down and pull-up resistors of the pins
+		port->PDR = (port->PDR & ~pins) | config->pull_down;
+		port->PUR = (port->PUR & ~pins) | config->pull_up;
+
+		// Select the alternate functions of the pins
+		port->PCTL = (port->PCTL & ~config->pctl_mask) | config->pctl;
+		port->AFSEL = (port->AFSEL & ~pins) | config->alternate;
+
+		// Enable digital functionality for the pins
+		port->DEN |= pins;
+	}
+}
@@ -0,0 +1,123 @@
+/**
+ * @file Board_Pins.h
+ *
+ * @brief Header file for the Board_Pins driver.
+ *
+ * This file contains the pin table of the board and the function definitions for the Board_Pins driver.
+ * Every pin used by the program is declared once in BOARD_PINS with its port, pin number, mode
+ * and alternate function (PCTL value). The register values of every port are derived from the
+ * table at build time, so Board_Pins_Init configures all pins with a single write per register
+ * per port, and conflicting entries (two users of the same pin, an invalid pin number or PCTL
+ * value, or a JTAG pin) stop the build.
+ *
+ * Drivers do not configure their pins themselves. They only configure the pin interrupts and
+ * the peripherals that use the pins, after Board_Pins_Init has been called.
+ *
+ * @note Refer to Table 23-5 (GPIO Pins and Alternate Functions) on pages 1351 - 1352 from the
+ * TM4C123G Microcontroller Datasheet to view the PCTL value of each alternate function.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef BOARD_PINS_H
+#define BOARD_PINS_H
+
+#include "TM4C123GH6PM.h"
+#include "Clock_Gating.h"
+
+// Port numbers (bit positions in the RCGCGPIO register)
+#define BOARD_PORT_A					0
+#define BOARD_PORT_B					1
+#define BOARD_PORT_C					2
+#define BOARD_PORT_D					3
+#define BOARD_PORT_E					4
+#define BOARD_PORT_F					5
+#define BOARD_PORT_COUNT				6
+
+// Pin mode flags
+#define BOARD_PIN_INPUT					0x00	// Digital input
+#define BOARD_PIN_OUTPUT				0x01	// Digital output (DIR)
+#define BOARD_PIN_ALTERNATE				0x02	// Alternate function selected by the PCTL value (AFSEL)
+#define BOARD_PIN_PULL_DOWN				0x04	// Weak pull-down resistor (PDR)
+#define BOARD_PIN_PULL_UP				0x08	// Weak pull-up resistor (PUR)
+#define BOARD_PIN_HIGH					0x10	// Output is initialized high (DATA)
+
+/**
+ * Pin table of the board
+ * Each entry is X(arg, port letter, pin number, mode flags, PCTL value).
+ * The PCTL value must be 0 for GPIO pins.
+ */
+#define BOARD_PINS(X, arg) \
+	/* PMOD BTN module: BTN0 - BTN3 */ \
+	X(arg, A, 2, BOARD_PIN_INPUT | BOARD_PIN_PULL_DOWN, 0) \
+	X(arg, A, 3, BOARD_PIN_INPUT | BOARD_PIN_PULL_DOWN, 0) \
+	X(arg, A, 4, BOARD_PIN_INPUT | BOARD_PIN_PULL_DOWN, 0) \
+	X(arg, A, 5, BOARD_PIN_INPUT | BOARD_PIN_PULL_DOWN, 0) \
+	/* EduBase board LEDs: LED0 - LED3 driven by T2CCP0, T2CCP1, T3CCP0 and T3CCP1 */ \
+	X(arg, B, 0, BOARD_PIN_ALTERNATE, 7) \
+	X(arg, B, 1, BOARD_PIN_ALTERNATE, 7) \
+	X(arg, B, 2, BOARD_PIN_ALTERNATE, 7) \
+	X(arg, B, 3, BOARD_PIN_ALTERNATE, 7) \
+	/* EduBase board Seven-Segment Display: SSI2 CLK, SSI2 TX and active low slave select */ \
+	X(arg, B, 4, BOARD_PIN_ALTERNATE, 2) \
+	X(arg, B, 7, BOARD_PIN_ALTERNATE, 2) \
+	X(arg, C, 7, BOARD_PIN_OUTPUT | BOARD_PIN_HIGH, 0) \
+	/* EduBase board buzzer */ \
+	X(arg, C, 4, BOARD_PIN_OUTPUT, 0) \
+	/* Photogate input: WT1CCP0 (open collector output of the sensor) */ \
+	X(arg, C, 6, BOARD_PIN_ALTERNATE | BOARD_PIN_PULL_UP, 7) \
+	/* EduBase board push buttons: SW5 - SW2 */ \
+	X(arg, D, 0, BOARD_PIN_INPUT | BOARD_PIN_PULL_DOWN, 0) \
+	X(arg, D, 1, BOARD_PIN_INPUT | BOARD_PIN_PULL_DOWN, 0) \
+	X(arg, D, 2, BOARD_PIN_INPUT | BOARD_PIN_PULL_DOWN, 0) \
+	X(arg, D, 3, BOARD_PIN_INPUT | BOARD_PIN_PULL_DOWN, 0) \
+	/* Time synchronization link: U5Rx and U5Tx */ \
+	X(arg, E, 4, BOARD_PIN_ALTERNATE, 1) \
+	X(arg, E, 5, BOARD_PIN_ALTERNATE, 1) \
+	/* LaunchPad RGB LED: red, blue and green driven by M1PWM5, M1PWM6 and M1PWM7 */ \
+	X(arg, F, 1, BOARD_PIN_ALTERNATE, 5) \
+	X(arg, F, 2, BOARD_PIN_ALTERNATE, 5) \
+	X(arg, F, 3, BOARD_PIN_ALTERNATE, 5)
+
+// Helpers that evaluate one table entry for one port
+#define BOARD_PIN_ON_PORT(p, port)		((p) == BOARD_PORT_##port)
+#define BOARD_PIN_USED(p, port, pin, mode, pctl) \
+	| (BOARD_PIN_ON_PORT(p, port) ? (1UL << (pin)) : 0UL)
+#define BOARD_PIN_COUNT(p, port, pin, mode, pctl) \
+	+ (BOARD_PIN_ON_PORT(p, port) ? (1UL << (pin)) : 0UL)
+#define BOARD_PIN_FLAG(a, port, pin, mode, pctl) \
+	| ((BOARD_PIN_ON_PORT((a) & 0xFF, port) && ((mode) & ((a) >> 8))) ? (1UL << (pin)) : 0UL)
+#define BOARD_PIN_PCTL(p, port, pin, mode, pctl) \
+	| (BOARD_PIN_ON_PORT(p, port) ? ((uint32_t)(pctl) << ((pin) * 4)) : 0UL)
+#define BOARD_PIN_PCTL_MASK(p, port, pin, mode, pctl) \
+	| (BOARD_PIN_ON_PORT(p, port) ? (0xFUL << ((pin) * 4)) : 0UL)
+
+// Register values of one port, derived from the pin table
+#define BOARD_PORT_PINS(p)				(0UL BOARD_PINS(BOARD_PIN_USED, p))
+#define BOARD_PORT_FLAGS(p, flag)		(0UL BOARD_PINS(BOARD_PIN_FLAG, ((flag) << 8) | (p)))
+#define BOARD_PORT_PCTL(p)				(0UL BOARD_PINS(BOARD_PIN_PCTL, p))
+#define BOARD_PORT_PCTL_MASK(p)			(0UL BOARD_PINS(BOARD_PIN_PCTL_MASK, p))
+
+// Sum of the pin bits of one port, which differs from BOARD_PORT_PINS if a pin is used twice
+#define BOARD_PORT_PIN_SUM(p)			(0UL BOARD_PINS(BOARD_PIN_COUNT, p))
+
+// Ports used by the table (bits of the RCGCGPIO register)
+#define BOARD_PORT_CLOCK(p)				((BOARD_PORT_PINS(p) != 0) ? (1UL << (p)) : 0UL)
+#define BOARD_PORT_CLOCKS \
+	(BOARD_PORT_CLOCK(BOARD_PORT_A) | BOARD_PORT_CLOCK(BOARD_PORT_B) | BOARD_PORT_CLOCK(BOARD_PORT_C) | \
+	 BOARD_PORT_CLOCK(BOARD_PORT_D) | BOARD_PORT_CLOCK(BOARD_PORT_E) | BOARD_PORT_CLOCK(BOARD_PORT_F))
+
+/**
+ * @brief Configures every pin in the board pin table.
+ *
+ * This function enables the clocks of all used ports at once and writes the DATA, DIR, PDR, PUR,
+ * PCTL, AFSEL and DEN registers of each used port once. Pins that are not in the table are not changed.
+ * It must be called after Clock_Gating_Init and before any other driver is initialized.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Board_Pins_Init(void);
+
+#endif
@@ -20,29 +20,22 @@ const uint8_t BUZZER_OFF 		= 0x00;
 const uint8_t BUZZER_ON			= 0x10;
 
 // Constant definitions for musical notes
-const double C4_NOTE = 261.6;
-const double D4_NOTE = 293.7;
-const double E4_NOTE = 329.6;
-const double F4_NOTE = 349.2;
-const double G4_NOTE = 392.0;
-const double A4_NOTE = 440.0;
-const double B4_NOTE = 493.0;
+const float C4_NOTE = 261.6f;
+const float D4_NOTE = 293.7f;
+const float E4_NOTE = 329.6f;
+const float F4_NOTE = 349.2f;
+const float G4_NOTE = 392.0f;
+const float A4_NOTE = 440.0f;
+const float B4_NOTE = 493.0f;
 
-const double C5_NOTE = 523.2;
+const float C5_NOTE = 523.2f;
 
 void Buzzer_Init(void)
 {
-	// Enable the clock to Port C
-	SYSCTL->RCGCGPIO |= 0x04;
+	// PC4 is configured as an output by Board_Pins_Init
 	
-	// Set PC4 as an output GPIO pin
-	GPIOC->DIR |= 0x10;
-	
-	// Configure PC4 to function as a GPIO pin
-	GPIOC->AFSEL &= ~0x10;
-	
-	// Enable digital functionality for PC4
-	GPIOC->DEN |= 0x10;
+	// Turn off the buzzer
+	Buzzer_Output(BUZZER_OFF);
 }
  
 void Buzzer_Output(uint8_t buzzer_value)
@@ -51,10 +44,11 @@ void Buzzer_Output(uint8_t buzzer_value)
 	GPIOC->DATA = (GPIOC->DATA & 0xEF) | buzzer_value;
 }
 
-void Play_Note(double note, unsigned int duration)
+void Play_Note(float note, unsigned int duration)
 {
 	// Calculate the period of the note in microseconds
-	int period_us = (int)(((double)1/note) * ((double)1000000));
+	// Single precision is used, since the FPU cannot execute double precision math
+	int period_us = (int)(1000000.0f / note);
 	
 	// Calculate the half period of the note in microseconds
 	int half_period_us = period_us / 2;
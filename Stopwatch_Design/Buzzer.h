@@ -22,22 +22,21 @@ extern const uint8_t BUZZER_OFF;
 extern const uint8_t BUZZER_ON;
 
 // Constant definitions for musical notes
-extern const double C4_NOTE;
-extern const double D4_NOTE;
-extern const double E4_NOTE;
-extern const double F4_NOTE;
-extern const double G4_NOTE;
-extern const double A4_NOTE;
-extern const double B4_NOTE;
+extern const float C4_NOTE;
+extern const float D4_NOTE;
+extern const float E4_NOTE;
+extern const float F4_NOTE;
+extern const float G4_NOTE;
+extern const float A4_NOTE;
+extern const float B4_NOTE;
 
-extern const double C5_NOTE;
+extern const float C5_NOTE;
 
 /**
  * @brief Initializes the DMT-1206 Magnetic Buzzer on the EduBase board.
  *
- * This function configures the PC4 pin used by the DMT-1206 Magnetic Buzzer.
- * It enables the clock to Port C, sets PC4 as an output GPIO pin, configures PC4 to function as a GPIO pin,
- * and enables digital functionality for PC4.
+ * This function turns off the DMT-1206 Magnetic Buzzer. The PC4 pin used by the buzzer
+ * is configured as an output by Board_Pins_Init, which must be called first.
  *
  * @param None
  *
@@ -65,7 +64,7 @@ void Buzzer_Output(uint8_t buzzer_value);
  * @brief Plays a note with the DMT-1206 Magnetic Buzzer.
  *
  * This function generates a square wave with the DMT-1206 Magnetic Buzzer to produce a note of the specified frequency and duration.
- * It calculates the period of the note in microseconds, divides it by two to get half period, and then toggles the
+ * It calculates the period of the note in microseconds with single-precision math, divides it by two to get half period, and then toggles the
  * buzzer output at the half period interval for the specified duration.
  *
  * @param note The frequency of the note to play in Hz.
@@ -74,4 +73,4 @@ void Buzzer_Output(uint8_t buzzer_value);
  *
  * @return None
  */
-void Play_Note(double note, unsigned int duration);
+void Play_Note(float note, unsigned int duration);
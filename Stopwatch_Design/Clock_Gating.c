@@ -0,0 +1,177 @@
+/**
+ * @file Clock_Gating.c
+ *
+ * @brief Source code for the Clock_Gating driver.
+ *
+ * This file contains the function definitions for the Clock_Gating driver.
+ * The RCGC, SCGC, DCGC and PR registers of each peripheral type are at the same offset from
+ * the base of their register group (0x600, 0x700, 0x800 and 0xA00), so they are addressed
+ * from the System Control base address with one table of register offsets.
+ *
+ * @author Katherine Poz
+ */
+
+#include "Clock_Gating.h"
+
+// Number of clock modes (run, sleep and deep-sleep)
+#define CLOCK_GATING_MODE_COUNT			3
+
+// Number of instances that are tracked for each peripheral type
+#define CLOCK_GATING_INSTANCE_COUNT		8
+
+// Offset of the peripheral ready (PR) register group from the System Control base address
+#define CLOCK_GATING_PR_OFFSET			0xA00
+
+// Offsets of the RCGC, SCGC and DCGC register groups from the System Control base address
+static const uint16_t clock_mode_offset[CLOCK_GATING_MODE_COUNT] = { 0x600, 0x700, 0x800 };
+
+// Offset of the register of each peripheral type within its register group
+// Some offsets are skipped because they are reserved on the TM4C123GH6PM
+static const uint8_t clock_register_offset[CLOCK_GATING_PERIPHERAL_COUNT] =
+{
+	0x00,	// WD
+	0x04,	// TIMER
+	0x08,	// GPIO
+	0x0C,	// DMA
+	0x14,	// HIB
+	0x18,	// UART
+	0x1C,	// SSI
+	0x20,	// I2C
+	0x28,	// USB
+	0x34,	// CAN
+	0x38,	// ADC
+	0x3C,	// ACMP
+	0x40,	// PWM
+	0x44,	// QEI
+	0x58,	// EEPROM
+	0x5C	// WTIMER
+};
+
+// Reference count of every instance of every peripheral type in every mode
+static uint8_t clock_references[CLOCK_GATING_MODE_COUNT][CLOCK_GATING_PERIPHERAL_COUNT][CLOCK_GATING_INSTANCE_COUNT];
+
+/**
+ * @brief Returns the address of a clock gating register.
+ *
+ * @param group_offset The offset of the register group (RCGC, SCGC, DCGC or PR).
+ *
+ * @param peripheral The type of peripheral.
+ *
+ * @return Pointer to the register.
+ */
+static volatile uint32_t *Clock_Gating_Register(uint16_t group_offset, Clock_Gating_Peripheral peripheral)
+{
+	return (volatile uint32_t *)((uintptr_t)SYSCTL + group_offset + clock_register_offset[peripheral]);
+}
+
+void Clock_Gating_Init(void)
+{
+	for (uint8_t mode = 0; mode < CLOCK_GATING_MODE_COUNT; mode++)
+	{
+		for (uint8_t peripheral = 0; peripheral < CLOCK_GATING_PERIPHERAL_COUNT; peripheral++)
+		{
+			// Gate the clocks of all instances
+			*Clock_Gating_Register(clock_mode_offset[mode], (Clock_Gating_Peripheral)peripheral) = 0;
+
+			for (uint8_t instance = 0; instance < CLOCK_GATING_INSTANCE_COUNT; instance++)
+			{
+				clock_references[mode][peripheral][instance] = 0;
+			}
+		}
+	}
+
+	// Use the SCGC and DCGC registers in sleep and deep-sleep mode by setting the ACG bit (Bit 27) in the RCC register
+	SYSCTL->RCC |= 0x08000000;
+}
+
+void Clock_Gating_Acquire(Clock_Gating_Peripheral peripheral, uint8_t instance_mask, uint8_t modes)
+{
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	for (uint8_t mode = 0; mode < CLOCK_GATING_MODE_COUNT; mode++)
+	{
+		if ((modes & (1U << mode)) == 0)
+		{
+			continue;
+		}
+
+		uint32_t enable_mask = 0;
+
+		for (uint8_t instance = 0; instance < CLOCK_GATING_INSTANCE_COUNT; instance++)
+		{
+			if (instance_mask & (1U << instance))
+			{
+				// The clock is enabled by the first reference
+				if (clock_references[mode][peripheral][instance] == 0)
+				{
+					enable_mask |= (1UL << instance);
+				}
+				clock_references[mode][peripheral][instance]++;
+			}
+		}
+
+		if (enable_mask != 0)
+		{
+			*Clock_Gating_Register(clock_mode_offset[mode], peripheral) |= enable_mask;
+		}
+	}
+
+	__set_PRIMASK(primask);
+
+	if (modes & CLOCK_GATING_RUN)
+	{
+		// Wait until all instances are ready to be accessed
+		volatile uint32_t *ready = Clock_Gating_Register(CLOCK_GATING_PR_OFFSET, peripheral);
+		while ((*ready & instance_mask) != instance_mask);
+	}
+}
+
+void Clock_Gating_Release(Clock_Gating_Peripheral peripheral, uint8_t instance_mask, uint8_t modes)
+{
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	for (uint8_t mode = 0; mode < CLOCK_GATING_MODE_COUNT; mode++)
+	{
+		if ((modes & (1U << mode)) == 0)
+		{
+			continue;
+		}
+
+		uint32_t disable_mask = 0;
+
+		for (uint8_t instance = 0; instance < CLOCK_GATING_INSTANCE_COUNT; instance++)
+		{
+			if ((instance_mask & (1U << instance)) && (clock_references[mode][peripheral][instance] != 0))
+			{
+				// The clock is gated when the last reference is released
+				clock_references[mode][peripheral][instance]--;
+				if (clock_references[mode][peripheral][instance] == 0)
+				{
+					disable_mask |= (1UL << instance);
+				}
+			}
+		}
+
+		if (disable_mask != 0)
+		{
+			*Clock_Gating_Register(clock_mode_offset[mode], peripheral) &= ~disable_mask;
+		}
+	}
+
+	__set_PRIMASK(primask);
+}
+
+uint8_t Clock_Gating_Get_References(Clock_Gating_Peripheral peripheral, uint8_t instance, uint8_t mode)
+{
+	for (uint8_t i = 0; i < CLOCK_GATING_MODE_COUNT; i++)
+	{
+		if (mode == (1U << i))
+		{
+			return clock_references[i][peripheral][instance & (CLOCK_GATING_INSTANCE_COUNT - 1)];
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file Clock_Gating.h
+ *
+ * @brief Header file for the Clock_Gating driver.
+ *
+ * This file contains the function definitions for the Clock_Gating driver.
+ * It keeps a reference count for the clock of every peripheral instance in each of the three
+ * clock gating control registers:
+ *	- RCGC: Run mode
+ *	- SCGC: Sleep mode
+ *	- DCGC: Deep-sleep mode
+ *
+ * Drivers acquire the clocks of the peripherals they use instead of setting the register bits
+ * themselves, and release them when they stop using a peripheral. A clock is enabled by the
+ * first acquire and gated again by the last release, so peripherals that are shared between
+ * drivers are not switched off while still in use, and unused peripherals do not draw power.
+ *
+ * The automatic clock gating (ACG) bit is set by Clock_Gating_Init, so the SCGC and DCGC
+ * registers select the peripherals that stay clocked while the processor sleeps.
+ *
+ * @note Refer to Section 5.5 (System Control Register Descriptions) of the TM4C123G Microcontroller
+ * Datasheet to view the bit of each instance in the RCGC, SCGC, DCGC and PR registers.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef CLOCK_GATING_H
+#define CLOCK_GATING_H
+
+#include "TM4C123GH6PM.h"
+
+// Modes in which a clock is requested
+#define CLOCK_GATING_RUN				0x01	// RCGC
+#define CLOCK_GATING_SLEEP				0x02	// SCGC
+#define CLOCK_GATING_DEEP_SLEEP			0x04	// DCGC
+#define CLOCK_GATING_RUN_SLEEP			(CLOCK_GATING_RUN | CLOCK_GATING_SLEEP)
+#define CLOCK_GATING_ALL_MODES			(CLOCK_GATING_RUN | CLOCK_GATING_SLEEP | CLOCK_GATING_DEEP_SLEEP)
+
+typedef enum
+{
+	CLOCK_GATING_WATCHDOG = 0,
+	CLOCK_GATING_TIMER,
+	CLOCK_GATING_GPIO,
+	CLOCK_GATING_DMA,
+	CLOCK_GATING_HIB,
+	CLOCK_GATING_UART,
+	CLOCK_GATING_SSI,
+	CLOCK_GATING_I2C,
+	CLOCK_GATING_USB,
+	CLOCK_GATING_CAN,
+	CLOCK_GATING_ADC,
+	CLOCK_GATING_ACMP,
+	CLOCK_GATING_PWM,
+	CLOCK_GATING_QEI,
+	CLOCK_GATING_EEPROM,
+	CLOCK_GATING_WTIMER,
+	CLOCK_GATING_PERIPHERAL_COUNT
+} Clock_Gating_Peripheral;
+
+/**
+ * @brief Gates the clocks of all peripherals and enables the automatic clock gating in sleep modes.
+ *
+ * This function must be called before any other driver is initialized.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Clock_Gating_Init(void);
+
+/**
+ * @brief Acquires the clocks of one or more instances of a peripheral.
+ *
+ * The clock of an instance is enabled in a mode when its reference count in that mode becomes 1.
+ * If the run mode is requested, this function waits until all instances are ready to be accessed.
+ *
+ * @param peripheral The type of peripheral.
+ *
+ * @param instance_mask The instances of the peripheral (e.g. 0x20 for UART5, Port F, or Timer 5).
+ *
+ * @param modes The modes in which the clocks are requested (CLOCK_GATING_RUN, CLOCK_GATING_SLEEP
+ *              and CLOCK_GATING_DEEP_SLEEP combined).
+ *
+ * @return None
+ */
+void Clock_Gating_Acquire(Clock_Gating_Peripheral peripheral, uint8_t instance_mask, uint8_t modes);
+
+/**
+ * @brief Releases the clocks of one or more instances of a peripheral.
+ *
+ * The clock of an instance is gated in a mode when its reference count in that mode becomes 0.
+ * The instances and modes must match an earlier call of Clock_Gating_Acquire.
+ *
+ * @param peripheral The type of peripheral.
+ *
+ * @param instance_mask The instances of the peripheral.
+ *
+ * @param modes The modes in which the clocks are released.
+ *
+ * @return None
+ */
+void Clock_Gating_Release(Clock_Gating_Peripheral peripheral, uint8_t instance_mask, uint8_t modes);
+
+/**
+ * @brief Returns the number of references to the clock of a peripheral instance in one mode.
+ *
+ * @param peripheral The type of peripheral.
+ *
+ * @param instance The instance number of the peripheral (0 to 7).
+ *
+ * @param mode CLOCK_GATING_RUN, CLOCK_GATING_SLEEP or CLOCK_GATING_DEEP_SLEEP.
+ *
+ * @return The reference count.
+ */
+uint8_t Clock_Gating_Get_References(Clock_Gating_Peripheral peripheral, uint8_t instance, uint8_t mode);
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * @file Deferred_Work.c
+ *
+ * @brief Source code for the Deferred_Work driver.
+ *
+ * This file contains the function definitions for the Deferred_Work driver.
+ * Tasks can be posted from interrupts of any priority, so the queue is only
+ * accessed with interrupts disabled. PendSV is the only reader.
+ *
+ * @author Katherine Poz
+ */
+
+#include "Deferred_Work.h"
+
+typedef struct
+{
+	void (*task)(uint8_t);				// Task to be executed
+	uint8_t data;						// Value passed to the task
+	uint64_t timestamp_us;				// Time of the event handled by the task
+} Deferred_Work_Item;
+
+// Queue of the posted tasks (item N is at index N % DEFERRED_WORK_QUEUE_SIZE)
+static Deferred_Work_Item work_queue[DEFERRED_WORK_QUEUE_SIZE];
+static volatile uint32_t work_posted = 0;
+static volatile uint32_t work_done = 0;
+static volatile uint32_t work_dropped = 0;
+
+// Timestamp of the task that is being executed
+static uint64_t work_timestamp_us = 0;
+
+void Deferred_Work_Init(void)
+{
+	work_posted = 0;
+	work_done = 0;
+	work_dropped = 0;
+
+	// Set the priority level of PendSV to 7, the lowest level
+	NVIC_SetPriority(PendSV_IRQn, 7);
+}
+
+uint8_t Deferred_Work_Post(void (*task)(uint8_t), uint8_t data, uint64_t timestamp_us)
+{
+	uint8_t queued = 0x00;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	if ((work_posted - work_done) < DEFERRED_WORK_QUEUE_SIZE)
+	{
+		Deferred_Work_Item *item = &work_queue[work_posted & (DEFERRED_WORK_QUEUE_SIZE - 1)];
+
+		item->task = task;
+		item->data = data;
+		item->timestamp_us = timestamp_us;
+		work_posted++;
+		queued = 0x01;
+
+		// Set the PENDSVSET bit (Bit 28) in the ICSR register to request the PendSV interrupt
+		SCB->ICSR = 0x10000000;
+	}
+	else
+	{
+		work_dropped++;
+	}
+
+	__set_PRIMASK(primask);
+
+	return queued;
+}
+
+uint64_t Deferred_Work_Get_Timestamp_us(void)
+{
+	return work_timestamp_us;
+}
+
+uint32_t Deferred_Work_Get_Dropped(void)
+{
+	return work_dropped;
+}
+
+void PendSV_Handler(void)
+{
+	// Tasks that are posted while the queue is drained are executed in the same pass
+	while (work_done != work_posted)
+	{
+		// Copy the item before its slot can be reused by a producer
+		__disable_irq();
+		Deferred_Work_Item item = work_queue[work_done & (DEFERRED_WORK_QUEUE_SIZE - 1)];
+		work_done++;
+		__enable_irq();
+
+		work_timestamp_us = item.timestamp_us;
+		(*item.task)(item.data);
+	}
+}
@@ -0,0 +1,86 @@
+/**
+ * @file Deferred_Work.h
+ *
+ * @brief Header file for the Deferred_Work driver.
+ *
+ * This file contains the function definitions for the Deferred_Work driver.
+ * It allows interrupt handlers to capture a small amount of state and leave the rest of
+ * their work to a task that runs later at the lowest interrupt priority. The tasks are
+ * queued in the order they were posted and executed from the PendSV interrupt, which is
+ * triggered by software whenever a task is posted.
+ *
+ * Every interrupt that is not masked can preempt a deferred task, so the latency of the
+ * Timer 0A, GPIO and UART interrupts only depends on the short part of their handlers.
+ *
+ * @note PendSV has the priority level 7 and must not be used for anything else.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef DEFERRED_WORK_H
+#define DEFERRED_WORK_H
+
+#include "TM4C123GH6PM.h"
+
+// Number of tasks that can wait to be executed (must be a power of two)
+#define DEFERRED_WORK_QUEUE_SIZE			16
+
+/**
+ * @brief Initializes the deferred work queue.
+ *
+ * This function clears the queue and sets the priority level of the PendSV interrupt to 7.
+ * It must be called before any interrupt that posts tasks is enabled.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Deferred_Work_Init(void);
+
+/**
+ * @brief Queues a task to be executed from the PendSV interrupt.
+ *
+ * This function can be called from thread mode or from any interrupt.
+ *
+ * @param task A pointer to the task to be executed.
+ *
+ * @param data The value that is passed to the task (e.g. a button status).
+ *
+ * @param timestamp_us The time of the event that the task handles in microseconds.
+ *
+ * @return 0x01 if the task was queued, 0x00 if the queue is full and the task was dropped.
+ */
+uint8_t Deferred_Work_Post(void (*task)(uint8_t), uint8_t data, uint64_t timestamp_us);
+
+/**
+ * @brief Returns the timestamp that was posted with the task that is being executed.
+ *
+ * @note Must be called from a deferred task.
+ *
+ * @param None
+ *
+ * @return The time of the event in microseconds.
+ */
+uint64_t Deferred_Work_Get_Timestamp_us(void);
+
+/**
+ * @brief Returns the number of tasks that were dropped because the queue was full.
+ *
+ * @param None
+ *
+ * @return The number of dropped tasks.
+ */
+uint32_t Deferred_Work_Get_Dropped(void);
+
+/**
+ * @brief The interrupt service routine (ISR) for PendSV.
+ *
+ * This function executes the queued tasks in the order they were posted until the queue is empty.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void PendSV_Handler(void);
+
+#endif
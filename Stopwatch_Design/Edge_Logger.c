@@ -0,0 +1,183 @@
+/**
+ * @file Edge_Logger.c
+ *
+ * @brief Source code for the Edge_Logger driver.
+ *
+ * This file contains the function definitions for the Edge_Logger driver.
+ * The number of captures written to the ring is derived from the completed halves and the
+ * remaining transfer size of the uDMA control structures, so no state is updated per edge.
+ * Capture N is stored at index N % EDGE_LOGGER_RING_SIZE, since the primary structure fills
+ * the first half and the alternate structure fills the second half.
+ *
+ * @author Katherine Poz
+ */
+
+#include "Edge_Logger.h"
+
+_Static_assert(EDGE_LOGGER_HALF_SIZE <= UDMA_MAX_TRANSFER, "A half of the ring must fit into one uDMA control structure");
+
+// Ring of the captured counter values, written by the uDMA controller
+static volatile uint32_t edge_ring[EDGE_LOGGER_RING_SIZE];
+
+// Number of halves of the ring that have been completed and re-armed
+static volatile uint32_t completed_halves = 0;
+
+// Number of captures that have been processed
+static uint32_t read_position = 0;
+
+// Time of the last lap and 0x01 once a lap has been reported
+static uint64_t last_lap_us = 0;
+static uint8_t lap_valid = 0x00;
+
+static uint32_t lap_holdoff_us = 0;
+static void (*lap_task)(uint64_t event_us) = 0;
+
+static Edge_Logger_Stats edge_stats;
+
+/**
+ * @brief Counts a half of the ring that has been filled by the uDMA channel.
+ *
+ * This function is executed from the Wide Timer 1A interrupt after the structure has been re-armed.
+ *
+ * @param channel The uDMA channel.
+ *
+ * @param structure The control structure that has finished.
+ *
+ * @return None
+ */
+static void Edge_Logger_Half_Complete(uint8_t channel, uint8_t structure)
+{
+	(void)channel;
+	(void)structure;
+
+	completed_halves++;
+}
+
+/**
+ * @brief Services the uDMA channel from the Wide Timer 1A interrupt.
+ *
+ * This function is installed as the raw handler of Wide Timer 1A. The interrupt is raised when
+ * the uDMA channel has filled a half of the ring, since the capture event interrupt is masked.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Edge_Logger_Timer_Handler(void)
+{
+	UDMA_Service_Channel(EDGE_LOGGER_UDMA_CHANNEL);
+}
+
+/**
+ * @brief Returns the number of captures that have been written to the ring.
+ *
+ * @note Must be called with interrupts disabled.
+ *
+ * @param None
+ *
+ * @return The number of captures since the logger was started.
+ */
+static uint32_t Edge_Logger_Get_Write_Position(void)
+{
+	// The ALTSET register shows which control structure is used for the next capture
+	uint8_t active = (UDMA->ALTSET & (1UL << EDGE_LOGGER_UDMA_CHANNEL)) ? UDMA_ALTERNATE : UDMA_PRIMARY;
+	uint8_t other = (active == UDMA_ALTERNATE) ? UDMA_PRIMARY : UDMA_ALTERNATE;
+
+	uint32_t position = (completed_halves * EDGE_LOGGER_HALF_SIZE) + (EDGE_LOGGER_HALF_SIZE - UDMA_Get_Remaining(EDGE_LOGGER_UDMA_CHANNEL, active));
+
+	// The other structure has finished, but its interrupt has not been handled yet
+	if (UDMA_Get_Remaining(EDGE_LOGGER_UDMA_CHANNEL, other) == 0)
+	{
+		position += EDGE_LOGGER_HALF_SIZE;
+	}
+
+	return position;
+}
+
+uint8_t Edge_Logger_Init(uint8_t edge, uint32_t holdoff_us, void (*task)(uint64_t event_us), uint8_t priority)
+{
+	if (UDMA_Allocate_Channel(EDGE_LOGGER_UDMA_CHANNEL, EDGE_LOGGER_UDMA_ENCODING, &Edge_Logger_Half_Complete) == 0x00)
+	{
+		return 0x00;
+	}
+
+	completed_halves = 0;
+	read_position = 0;
+	lap_valid = 0x00;
+	lap_holdoff_us = holdoff_us;
+	lap_task = task;
+	edge_stats.edges = 0;
+	edge_stats.laps = 0;
+	edge_stats.held_off = 0;
+	edge_stats.overruns = 0;
+
+	// Configure Wide Timer 1A to capture the counter value at every selected edge
+	GPTM_Init_Edge_Time(GPTM_WTIMER1, GPTM_TIMER_A, edge, 0, priority);
+
+	// Service the uDMA channel from the interrupt of Wide Timer 1A instead of the GPTM callbacks
+	GPTM_Set_Raw_Handler(GPTM_WTIMER1, GPTM_TIMER_A, &Edge_Logger_Timer_Handler);
+
+	// Mask the capture event interrupt (CAEIM, Bit 2), since the captures are moved by the uDMA channel
+	// The interrupt of Wide Timer 1A stays enabled in the NVIC for the completion of the uDMA transfers
+	WTIMER1->IMR &= ~0x04;
+
+	// Copy every capture from the GPTMTAR register into the two halves of the ring
+	// The size of a half is checked at build time, so the transfer is always started
+	UDMA_Start_Ping_Pong(EDGE_LOGGER_UDMA_CHANNEL, UDMA_CONTROL(UDMA_INC_32, UDMA_INC_NONE, UDMA_SIZE_32, 0),
+		&WTIMER1->TAR, &edge_ring[0], &WTIMER1->TAR, &edge_ring[EDGE_LOGGER_HALF_SIZE], EDGE_LOGGER_HALF_SIZE);
+
+	GPTM_Enable(GPTM_WTIMER1, GPTM_TIMER_A);
+
+	return 0x01;
+}
+
+void Edge_Logger_Service(void)
+{
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	// Read the write position together with the counter and the time base, so that
+	// the age of every capture up to the write position can be converted to the time base
+	uint32_t write_position = Edge_Logger_Get_Write_Position();
+	uint32_t now_count = GPTM_Get_Count(GPTM_WTIMER1, GPTM_TIMER_A);
+	uint64_t now_us = Time_Base_Get_Time_us();
+
+	__set_PRIMASK(primask);
+
+	// Skip the captures that have already been overwritten
+	if ((write_position - read_position) > EDGE_LOGGER_RING_SIZE)
+	{
+		edge_stats.overruns += (write_position - read_position) - EDGE_LOGGER_RING_SIZE;
+		read_position = write_position - EDGE_LOGGER_RING_SIZE;
+	}
+
+	while (read_position != write_position)
+	{
+		uint32_t capture = edge_ring[read_position % EDGE_LOGGER_RING_SIZE];
+		read_position++;
+		edge_stats.edges++;
+
+		// The counter counts up, so the unsigned difference is the age of the capture in cycles
+		uint64_t event_us = now_us - ((now_count - capture) / TIME_BASE_CYCLES_PER_US);
+
+		if ((lap_valid == 0x01) && ((event_us - last_lap_us) < lap_holdoff_us))
+		{
+			edge_stats.held_off++;
+			continue;
+		}
+
+		last_lap_us = event_us;
+		lap_valid = 0x01;
+		edge_stats.laps++;
+
+		if (lap_task != 0)
+		{
+			(*lap_task)(event_us);
+		}
+	}
+}
+
+void Edge_Logger_Get_Stats(Edge_Logger_Stats *stats)
+{
+	*stats = edge_stats;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file Edge_Logger.h
+ *
+ * @brief Header file for the Edge_Logger driver.
+ *
+ * This file contains the function definitions for the Edge_Logger driver.
+ * It timestamps the edges of an external sensor (e.g. a photogate or a light barrier)
+ * without any work of the CPU per edge:
+ *	- Wide Timer 1A captures the counter value at every selected edge on PC6 (WT1CCP0).
+ *	- Each capture event requests uDMA channel 12 (encoding 3), which copies the captured
+ *	  value (GPTMTAR) into a RAM ring. The two halves of the ring are filled alternately
+ *	  by the ping-pong mode, so the transfer never has to be restarted by software.
+ *	- The Wide Timer 1A interrupt is only raised when a half of the ring is full.
+ *
+ * Edge_Logger_Service is called from the main loop. It reads the new captures, converts them
+ * to the time base and passes the edge that starts each lap to a user-defined task. Edges
+ * within the hold-off time of the previous lap (e.g. a second edge from the legs of a runner)
+ * are discarded.
+ *
+ * With a ring of 1024 captures, edges at 50 kHz can be logged while Edge_Logger_Service
+ * is called at least every 20 ms.
+ *
+ * @note The captures are 32-bit counter values that wrap every 85.9 seconds, so
+ * Edge_Logger_Service must be called more often than that.
+ *
+ * @note Refer to Table 9-1 (uDMA Channel Assignments) on page 587 of the TM4C123G Microcontroller Datasheet
+ * for the channel of Wide Timer 1A.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef EDGE_LOGGER_H
+#define EDGE_LOGGER_H
+
+#include "TM4C123GH6PM.h"
+#include "GPTM.h"
+#include "UDMA.h"
+#include "Time_Base.h"
+
+// uDMA channel and encoding of Wide Timer 1A
+#define EDGE_LOGGER_UDMA_CHANNEL			12
+#define EDGE_LOGGER_UDMA_ENCODING			3
+
+// Number of captures in each half of the ring (1 to 1024)
+#define EDGE_LOGGER_HALF_SIZE				512
+#define EDGE_LOGGER_RING_SIZE				(2 * EDGE_LOGGER_HALF_SIZE)
+
+typedef struct
+{
+	uint32_t edges;							// Number of captured edges
+	uint32_t laps;							// Number of edges passed to the task
+	uint32_t held_off;						// Number of edges within the hold-off time of a lap
+	uint32_t overruns;						// Number of captures overwritten before they were read
+} Edge_Logger_Stats;
+
+/**
+ * @brief Initializes Wide Timer 1A in the edge-time mode and starts the uDMA transfer into the ring.
+ *
+ * PC6 is configured as WT1CCP0 by Board_Pins_Init. UDMA_Init must be called first.
+ *
+ * @param edge The edges to be captured (GPTM_EDGE_RISING, GPTM_EDGE_FALLING or GPTM_EDGE_BOTH).
+ *
+ * @param holdoff_us The minimum time between two laps in microseconds.
+ *
+ * @param task A pointer to the user-defined function that receives the time of each lap in microseconds.
+ *
+ * @param priority The interrupt priority level (0 to 7) of the Wide Timer 1A interrupt.
+ *
+ * @return 0x01 if the logger was started, 0x00 if the uDMA channel is already in use.
+ */
+uint8_t Edge_Logger_Init(uint8_t edge, uint32_t holdoff_us, void (*task)(uint64_t event_us), uint8_t priority);
+
+/**
+ * @brief Processes the captures that were added to the ring since the last call.
+ *
+ * This function must be called from thread mode. The task is executed from this function.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Edge_Logger_Service(void);
+
+/**
+ * @brief Reads the counters of the edge logger.
+ *
+ * @param stats Pointer to the structure that receives the counters.
+ *
+ * @return None
+ */
+void Edge_Logger_Get_Stats(Edge_Logger_Stats *stats);
+
+#endif
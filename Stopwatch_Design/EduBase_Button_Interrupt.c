@@ -7,6 +7,8 @@
  * It interfaces with the EduBase Board push buttons. The following pins are used:
  *	- SW2 (PD3)
  *	- SW3 (PD2)
+ *	- SW4 (PD1)
+ *	- SW5 (PD0)
  *
  * It configures the pins to trigger interrupts on rising edges. The EduBase Board 
  * push buttons operate in an active high configuration.
@@ -24,45 +26,30 @@ void EduBase_Button_Interrupt_Init(void(*task)(uint8_t))
 	// Store the user-defined task function for use during interrupt handling
 	EduBase_Button_Task = task;
 	
-	// Enable the clock to Port D by setting the R3 bit (Bit 3) in the RCGCGPIO register
-	SYSCTL->RCGCGPIO |= 0x08;
+	// The PD3 to PD0 pins are configured as inputs with
+	// weak pull-down resistors by Board_Pins_Init
 	
-	// Configure the PD3 and PD2 pins as input by clearing Bits 3 to 2 in the DIR register
-	GPIOD->DIR &= ~0x0C;
-	
-	// Configure the PD3 and PD2 pins to function as
-	// GPIO pins by clearing Bits 3 to 2 in the AFSEL register
-	GPIOD->AFSEL &= ~0x0C;
-	
-	// Enable the digital functionality for the PD3 and PD2 pins
-	// by setting Bits 3 to 2 in the DEN register
-	GPIOD->DEN |= 0x0C;
-	
-	// Enable the weak pull-down resistor for the PD3 and PD2 pins
-	// by setting Bits 3 to 2 in the PDR register
-	GPIOD->PDR |= 0x0C;
-	
-	// Configure the PD3 and PD2 pins to detect edges
-	// by clearing Bits 3 to 2 in the IS register
-	GPIOD->IS &= ~0x0C;
+	// Configure the PD3 to PD0 pins to detect edges
+	// by clearing Bits 3 to 0 in the IS register
+	GPIOD->IS &= ~0x0F;
 	
 	// Allow the GPIOIEV register to handle interrupt generation
-	// and determine which edge to check for the PD3 and PD2 pins 
-	// by clearing Bits 3 to 2 in the IBE register
-	GPIOD->IBE &= ~0x0C;
+	// and determine which edge to check for the PD3 to PD0 pins 
+	// by clearing Bits 3 to 0 in the IBE register
+	GPIOD->IBE &= ~0x0F;
 	
-	// Configure the PD3 and PD2 pins to detect
-	// rising edges by setting Bits 3 to 2 in the IEV register
+	// Configure the PD3 to PD0 pins to detect
+	// rising edges by setting Bits 3 to 0 in the IEV register
 	// Rising edges on the corresponding pins will trigger interrupts
-	GPIOD->IEV |= 0x0C;
+	GPIOD->IEV |= 0x0F;
 	
-	// Clear any existing interrupt flags on the PD3 and PD2 pins
-	// by setting Bits 3 to 2 in the ICR register
-	GPIOD->ICR |= 0x0C;
+	// Clear any existing interrupt flags on the PD3 to PD0 pins
+	// by setting Bits 3 to 0 in the ICR register
+	GPIOD->ICR |= 0x0F;
 	
-	// Allow the interrupts that are generated by the PD3 and PD2 pins to be 
-	// sent to the interrupt controller by setting Bits 3 to 2 in the IM register
-	GPIOD->IM |= 0x0C;
+	// Allow the interrupts that are generated by the PD3 to PD0 pins to be 
+	// sent to the interrupt controller by setting Bits 3 to 0 in the IM register
+	GPIOD->IM |= 0x0F;
 	
 	// Clear the INTD field (Bits 31 to 29) of the IPR[0] register (PRI0)
 	NVIC->IPR[0] &= ~0xE0000000;
@@ -77,15 +64,15 @@ void EduBase_Button_Interrupt_Init(void(*task)(uint8_t))
 void GPIOD_Handler(void)
 {
 	// Check if an interrupt has been triggered by any of
-	// the following pins: PD3 and PD2
-	if (GPIOD->MIS & 0x0C)
+	// the following pins: PD3, PD2, PD1, and PD0
+	if (GPIOD->MIS & 0x0F)
 	{
 		// Execute the user-defined function and pass the
 		// status of the EduBase board push buttons
 		(*EduBase_Button_Task)(Get_EduBase_Button_Status());
 		
 		// Acknowledge the interrupt from any of the following pins
-		// and clear it: PD3 and PD2
-		GPIOD->ICR |= 0x0C;
+		// and clear it: PD3, PD2, PD1, and PD0
+		GPIOD->ICR |= 0x0F;
 	}
 }
@@ -7,6 +7,8 @@
  * It interfaces with the EduBase Board Push Buttons. The following pins are used:
  *	- SW2 (PD3)
  *	- SW3 (PD2)
+ *	- SW4 (PD1)
+ *	- SW5 (PD0)
  *
  * It configures the pins to trigger interrupts on rising edges. The EduBase Board 
  * push buttons operate in an active high configuration.
@@ -27,8 +29,10 @@ extern void (*EduBase_Button_Task)(uint8_t edubase_button_status);
  * EduBase push buttons connected to the following pins:
  * 	- SW2 (PD3)
  *	- SW3 (PD2)
+ *	- SW4 (PD1)
+ *	- SW5 (PD0)
  *
- * It configures the specified pins (PD3 and PD2) to trigger interrupts on rising edges.
+ * It configures the specified pins (PD3 to PD0) to trigger interrupts on rising edges.
  * When an interrupt occurs, the provided task function is executed with the current button status.
  * Interrupt priority is set to 3 for GPIO Port D.
  *
@@ -42,7 +46,7 @@ void EduBase_Button_Interrupt_Init(void(*task)(uint8_t));
  * @brief The interrupt service routine (ISR) for GPIO Port D.
  *
  * This function is the interrupt service routine (ISR) for GPIO Port D.
- * It checks if an interrupt has been triggered by PD3 or PD2, and if so,
+ * It checks if an interrupt has been triggered by PD3, PD2, PD1, or PD0, and if so,
  * it executes the user-defined task function with the current button status.
  * After executing the task function, it acknowledges and clears the interrupt.
  *
@@ -0,0 +1,87 @@
+/**
+ * @file EduBase_LED_PWM.c
+ *
+ * @brief Source code for the EduBase_LED_PWM driver.
+ *
+ * This file contains the function definitions for the EduBase_LED_PWM driver.
+ * It drives the EduBase Board LEDs (LED0 - LED3) with the PWM outputs of Timer 2 and Timer 3.
+ *
+ * @note This driver assumes that the system clock's frequency is 50 MHz.
+ *
+ * @author Katherine Poz
+ */
+
+#include "EduBase_LED_PWM.h"
+
+// PWM period: (50 MHz / 50000) = 1 kHz
+#define EDUBASE_LED_PWM_PERIOD			50000
+
+typedef struct
+{
+	GPTM_Instance instance;
+	GPTM_Half half;
+} EduBase_LED_PWM_Output;
+
+// Timer outputs of LED0 to LED3
+static const EduBase_LED_PWM_Output led_outputs[EDUBASE_LED_COUNT] =
+{
+	{ GPTM_TIMER2, GPTM_TIMER_A },
+	{ GPTM_TIMER2, GPTM_TIMER_B },
+	{ GPTM_TIMER3, GPTM_TIMER_A },
+	{ GPTM_TIMER3, GPTM_TIMER_B }
+};
+
+void EduBase_LED_PWM_Init(void)
+{
+	for (uint8_t led = 0; led < EDUBASE_LED_COUNT; led++)
+	{
+		// Configure the PWM generator of the LED with a duty cycle of 0%
+		GPTM_Init_PWM(led_outputs[led].instance, led_outputs[led].half, EDUBASE_LED_PWM_PERIOD, 0x00);
+	}
+
+	// Start Timer 2 and Timer 3 in the same clock cycle
+	GPTM_Sync_Start(GPTM_MASK(GPTM_TIMER2) | GPTM_MASK(GPTM_TIMER3));
+}
+
+void EduBase_LED_PWM_Set(uint8_t led, uint8_t level)
+{
+	if (led >= EDUBASE_LED_COUNT)
+	{
+		return;
+	}
+
+	// high_cycles = period * (level / 255)^2
+	uint32_t high_cycles = (uint32_t)(((uint64_t)EDUBASE_LED_PWM_PERIOD * level * level) / (EDUBASE_LED_PWM_MAX * EDUBASE_LED_PWM_MAX));
+
+	GPTM_Set_PWM_Duty(led_outputs[led].instance, led_outputs[led].half, high_cycles);
+}
+
+void EduBase_LED_PWM_Show_Bar(uint32_t value, uint32_t max)
+{
+	if (max == 0)
+	{
+		return;
+	}
+
+	if (value > max)
+	{
+		value = max;
+	}
+
+	// Length of the bar in brightness levels over all four LEDs
+	uint32_t bar = (uint32_t)(((uint64_t)value * EDUBASE_LED_COUNT * EDUBASE_LED_PWM_MAX) / max);
+
+	for (uint8_t led = 0; led < EDUBASE_LED_COUNT; led++)
+	{
+		if (bar >= EDUBASE_LED_PWM_MAX)
+		{
+			EduBase_LED_PWM_Set(led, EDUBASE_LED_PWM_MAX);
+			bar = bar - EDUBASE_LED_PWM_MAX;
+		}
+		else
+		{
+			EduBase_LED_PWM_Set(led, (uint8_t)bar);
+			bar = 0;
+		}
+	}
+}
@@ -0,0 +1,77 @@
+/**
+ * @file EduBase_LED_PWM.h
+ *
+ * @brief Header file for the EduBase_LED_PWM driver.
+ *
+ * This file contains the function definitions for the EduBase_LED_PWM driver.
+ * It drives the EduBase Board LEDs (LED0 - LED3) with the PWM outputs of the general-purpose timers,
+ * so each LED can be set to one of 256 brightness levels with a single register write:
+ *	- LED0 (PB0): T2CCP0 (Timer 2A)
+ *	- LED1 (PB1): T2CCP1 (Timer 2B)
+ *	- LED2 (PB2): T3CCP0 (Timer 3A)
+ *	- LED3 (PB3): T3CCP1 (Timer 3B)
+ *
+ * PB0 to PB3 do not have an output of the PWM modules, so the timers are used in PWM mode instead.
+ * The four PWM outputs run at 1 kHz and are started together, so their periods are aligned.
+ *
+ * @note The pins are configured for the timer function (PCTL = 0x7) by Board_Pins_Init, which
+ * must be called first. EduBase_LEDs_Init and EduBase_LEDs_Output cannot be used together with this driver.
+ *
+ * @note This driver assumes that the system clock's frequency is 50 MHz.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef EDUBASE_LED_PWM_H
+#define EDUBASE_LED_PWM_H
+
+#include "TM4C123GH6PM.h"
+#include "GPTM.h"
+
+// Number of EduBase Board LEDs
+#define EDUBASE_LED_COUNT				4
+
+// Highest brightness level
+#define EDUBASE_LED_PWM_MAX				255
+
+/**
+ * @brief Initializes the PWM outputs of the EduBase Board LEDs.
+ *
+ * This function configures Timer 2 and Timer 3 as four PWM generators with a period of 1 ms,
+ * turns off all LEDs, and starts the four outputs at the same time.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void EduBase_LED_PWM_Init(void);
+
+/**
+ * @brief Sets the brightness of one EduBase Board LED.
+ *
+ * The duty cycle grows with the square of the level, so equal steps of the level
+ * appear as roughly equal steps of brightness.
+ *
+ * @param led The LED to be changed (0 to 3).
+ *
+ * @param level The brightness level (0 = off, EDUBASE_LED_PWM_MAX = fully on).
+ *
+ * @return None
+ */
+void EduBase_LED_PWM_Set(uint8_t led, uint8_t level);
+
+/**
+ * @brief Shows a value as a bar graph on the EduBase Board LEDs.
+ *
+ * The LEDs light up from LED0 to LED3 as the value approaches the maximum. The LED at the
+ * top of the bar is dimmed in proportion to the part of its step that has been reached.
+ *
+ * @param value The value to be shown (0 to max).
+ *
+ * @param max The value at which all LEDs are fully on.
+ *
+ * @return None
+ */
+void EduBase_LED_PWM_Show_Bar(uint32_t value, uint32_t max);
+
+#endif
@@ -0,0 +1,62 @@
+/**
+ * @file Flash.c
+ *
+ * @brief Source code for the Flash driver.
+ *
+ * This file contains the function definitions for the Flash driver.
+ * It erases and programs the internal flash memory through the FMA, FMD and FMC registers.
+ *
+ * @author Katherine Poz
+ */
+
+#include "Flash.h"
+
+// Boot Configuration (BOOTCFG) register, which selects the write key of the FMC register
+#define FLASH_BOOTCFG					(*((volatile uint32_t *)0x400FE1D0))
+
+// Write keys of the FMC register when the KEY bit (Bit 4) of BOOTCFG is 1 or 0
+#define FLASH_KEY_A442					0xA4420000
+#define FLASH_KEY_71D5					0x71D50000
+
+// Commands of the FMC register
+#define FLASH_FMC_WRITE					0x01
+#define FLASH_FMC_ERASE					0x02
+
+/**
+ * @brief Starts a flash operation and waits until it is done.
+ *
+ * @param command The command bit of the FMC register.
+ *
+ * @return 0x01 if the operation succeeded, 0x00 if it caused an access error.
+ */
+static uint8_t Flash_Execute(uint32_t command)
+{
+	uint32_t key = (FLASH_BOOTCFG & 0x10) ? FLASH_KEY_A442 : FLASH_KEY_71D5;
+
+	// Clear the access error (AMISC, Bit 0) of an earlier operation
+	FLASH_CTRL->FCMISC = 0x01;
+
+	// Start the operation and wait until the command bit is cleared by the hardware
+	FLASH_CTRL->FMC = key | command;
+	while (FLASH_CTRL->FMC & command);
+
+	// Check the access error bit (ARIS, Bit 0) of the FCRIS register
+	return ((FLASH_CTRL->FCRIS & 0x01) == 0) ? 0x01 : 0x00;
+}
+
+uint8_t Flash_Erase_Block(uint32_t address)
+{
+	// Select the block to be erased
+	FLASH_CTRL->FMA = address & ~(FLASH_BLOCK_SIZE - 1);
+
+	return Flash_Execute(FLASH_FMC_ERASE);
+}
+
+uint8_t Flash_Write_Word(uint32_t address, uint32_t data)
+{
+	// Select the word and the value to be programmed
+	FLASH_CTRL->FMA = address & ~0x03UL;
+	FLASH_CTRL->FMD = data;
+
+	return Flash_Execute(FLASH_FMC_WRITE);
+}
@@ -0,0 +1,53 @@
+/**
+ * @file Flash.h
+ *
+ * @brief Header file for the Flash driver.
+ *
+ * This file contains the function definitions for the Flash driver.
+ * It erases and programs the internal flash memory through the Flash Memory Address (FMA),
+ * Flash Memory Data (FMD) and Flash Memory Control (FMC) registers.
+ *
+ * The flash memory is erased in 1 KB blocks (all bits set to 1) and programmed one 32-bit word
+ * at a time (bits can only be cleared). It can be read like any other memory.
+ *
+ * @note The processor cannot fetch instructions from the flash memory while it is being erased
+ * or programmed, so every interrupt is delayed until the operation is done. Programming a word
+ * takes tens of microseconds, erasing a block takes milliseconds.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef FLASH_H
+#define FLASH_H
+
+#include "TM4C123GH6PM.h"
+
+// Size of an erase block in bytes
+#define FLASH_BLOCK_SIZE				1024
+
+// Value of an erased word
+#define FLASH_ERASED_WORD				0xFFFFFFFF
+
+/**
+ * @brief Erases a 1 KB block of the flash memory.
+ *
+ * @param address The address of the block (a multiple of 1024).
+ *
+ * @return 0x01 if the block was erased, 0x00 if the block is protected.
+ */
+uint8_t Flash_Erase_Block(uint32_t address);
+
+/**
+ * @brief Programs one 32-bit word of the flash memory.
+ *
+ * The word must be erased unless only bits that are 1 are cleared.
+ *
+ * @param address The address of the word (a multiple of 4).
+ *
+ * @param data The value to be programmed.
+ *
+ * @return 0x01 if the word was programmed, 0x00 if the block is protected.
+ */
+uint8_t Flash_Write_Word(uint32_t address, uint32_t data);
+
+#endif
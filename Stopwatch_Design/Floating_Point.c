@@ -0,0 +1,125 @@
+/**
+ * @file Floating_Point.c
+ *
+ * @brief Source code for the Floating_Point driver.
+ *
+ * This file contains the function definitions for the Floating_Point driver.
+ *
+ * @author Katherine Poz
+ */
+
+#include "Floating_Point.h"
+
+void Floating_Point_Init(void)
+{
+	// Allow full access to the FPU (CP10, Bits 21:20 and CP11, Bits 23:22 of CPACR)
+	SCB->CPACR |= (0x0FUL << 20);
+
+	// Enable the automatic preservation (ASPEN, Bit 31) and the lazy stacking (LSPEN, Bit 30)
+	// of the floating-point context on exception entry
+	FPU->FPCCR |= FPU_FPCCR_ASPEN_Msk | FPU_FPCCR_LSPEN_Msk;
+
+	// Complete the register writes before the next floating-point instruction
+	__DSB();
+	__ISB();
+}
+
+#ifdef FLOATING_POINT_BENCHMARK
+
+// Number of measurements of each exception cost (the smallest result is used)
+#define FLOATING_POINT_BENCHMARK_RUNS		8
+
+// Number of calculations that are averaged for each measurement
+#define FLOATING_POINT_BENCHMARK_CALLS		100
+
+/**
+ * @brief Measures the round trip of the SysTick exception with or without an active floating-point context.
+ *
+ * @param fp_context 0x01 to mark the floating-point context of the thread as active (FPCA), 0x00 to clear it.
+ *
+ * @return The smallest round trip in system clock cycles.
+ */
+static uint32_t Floating_Point_Measure_Exception(uint8_t fp_context)
+{
+	uint32_t min_round_trip = 0xFFFFFFFF;
+
+	// Enable the SysTick interrupt without starting the counter
+	SysTick->CTRL = 0x02;
+
+	for (uint8_t i = 0; i < FLOATING_POINT_BENCHMARK_RUNS; i++)
+	{
+		// Set or clear the FPCA bit (Bit 2) of the CONTROL register, which decides whether
+		// the exception frame includes the floating-point registers
+		if (fp_context != 0x00)
+		{
+			__set_CONTROL(__get_CONTROL() | 0x04);
+		}
+		else
+		{
+			__set_CONTROL(__get_CONTROL() & ~0x04UL);
+		}
+
+		uint32_t start = DWT->CYCCNT;
+
+		// Pend the SysTick exception by setting the PENDSTSET bit (Bit 26) of the ICSR register
+		SCB->ICSR = 0x04000000;
+		__DSB();
+		__ISB();
+
+		uint32_t end = DWT->CYCCNT;
+		if ((end - start) < min_round_trip)
+		{
+			min_round_trip = end - start;
+		}
+	}
+
+	SysTick->CTRL = 0;
+
+	return min_round_trip;
+}
+
+void Floating_Point_Benchmark(Floating_Point_Benchmark_Result *result)
+{
+	// Operands are volatile so the divisions are not evaluated at compile time
+	volatile double note_double = 261.6;
+	volatile float note_float = 261.6f;
+	volatile uint32_t note_dhz = 2616;
+	volatile int period_us;
+	uint32_t start_cycles;
+
+	result->no_context_cycles = Floating_Point_Measure_Exception(0x00);
+	result->lazy_stacking_cycles = Floating_Point_Measure_Exception(0x01);
+
+	// Save the floating-point context on every exception entry (LSPEN, Bit 30 cleared)
+	FPU->FPCCR &= ~FPU_FPCCR_LSPEN_Msk;
+	result->full_stacking_cycles = Floating_Point_Measure_Exception(0x01);
+	FPU->FPCCR |= FPU_FPCCR_LSPEN_Msk;
+
+	// Measure the period calculation of the buzzer in double precision (library emulation)
+	start_cycles = DWT->CYCCNT;
+	for (uint32_t i = 0; i < FLOATING_POINT_BENCHMARK_CALLS; i++)
+	{
+		period_us = (int)(((double)1 / note_double) * ((double)1000000));
+	}
+	result->double_period_cycles = (DWT->CYCCNT - start_cycles) / FLOATING_POINT_BENCHMARK_CALLS;
+
+	// Measure the same calculation in single precision (FPU)
+	start_cycles = DWT->CYCCNT;
+	for (uint32_t i = 0; i < FLOATING_POINT_BENCHMARK_CALLS; i++)
+	{
+		period_us = (int)(1000000.0f / note_float);
+	}
+	result->float_period_cycles = (DWT->CYCCNT - start_cycles) / FLOATING_POINT_BENCHMARK_CALLS;
+
+	// Measure the same calculation in fixed point with the frequency in units of 0.1 Hz
+	start_cycles = DWT->CYCCNT;
+	for (uint32_t i = 0; i < FLOATING_POINT_BENCHMARK_CALLS; i++)
+	{
+		period_us = (int)(10000000U / note_dhz);
+	}
+	result->fixed_period_cycles = (DWT->CYCCNT - start_cycles) / FLOATING_POINT_BENCHMARK_CALLS;
+
+	(void)period_us;
+}
+
+#endif
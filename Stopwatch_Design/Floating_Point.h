@@ -0,0 +1,68 @@
+/**
+ * @file Floating_Point.h
+ *
+ * @brief Header file for the Floating_Point driver.
+ *
+ * This file contains the function definitions for the Floating_Point driver.
+ * It sets the floating-point policy of the application:
+ *	- The single-precision FPU is enabled for privileged and unprivileged code (CP10 and CP11).
+ *	- Automatic state preservation (ASPEN) and lazy stacking (LSPEN) are enabled, so an interrupt
+ *	  only reserves space for S0 to S15 and FPSCR in its exception frame. The registers are saved
+ *	  only if the handler executes a floating-point instruction, so handlers without floating-point
+ *	  code do not pay for the context of the interrupted code.
+ *	- Floating-point math is single precision (float) or fixed point. The FPU cannot execute double
+ *	  precision, which is emulated by library calls (e.g. __aeabi_ddiv) that take several hundred cycles.
+ *
+ * @note Building with FLOATING_POINT_BENCHMARK defined adds Floating_Point_Benchmark, which measures
+ * the cost of an exception with lazy and with immediate stacking of the floating-point context, and
+ * the cost of the buzzer period calculation in double precision, single precision and fixed point.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef FLOATING_POINT_H
+#define FLOATING_POINT_H
+
+#include "TM4C123GH6PM.h"
+
+/**
+ * @brief Enables the FPU with automatic and lazy stacking of the floating-point context.
+ *
+ * This function must be called before any interrupt is enabled.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Floating_Point_Init(void);
+
+#ifdef FLOATING_POINT_BENCHMARK
+
+typedef struct
+{
+	uint32_t no_context_cycles;			// Exception round trip without an active floating-point context
+	uint32_t lazy_stacking_cycles;		// Exception round trip with an active context and lazy stacking
+	uint32_t full_stacking_cycles;		// Exception round trip with an active context saved on every entry
+	uint32_t double_period_cycles;		// Buzzer period calculation in double precision
+	uint32_t float_period_cycles;		// Buzzer period calculation in single precision
+	uint32_t fixed_period_cycles;		// Buzzer period calculation in fixed point (0.1 Hz)
+} Floating_Point_Benchmark_Result;
+
+/**
+ * @brief Measures the cost of the floating-point context and of the buzzer period calculation.
+ *
+ * The exceptions are requested by pending SysTick, whose handler does not use the FPU.
+ * The measured costs include two reads of the cycle counter. Lazy stacking is enabled again
+ * when the function returns.
+ *
+ * @note SysTick_Delay_Init must be called first, since it enables the cycle counter.
+ *
+ * @param result Pointer to the structure that receives the measured cycle counts.
+ *
+ * @return None
+ */
+void Floating_Point_Benchmark(Floating_Point_Benchmark_Result *result);
+
+#endif
+
+#endif
@@ -29,17 +29,7 @@ const uint8_t EDUBASE_LED_ALL_ON	= 0xF;
 
 void RGB_LED_Init(void)
 {
-	// Enable the clock to Port F
-	SYSCTL->RCGCGPIO |= 0x20;
-
-	// Set PF1, PF2, and PF3 as output GPIO pins
-	GPIOF->DIR |= 0x0E;
-	
-	// Configure PF1, PF2, and PF3 to function as GPIO pins
-	GPIOF->AFSEL &= ~0x0E;
-	
-	// Enable digital functionality for PF1, PF2, and PF3
-	GPIOF->DEN |= 0x0E;
+	// PF1, PF2, and PF3 are configured as outputs by Board_Pins_Init
 	
 	// Initialize the output of the RGB LED to zero
 	GPIOF->DATA &= ~0x0E;
@@ -62,17 +52,7 @@ uint8_t RGB_LED_Status(void)
 
 void EduBase_LEDs_Init(void)
 {
-	// Enable the clock to Port B
-	SYSCTL->RCGCGPIO |= 0x02;
-	
-	// Set PB0, PB1, PB2, and PB3 as output GPIO pins
-	GPIOB->DIR |= 0x0F;
-	
-	// Configure PB0, PB1, PB2, and PB3 to function as GPIO pins
-	GPIOB->AFSEL &= ~0x0F;
-	
-	// Enable digital functionality for PB0, PB1, PB2, and PB3
-	GPIOB->DEN |= 0x0F;
+	// PB0, PB1, PB2, and PB3 are configured as outputs by Board_Pins_Init
 	
 	// Initialize the output of the EduBase LEDs to zero
 	GPIOB->DATA &= ~0x0F;
@@ -86,17 +66,8 @@ void EduBase_LEDs_Output(uint8_t led_value)
 
 void EduBase_Button_Init(void)
 {
-	// Enable the clock to Port D
-	SYSCTL->RCGCGPIO |= 0x08;
-	
-	// Set PD0, PD1, PD2, and PD3 as input GPIO pins
-	GPIOD->DIR &= ~0x0F;
-	
-	// Configure PD0, PD1, PD2, and PD3 to function as GPIO pins
-	GPIOD->AFSEL &= ~0x0F;
-	
-	// Enable digital functionality for PD0, PD1, PD2, and PD3
-	GPIOD->DEN |= 0x0F;
+	// PD0, PD1, PD2, and PD3 are configured as inputs with weak pull-down
+	// resistors by Board_Pins_Init, so no further configuration is needed
 }
 
 uint8_t Get_EduBase_Button_Status(void)
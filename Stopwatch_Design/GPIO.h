@@ -31,8 +31,8 @@ extern const uint8_t EDUBASE_LED_ALL_ON;
 /**
  * @brief The RGB_LED_Init function initializes the RGB LED (PF1 - PF3)
  *
- * This function initializes the following RGB LED pins, configures the digital functionality for the pins,
- * and sets the direction of the pins as output. The RGB LED is off by default upon initialization.
+ * This function turns off the RGB LED. The pins must be configured as outputs in the board pin table
+ * and Board_Pins_Init must be called first. The board pin table assigns them to the RGB_LED_PWM driver.
  *  - LED_R     (PF1)
  *  - LED_B     (PF2)
  *  - LED_G     (PF3)
@@ -85,8 +85,8 @@ uint8_t RGB_LED_Status(void);
 /**
  * @brief The EduBase_LEDs_Init function initializes the EduBase Board LEDs (LED0 - LED3)
  *
- * This function initializes the following EduBase Board LEDs, configures the digital functionality for the pins,
- * and sets the direction of the pins as output. The EduBase Board LEDs are off by default upon initialization.
+ * This function turns off the EduBase Board LEDs. The pins are configured as outputs by Board_Pins_Init,
+ * which must be called first.
  *  - LED0		(PB0)
  *  - LED1		(PB1)
  *  - LED2		(PB2)
@@ -116,8 +116,8 @@ void EduBase_LEDs_Output(uint8_t led_value);
 /**
  * @brief The EduBase_Button_Init function initializes the EduBase Board buttons (SW2 - SW5).
  *
- * This function initializes the EduBase Board buttons connected to pins PD0, PD1, PD2, and PD3.
- * It enables digital functionality and configures the pins as GPIO input pins.
+ * The EduBase Board buttons are connected to pins PD0, PD1, PD2, and PD3.
+ * The pins are configured as GPIO input pins by Board_Pins_Init, which must be called first.
  *
  * @param None
  *
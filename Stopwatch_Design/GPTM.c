@@ -0,0 +1,594 @@
+/**
+ * @file GPTM.c
+ *
+ * @brief Source code for the GPTM driver.
+ *
+ * This file contains the function definitions for the GPTM driver.
+ * It configures any of the general-purpose timer modules from one constant instance table:
+ *	- 16/32-bit timers: Timer 0 to Timer 5
+ *	- 32/64-bit wide timers: Wide Timer 0 to Wide Timer 5
+ *
+ * The registers of Timer B directly follow the same registers of Timer A, and the Timer B bits
+ * of the GPTMCTL, GPTMIMR, GPTMRIS, GPTMMIS and GPTMICR registers are the Timer A bits shifted
+ * left by 8, so both halves are handled by the same code.
+ *
+ * @note Refer to Table 2-9 (Interrupts) on pages 104 - 106 from the TM4C123G Microcontroller Datasheet
+ * to view the Interrupt Request (IRQ) Number of each timer.
+ *
+ * @author Katherine Poz
+ */
+
+#include "GPTM.h"
+
+// Registers of one half of a timer
+#define GPTM_MR(timer, half)			((&(timer)->TAMR)[half])
+#define GPTM_ILR(timer, half)			((&(timer)->TAILR)[half])
+#define GPTM_MATCHR(timer, half)		((&(timer)->TAMATCHR)[half])
+#define GPTM_PR(timer, half)			((&(timer)->TAPR)[half])
+#define GPTM_PMR(timer, half)			((&(timer)->TAPMR)[half])
+#define GPTM_R(timer, half)				((&(timer)->TAR)[half])
+#define GPTM_V(timer, half)				((&(timer)->TAV)[half])
+
+// Position of the bits of one half in the GPTMCTL and interrupt registers
+#define GPTM_SHIFT(half)				((half) * 8)
+
+// Interrupt bits of one half: time-out (Bit 0), capture match (Bit 1), capture event (Bit 2) and match (Bit 4)
+#define GPTM_INT_TIMEOUT				0x01
+#define GPTM_INT_CAPTURE_MATCH			0x02
+#define GPTM_INT_CAPTURE_EVENT			0x04
+#define GPTM_INT_ALL					0x17
+
+typedef struct
+{
+	TIMER0_Type *timer;				// Base address of the timer module
+	uint8_t wide;						// 0x01 for a 32/64-bit wide timer (RCGCWTIMER), 0x00 for a 16/32-bit timer (RCGCTIMER)
+	uint8_t clock_bit;				// Bit of the timer in the RCGCTIMER or RCGCWTIMER register
+	uint8_t sync_shift;				// Position of the timer's field in the GPTMSYNC register
+	IRQn_Type irq_a;					// Interrupt Request (IRQ) number of Timer A (Timer B uses the next number)
+} GPTM_Config;
+
+// Instance table of all general-purpose timer modules
+static const GPTM_Config gptm_config[GPTM_INSTANCE_COUNT] =
+{
+	{ (TIMER0_Type *) TIMER0,  0x00, 0,  0, TIMER0A_IRQn  },
+	{ (TIMER0_Type *) TIMER1,  0x00, 1,  2, TIMER1A_IRQn  },
+	{ (TIMER0_Type *) TIMER2,  0x00, 2,  4, TIMER2A_IRQn  },
+	{ (TIMER0_Type *) TIMER3,  0x00, 3,  6, TIMER3A_IRQn  },
+	{ (TIMER0_Type *) TIMER4,  0x00, 4,  8, TIMER4A_IRQn  },
+	{ (TIMER0_Type *) TIMER5,  0x00, 5, 10, TIMER5A_IRQn  },
+	{ (TIMER0_Type *) WTIMER0, 0x01, 0, 12, WTIMER0A_IRQn },
+	{ (TIMER0_Type *) WTIMER1, 0x01, 1, 14, WTIMER1A_IRQn },
+	{ (TIMER0_Type *) WTIMER2, 0x01, 2, 16, WTIMER2A_IRQn },
+	{ (TIMER0_Type *) WTIMER3, 0x01, 3, 18, WTIMER3A_IRQn },
+	{ (TIMER0_Type *) WTIMER4, 0x01, 4, 20, WTIMER4A_IRQn },
+	{ (TIMER0_Type *) WTIMER5, 0x01, 5, 22, WTIMER5A_IRQn }
+};
+
+// Pointers to the user-defined tasks of every half of every timer
+static void (*GPTM_Tasks[GPTM_INSTANCE_COUNT][2])(void);
+static void (*GPTM_Capture_Tasks[GPTM_INSTANCE_COUNT][2])(uint32_t capture);
+
+// Pointers to the raw handlers that replace the interrupt processing of a half
+static void (*GPTM_Raw_Handlers[GPTM_INSTANCE_COUNT][2])(void);
+
+// Pointer to the handler that receives the exception frame of the Wide Timer 5A interrupt
+static void (*GPTM_Frame_Handler)(const uint32_t *frame);
+
+// PWM period of every half in system clock cycles
+static uint32_t GPTM_PWM_Period[GPTM_INSTANCE_COUNT][2];
+
+// Halves of every timer that have been configured (Bit 0 = Timer A, Bit 1 = Timer B)
+static uint8_t GPTM_Configured[GPTM_INSTANCE_COUNT];
+
+/**
+ * @brief Acquires the clock to a timer module in run and sleep mode and waits until it is ready.
+ *
+ * A timer holds one reference to its clock while any of its halves is configured,
+ * so this function must be called before the configured halves are updated.
+ *
+ * @param instance The timer.
+ *
+ * @return None
+ */
+static void GPTM_Acquire_Clock(GPTM_Instance instance)
+{
+	const GPTM_Config *config = &gptm_config[instance];
+
+	if (GPTM_Configured[instance] == 0)
+	{
+		Clock_Gating_Acquire(config->wide ? CLOCK_GATING_WTIMER : CLOCK_GATING_TIMER, (1U << config->clock_bit), CLOCK_GATING_RUN_SLEEP);
+	}
+}
+
+/**
+ * @brief Enables interrupts of one half of a timer in the timer and in the NVIC.
+ *
+ * @param instance The timer.
+ *
+ * @param half GPTM_TIMER_A or GPTM_TIMER_B.
+ *
+ * @param flags The interrupt bits of the half (GPTM_INT_...).
+ *
+ * @param priority The interrupt priority level.
+ *
+ * @return None
+ */
+static void GPTM_Enable_Interrupt(GPTM_Instance instance, GPTM_Half half, uint32_t flags, uint8_t priority)
+{
+	const GPTM_Config *config = &gptm_config[instance];
+	IRQn_Type irq = (IRQn_Type)(config->irq_a + half);
+
+	config->timer->IMR |= (flags << GPTM_SHIFT(half));
+
+	NVIC_SetPriority(irq, priority);
+	NVIC_EnableIRQ(irq);
+}
+
+/**
+ * @brief Writes a value that is extended by the prescaler in the split modes.
+ *
+ * On the 16/32-bit timers, Bits 15 to 0 are written to the value register and
+ * Bits 23 to 16 to the prescale register. On the wide timers, the value register holds all 32 bits.
+ *
+ * @param config Pointer to the instance table entry of the timer.
+ *
+ * @param value_register The GPTMTnILR or GPTMTnMATCHR register.
+ *
+ * @param prescale_register The GPTMTnPR or GPTMTnPMR register.
+ *
+ * @param value The value to be written.
+ *
+ * @return None
+ */
+static void GPTM_Write_Extended(const GPTM_Config *config, volatile uint32_t *value_register, volatile uint32_t *prescale_register, uint32_t value)
+{
+	if (config->wide)
+	{
+		*prescale_register = 0;
+		*value_register = value;
+	}
+	else
+	{
+		*prescale_register = (value >> 16) & 0xFF;
+		*value_register = value & 0xFFFF;
+	}
+}
+
+/**
+ * @brief Configures a timer in a concatenated mode.
+ *
+ * @param instance The timer to be configured.
+ *
+ * @param mode The value of the TAMR field (0x1 = One-Shot, 0x2 = Periodic).
+ *
+ * @param period The period in system clock cycles.
+ *
+ * @param task A pointer to the user-defined function, or NULL.
+ *
+ * @param priority The interrupt priority level.
+ *
+ * @return None
+ */
+static void GPTM_Init_Concatenated(GPTM_Instance instance, uint32_t mode, uint32_t period, void(*task)(void), uint8_t priority)
+{
+	const GPTM_Config *config = &gptm_config[instance];
+	TIMER0_Type *timer = config->timer;
+
+	GPTM_Acquire_Clock(instance);
+
+	// Store the user-defined task function for use during interrupt handling
+	GPTM_Tasks[instance][GPTM_TIMER_A] = task;
+	GPTM_Tasks[instance][GPTM_TIMER_B] = 0;
+	GPTM_Capture_Tasks[instance][GPTM_TIMER_A] = 0;
+	GPTM_Capture_Tasks[instance][GPTM_TIMER_B] = 0;
+	GPTM_Configured[instance] = 0x01;
+
+	// Disable Timer A and Timer B during configuration (TAEN, Bit 0 and TBEN, Bit 8)
+	timer->CTL &= ~0x0101;
+
+	// Mask and clear all interrupts of both halves
+	timer->IMR &= ~((GPTM_INT_ALL << 8) | GPTM_INT_ALL);
+	timer->ICR = (GPTM_INT_ALL << 8) | GPTM_INT_ALL;
+
+	// Select the concatenated configuration (32-bit for 16/32-bit timers, 64-bit for wide timers)
+	timer->CFG = 0x00;
+
+	// Select the mode and count down
+	timer->TAMR = mode;
+
+	// Set the interval load value. The upper half is only used by the 64-bit configuration.
+	timer->TAILR = period - 1;
+	timer->TBILR = 0;
+
+	if (task != 0)
+	{
+		// Enable the time-out interrupt (TATOIM, Bit 0)
+		GPTM_Enable_Interrupt(instance, GPTM_TIMER_A, GPTM_INT_TIMEOUT, priority);
+	}
+}
+
+/**
+ * @brief Prepares one half of a timer for a split mode.
+ *
+ * @param instance The timer to be configured.
+ *
+ * @param half GPTM_TIMER_A or GPTM_TIMER_B.
+ *
+ * @return Pointer to the registers of the timer.
+ */
+static TIMER0_Type *GPTM_Init_Split(GPTM_Instance instance, GPTM_Half half)
+{
+	const GPTM_Config *config = &gptm_config[instance];
+	TIMER0_Type *timer = config->timer;
+	uint32_t shift = GPTM_SHIFT(half);
+
+	GPTM_Acquire_Clock(instance);
+
+	GPTM_Tasks[instance][half] = 0;
+	GPTM_Capture_Tasks[instance][half] = 0;
+	GPTM_Configured[instance] |= (1U << half);
+
+	// Disable the half during configuration
+	timer->CTL &= ~(0x01UL << shift);
+
+	// Clear the output level (TnPWML) and event (TnEVENT) settings of the half
+	timer->CTL &= ~(0x4CUL << shift);
+
+	// Mask and clear all interrupts of the half
+	timer->IMR &= ~(GPTM_INT_ALL << shift);
+	timer->ICR = (GPTM_INT_ALL << shift);
+
+	// Select the split configuration (16-bit for 16/32-bit timers, 32-bit for wide timers)
+	timer->CFG = 0x04;
+
+	return timer;
+}
+
+void GPTM_Init_Periodic(GPTM_Instance instance, uint32_t period, void(*task)(void), uint8_t priority)
+{
+	GPTM_Init_Concatenated(instance, 0x02, period, task, priority);
+}
+
+void GPTM_Init_One_Shot(GPTM_Instance instance, uint32_t period, void(*task)(void), uint8_t priority)
+{
+	GPTM_Init_Concatenated(instance, 0x01, period, task, priority);
+}
+
+void GPTM_Init_Split_Periodic(GPTM_Instance instance, GPTM_Half half, uint32_t prescale, uint32_t interval, void(*task)(void), uint8_t priority)
+{
+	TIMER0_Type *timer = GPTM_Init_Split(instance, half);
+
+	GPTM_Tasks[instance][half] = task;
+
+	// Select the periodic mode (TnMR = 0x2) and load a new interval at the next time-out (TnILD, Bit 8)
+	GPTM_MR(timer, half) = 0x102;
+
+	// The prescaler divides the system clock by (TnPSR + 1)
+	GPTM_PR(timer, half) = prescale - 1;
+
+	GPTM_ILR(timer, half) = interval - 1;
+
+	if (task != 0)
+	{
+		GPTM_Enable_Interrupt(instance, half, GPTM_INT_TIMEOUT, priority);
+	}
+}
+
+void GPTM_Init_PWM(GPTM_Instance instance, GPTM_Half half, uint32_t period, uint8_t inverted)
+{
+	const GPTM_Config *config = &gptm_config[instance];
+	TIMER0_Type *timer = GPTM_Init_Split(instance, half);
+
+	GPTM_PWM_Period[instance][half] = period;
+
+	// Select the PWM mode: periodic (TnMR = 0x2), alternate mode (TnAMS, Bit 3), load a new interval
+	// (TnILD, Bit 8) and a new match value (TnMRSU, Bit 10) at the end of the current period
+	GPTM_MR(timer, half) = 0x50A;
+
+	// Invert the output if requested (TnPWML, Bit 6)
+	if (inverted != 0x00)
+	{
+		timer->CTL |= (0x40UL << GPTM_SHIFT(half));
+	}
+
+	// The counter counts down from (period - 1). The output is set when the counter is reloaded
+	// and cleared when the counter reaches the match value.
+	GPTM_Write_Extended(config, &GPTM_ILR(timer, half), &GPTM_PR(timer, half), period - 1);
+
+	// Start with a duty cycle of 0%
+	GPTM_Write_Extended(config, &GPTM_MATCHR(timer, half), &GPTM_PMR(timer, half), period - 1);
+}
+
+void GPTM_Set_PWM_Duty(GPTM_Instance instance, GPTM_Half half, uint32_t high_cycles)
+{
+	const GPTM_Config *config = &gptm_config[instance];
+	TIMER0_Type *timer = config->timer;
+	uint32_t period = GPTM_PWM_Period[instance][half];
+	uint32_t match = 0;
+
+	if (high_cycles < period)
+	{
+		match = (period - 1) - high_cycles;
+	}
+
+	GPTM_Write_Extended(config, &GPTM_MATCHR(timer, half), &GPTM_PMR(timer, half), match);
+}
+
+void GPTM_Init_Edge_Count(GPTM_Instance instance, GPTM_Half half, uint8_t edge, uint32_t match, void(*task)(void), uint8_t priority)
+{
+	const GPTM_Config *config = &gptm_config[instance];
+	TIMER0_Type *timer = GPTM_Init_Split(instance, half);
+
+	GPTM_Tasks[instance][half] = task;
+
+	// Select the capture mode (TnMR = 0x3) in edge-count mode (TnCMR = 0) and count up (TnCDIR, Bit 4)
+	GPTM_MR(timer, half) = 0x13;
+
+	// Select the edges to be counted (TnEVENT field)
+	timer->CTL |= ((uint32_t)(edge & 0x3) << (2 + GPTM_SHIFT(half)));
+
+	// Count up to the full range and stop at the match value
+	GPTM_Write_Extended(config, &GPTM_ILR(timer, half), &GPTM_PR(timer, half), 0xFFFFFFFF);
+	GPTM_Write_Extended(config, &GPTM_MATCHR(timer, half), &GPTM_PMR(timer, half), match);
+
+	if (task != 0)
+	{
+		GPTM_Enable_Interrupt(instance, half, GPTM_INT_CAPTURE_MATCH, priority);
+	}
+}
+
+void GPTM_Init_Edge_Time(GPTM_Instance instance, GPTM_Half half, uint8_t edge, void(*task)(uint32_t capture), uint8_t priority)
+{
+	const GPTM_Config *config = &gptm_config[instance];
+	TIMER0_Type *timer = GPTM_Init_Split(instance, half);
+
+	GPTM_Capture_Tasks[instance][half] = task;
+
+	// Select the capture mode (TnMR = 0x3) in edge-time mode (TnCMR, Bit 2) and count up (TnCDIR, Bit 4)
+	GPTM_MR(timer, half) = 0x17;
+
+	// Select the edges to be captured (TnEVENT field)
+	timer->CTL |= ((uint32_t)(edge & 0x3) << (2 + GPTM_SHIFT(half)));
+
+	// Count through the full range
+	GPTM_Write_Extended(config, &GPTM_ILR(timer, half), &GPTM_PR(timer, half), 0xFFFFFFFF);
+
+	GPTM_Enable_Interrupt(instance, half, GPTM_INT_CAPTURE_EVENT, priority);
+}
+
+void GPTM_Enable_ADC_Trigger(GPTM_Instance instance)
+{
+	// Set the TAOTE bit (Bit 5) in the GPTMCTL register
+	gptm_config[instance].timer->CTL |= 0x20;
+}
+
+void GPTM_Enable(GPTM_Instance instance, GPTM_Half half)
+{
+	// Set the TnEN bit in the GPTMCTL register
+	gptm_config[instance].timer->CTL |= (0x01UL << GPTM_SHIFT(half));
+}
+
+void GPTM_Disable(GPTM_Instance instance, GPTM_Half half)
+{
+	// Clear the TnEN bit in the GPTMCTL register
+	gptm_config[instance].timer->CTL &= ~(0x01UL << GPTM_SHIFT(half));
+}
+
+void GPTM_Sync_Start(uint32_t instance_mask)
+{
+	uint32_t sync_value = 0;
+
+	// The GPTMSYNC register is only implemented in Timer 0
+	// Hold a reference to its clock while the register is written
+	Clock_Gating_Acquire(CLOCK_GATING_TIMER, 0x01, CLOCK_GATING_RUN);
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	// Enable every configured half of the selected timers. The counters are reloaded
+	// together below, so the order and timing of these writes does not matter.
+	for (uint8_t i = 0; i < GPTM_INSTANCE_COUNT; i++)
+	{
+		if (instance_mask & GPTM_MASK(i))
+		{
+			if (GPTM_Configured[i] & 0x01)
+			{
+				gptm_config[i].timer->CTL |= 0x001;
+			}
+
+			if (GPTM_Configured[i] & 0x02)
+			{
+				gptm_config[i].timer->CTL |= 0x100;
+			}
+
+			// 0x3 = Generate a time-out event for Timer A and Timer B
+			sync_value |= (0x3UL << gptm_config[i].sync_shift);
+		}
+	}
+
+	// Reload all selected counters in the same clock cycle
+	TIMER0->SYNC = sync_value;
+
+	// Discard the time-out that was generated by the synchronization itself
+	for (uint8_t i = 0; i < GPTM_INSTANCE_COUNT; i++)
+	{
+		if (instance_mask & GPTM_MASK(i))
+		{
+			gptm_config[i].timer->ICR = 0x0101;
+			NVIC_ClearPendingIRQ(gptm_config[i].irq_a);
+			NVIC_ClearPendingIRQ((IRQn_Type)(gptm_config[i].irq_a + 1));
+		}
+	}
+
+	__set_PRIMASK(primask);
+
+	Clock_Gating_Release(CLOCK_GATING_TIMER, 0x01, CLOCK_GATING_RUN);
+}
+
+void GPTM_Deinit(GPTM_Instance instance)
+{
+	const GPTM_Config *config = &gptm_config[instance];
+	TIMER0_Type *timer = config->timer;
+
+	if (GPTM_Configured[instance] == 0)
+	{
+		return;
+	}
+
+	// Stop both halves and mask all of their interrupts
+	timer->CTL &= ~0x0101;
+	timer->IMR = 0;
+	timer->ICR = (GPTM_INT_ALL << 8) | GPTM_INT_ALL;
+
+	NVIC_DisableIRQ(config->irq_a);
+	NVIC_DisableIRQ((IRQn_Type)(config->irq_a + 1));
+
+	GPTM_Tasks[instance][GPTM_TIMER_A] = 0;
+	GPTM_Tasks[instance][GPTM_TIMER_B] = 0;
+	GPTM_Capture_Tasks[instance][GPTM_TIMER_A] = 0;
+	GPTM_Capture_Tasks[instance][GPTM_TIMER_B] = 0;
+	GPTM_Raw_Handlers[instance][GPTM_TIMER_A] = 0;
+	GPTM_Raw_Handlers[instance][GPTM_TIMER_B] = 0;
+
+	if (instance == GPTM_WTIMER5)
+	{
+		GPTM_Frame_Handler = 0;
+	}
+
+	GPTM_Configured[instance] = 0;
+
+	// Release the reference of the timer to its clock
+	Clock_Gating_Release(config->wide ? CLOCK_GATING_WTIMER : CLOCK_GATING_TIMER, (1U << config->clock_bit), CLOCK_GATING_RUN_SLEEP);
+}
+
+void GPTM_Set_Raw_Handler(GPTM_Instance instance, GPTM_Half half, void(*handler)(void))
+{
+	GPTM_Raw_Handlers[instance][half] = handler;
+}
+
+void GPTM_Set_WTIMER5A_Frame_Handler(void(*handler)(const uint32_t *frame))
+{
+	GPTM_Frame_Handler = handler;
+}
+
+void GPTM_Set_Interval(GPTM_Instance instance, GPTM_Half half, uint32_t interval)
+{
+	GPTM_ILR(gptm_config[instance].timer, half) = interval - 1;
+}
+
+uint32_t GPTM_Get_Interval(GPTM_Instance instance, GPTM_Half half)
+{
+	return GPTM_ILR(gptm_config[instance].timer, half) + 1;
+}
+
+uint32_t GPTM_Get_Count(GPTM_Instance instance, GPTM_Half half)
+{
+	return GPTM_V(gptm_config[instance].timer, half);
+}
+
+uint8_t GPTM_Timeout_Pending(GPTM_Instance instance, GPTM_Half half)
+{
+	// Read the TnTORIS bit in the GPTMRIS register
+	return (uint8_t)((gptm_config[instance].timer->RIS >> GPTM_SHIFT(half)) & GPTM_INT_TIMEOUT);
+}
+
+/**
+ * @brief Handles the interrupt of one half of a timer.
+ *
+ * The interrupt is cleared before the task is executed, so a task that reads the
+ * timer observes the time-out as handled. If a raw handler is installed, it is executed
+ * instead and the interrupts of the half are left to it.
+ *
+ * @param instance The timer that generated the interrupt.
+ *
+ * @param half GPTM_TIMER_A or GPTM_TIMER_B.
+ *
+ * @return None
+ */
+static void GPTM_Handler(GPTM_Instance instance, GPTM_Half half)
+{
+	if (GPTM_Raw_Handlers[instance][half] != 0)
+	{
+		(*GPTM_Raw_Handlers[instance][half])();
+		return;
+	}
+
+	const GPTM_Config *config = &gptm_config[instance];
+	TIMER0_Type *timer = config->timer;
+	uint32_t status = (timer->MIS >> GPTM_SHIFT(half)) & GPTM_INT_ALL;
+
+	if (status == 0)
+	{
+		return;
+	}
+
+	// Acknowledge the interrupts of the half and clear them
+	timer->ICR = (status << GPTM_SHIFT(half));
+
+	if ((status & GPTM_INT_CAPTURE_EVENT) && (GPTM_Capture_Tasks[instance][half] != 0))
+	{
+		// The captured counter value is 24 bits wide on the 16/32-bit timers
+		uint32_t capture = GPTM_R(timer, half);
+		(*GPTM_Capture_Tasks[instance][half])(config->wide ? capture : (capture & 0x00FFFFFF));
+	}
+
+	if ((status & (GPTM_INT_TIMEOUT | GPTM_INT_CAPTURE_MATCH)) && (GPTM_Tasks[instance][half] != 0))
+	{
+		(*GPTM_Tasks[instance][half])();
+	}
+}
+
+void TIMER0A_Handler(void)  { GPTM_Handler(GPTM_TIMER0,  GPTM_TIMER_A); }
+void TIMER0B_Handler(void)  { GPTM_Handler(GPTM_TIMER0,  GPTM_TIMER_B); }
+void TIMER1A_Handler(void)  { GPTM_Handler(GPTM_TIMER1,  GPTM_TIMER_A); }
+void TIMER1B_Handler(void)  { GPTM_Handler(GPTM_TIMER1,  GPTM_TIMER_B); }
+void TIMER2A_Handler(void)  { GPTM_Handler(GPTM_TIMER2,  GPTM_TIMER_A); }
+void TIMER2B_Handler(void)  { GPTM_Handler(GPTM_TIMER2,  GPTM_TIMER_B); }
+void TIMER3A_Handler(void)  { GPTM_Handler(GPTM_TIMER3,  GPTM_TIMER_A); }
+void TIMER3B_Handler(void)  { GPTM_Handler(GPTM_TIMER3,  GPTM_TIMER_B); }
+void TIMER4A_Handler(void)  { GPTM_Handler(GPTM_TIMER4,  GPTM_TIMER_A); }
+void TIMER4B_Handler(void)  { GPTM_Handler(GPTM_TIMER4,  GPTM_TIMER_B); }
+void TIMER5A_Handler(void)  { GPTM_Handler(GPTM_TIMER5,  GPTM_TIMER_A); }
+void TIMER5B_Handler(void)  { GPTM_Handler(GPTM_TIMER5,  GPTM_TIMER_B); }
+void WTIMER0A_Handler(void) { GPTM_Handler(GPTM_WTIMER0, GPTM_TIMER_A); }
+void WTIMER0B_Handler(void) { GPTM_Handler(GPTM_WTIMER0, GPTM_TIMER_B); }
+void WTIMER1A_Handler(void) { GPTM_Handler(GPTM_WTIMER1, GPTM_TIMER_A); }
+void WTIMER1B_Handler(void) { GPTM_Handler(GPTM_WTIMER1, GPTM_TIMER_B); }
+void WTIMER2A_Handler(void) { GPTM_Handler(GPTM_WTIMER2, GPTM_TIMER_A); }
+void WTIMER2B_Handler(void) { GPTM_Handler(GPTM_WTIMER2, GPTM_TIMER_B); }
+void WTIMER3A_Handler(void) { GPTM_Handler(GPTM_WTIMER3, GPTM_TIMER_A); }
+void WTIMER3B_Handler(void) { GPTM_Handler(GPTM_WTIMER3, GPTM_TIMER_B); }
+void WTIMER4A_Handler(void) { GPTM_Handler(GPTM_WTIMER4, GPTM_TIMER_A); }
+void WTIMER4B_Handler(void) { GPTM_Handler(GPTM_WTIMER4, GPTM_TIMER_B); }
+
+/**
+ * @brief Handles the Wide Timer 5A interrupt with the exception frame of the interrupted code.
+ *
+ * @param frame Pointer to the exception frame that was stacked on entry of the interrupt.
+ *
+ * @return None
+ */
+__attribute__((used)) static void GPTM_WTIMER5A_Frame_Dispatch(const uint32_t *frame)
+{
+	if (GPTM_Frame_Handler != 0)
+	{
+		(*GPTM_Frame_Handler)(frame);
+		return;
+	}
+
+	GPTM_Handler(GPTM_WTIMER5, GPTM_TIMER_A);
+}
+
+__attribute__((naked)) void WTIMER5A_Handler(void)
+{
+	// Select the stack that holds the exception frame (Bit 2 of EXC_RETURN) and pass it to the dispatcher
+	__asm volatile
+	(
+		"tst lr, #4\n"
+		"ite eq\n"
+		"mrseq r0, msp\n"
+		"mrsne r0, psp\n"
+		"b GPTM_WTIMER5A_Frame_Dispatch\n"
+	);
+}
+void WTIMER5B_Handler(void) { GPTM_Handler(GPTM_WTIMER5, GPTM_TIMER_B); }
@@ -0,0 +1,339 @@
+/**
+ * @file GPTM.h
+ *
+ * @brief Header file for the GPTM driver.
+ *
+ * This file contains the function definitions for the GPTM driver.
+ * It configures any of the general-purpose timer modules from one constant instance table:
+ *	- 16/32-bit timers: Timer 0 to Timer 5
+ *	- 32/64-bit wide timers: Wide Timer 0 to Wide Timer 5
+ *
+ * The following modes are supported:
+ *	- Concatenated periodic and one-shot: Timer A and Timer B form one 32-bit (or 64-bit) timer.
+ *	- Split periodic: Timer A or Timer B is used as a 16-bit (or 32-bit) timer with a prescaler.
+ *	- PWM: Timer A or Timer B generates a PWM signal on its CCP pin.
+ *	- Edge-count: Timer A or Timer B counts the edges on its CCP pin.
+ *	- Edge-time: Timer A or Timer B captures the time of every edge on its CCP pin.
+ *
+ * In the split modes of the 16/32-bit timers, the prescaler extends the counter to 24 bits
+ * for PWM, edge-count and edge-time. Each half has its own callback, which is executed from
+ * the half's interrupt after the interrupt has been cleared.
+ *
+ * Timers are configured while disabled and can then be started together with GPTM_Sync_Start.
+ * It enables every configured half of the selected timers and then writes the GPTMSYNC register
+ * of Timer 0, which reloads all selected counters in the same clock cycle. The phase relationship
+ * between the timers is therefore fixed by their periods alone and does not depend on the order
+ * of the enable writes. It can be verified in the simulator by halting after GPTM_Sync_Start and
+ * comparing the GPTMTAV registers of the synchronized timers.
+ *
+ * The Wide Timer 5A handler is entered without a prologue and passes the exception frame of the
+ * interrupted code to an optional frame handler, which is used by the sampling profiler.
+ *
+ * @note The CCP pins used by the PWM, edge-count and edge-time modes must be configured by the user
+ * (AFSEL set, PCTL = 0x7, DEN set).
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef GPTM_H
+#define GPTM_H
+
+#include "TM4C123GH6PM.h"
+#include "Clock_Gating.h"
+
+typedef enum
+{
+	GPTM_TIMER0 = 0,
+	GPTM_TIMER1,
+	GPTM_TIMER2,
+	GPTM_TIMER3,
+	GPTM_TIMER4,
+	GPTM_TIMER5,
+	GPTM_WTIMER0,
+	GPTM_WTIMER1,
+	GPTM_WTIMER2,
+	GPTM_WTIMER3,
+	GPTM_WTIMER4,
+	GPTM_WTIMER5,
+	GPTM_INSTANCE_COUNT
+} GPTM_Instance;
+
+typedef enum
+{
+	GPTM_TIMER_A = 0,
+	GPTM_TIMER_B = 1
+} GPTM_Half;
+
+// Edges that are counted or captured on a CCP pin (TnEVENT field)
+#define GPTM_EDGE_RISING				0x0
+#define GPTM_EDGE_FALLING				0x1
+#define GPTM_EDGE_BOTH					0x3
+
+// Converts an instance into its bit for GPTM_Sync_Start
+#define GPTM_MASK(instance)			(1UL << (instance))
+
+/**
+ * @brief Configures a timer as a concatenated periodic timer without starting it.
+ *
+ * The timer counts down at the system clock frequency from (period - 1) to zero.
+ * If a task is provided, it is executed from the Timer A interrupt on every time-out.
+ *
+ * @param instance The timer to be configured.
+ *
+ * @param period The period in system clock cycles.
+ *
+ * @param task A pointer to the user-defined function to be executed on every time-out, or NULL.
+ *
+ * @param priority The interrupt priority level (0 to 7) used if a task is provided.
+ *
+ * @return None
+ */
+void GPTM_Init_Periodic(GPTM_Instance instance, uint32_t period, void(*task)(void), uint8_t priority);
+
+/**
+ * @brief Configures a timer as a concatenated one-shot timer without starting it.
+ *
+ * @param instance The timer to be configured.
+ *
+ * @param period The time until the time-out in system clock cycles.
+ *
+ * @param task A pointer to the user-defined function to be executed on the time-out, or NULL.
+ *
+ * @param priority The interrupt priority level (0 to 7) used if a task is provided.
+ *
+ * @return None
+ */
+void GPTM_Init_One_Shot(GPTM_Instance instance, uint32_t period, void(*task)(void), uint8_t priority);
+
+/**
+ * @brief Configures one half of a timer as a periodic timer with a prescaler without starting it.
+ *
+ * The half counts down from (interval - 1) to zero at (system clock / prescale).
+ * A new interval set with GPTM_Set_Interval is loaded at the next time-out, so the
+ * period that is currently being counted is never disturbed.
+ *
+ * @param instance The timer to be configured.
+ *
+ * @param half GPTM_TIMER_A or GPTM_TIMER_B.
+ *
+ * @param prescale The divider of the system clock (1 to 256 for 16/32-bit timers, 1 to 65536 for wide timers).
+ *
+ * @param interval The period in prescaled clock cycles (up to 65536 for 16/32-bit timers).
+ *
+ * @param task A pointer to the user-defined function to be executed on every time-out, or NULL.
+ *
+ * @param priority The interrupt priority level (0 to 7) used if a task is provided.
+ *
+ * @return None
+ */
+void GPTM_Init_Split_Periodic(GPTM_Instance instance, GPTM_Half half, uint32_t prescale, uint32_t interval, void(*task)(void), uint8_t priority);
+
+/**
+ * @brief Configures one half of a timer as a PWM generator without starting it.
+ *
+ * The output is high for the number of cycles set with GPTM_Set_PWM_Duty and low for the rest of
+ * the period (or the opposite if it is inverted). The duty cycle starts at 0%. A new duty cycle is
+ * applied at the end of the current period.
+ *
+ * @param instance The timer to be configured.
+ *
+ * @param half GPTM_TIMER_A or GPTM_TIMER_B.
+ *
+ * @param period The PWM period in system clock cycles (up to 2^24 for 16/32-bit timers).
+ *
+ * @param inverted 0x01 to invert the output, 0x00 otherwise.
+ *
+ * @return None
+ */
+void GPTM_Init_PWM(GPTM_Instance instance, GPTM_Half half, uint32_t period, uint8_t inverted);
+
+/**
+ * @brief Sets the duty cycle of a PWM generator.
+ *
+ * @param instance The timer of the PWM generator.
+ *
+ * @param half GPTM_TIMER_A or GPTM_TIMER_B.
+ *
+ * @param high_cycles The number of system clock cycles per period that the output is high (0 to period).
+ *
+ * @return None
+ */
+void GPTM_Set_PWM_Duty(GPTM_Instance instance, GPTM_Half half, uint32_t high_cycles);
+
+/**
+ * @brief Configures one half of a timer to count the edges on its CCP pin without starting it.
+ *
+ * The half counts up from zero. When the count reaches the match value, the task is executed
+ * and the half stops until it is enabled again.
+ *
+ * @param instance The timer to be configured.
+ *
+ * @param half GPTM_TIMER_A or GPTM_TIMER_B.
+ *
+ * @param edge The edges to be counted (GPTM_EDGE_RISING, GPTM_EDGE_FALLING or GPTM_EDGE_BOTH).
+ *
+ * @param match The number of edges after which the task is executed (up to 2^24 - 1 for 16/32-bit timers).
+ *
+ * @param task A pointer to the user-defined function to be executed when the match is reached, or NULL.
+ *
+ * @param priority The interrupt priority level (0 to 7) used if a task is provided.
+ *
+ * @return None
+ */
+void GPTM_Init_Edge_Count(GPTM_Instance instance, GPTM_Half half, uint8_t edge, uint32_t match, void(*task)(void), uint8_t priority);
+
+/**
+ * @brief Configures one half of a timer to capture the time of the edges on its CCP pin without starting it.
+ *
+ * The half counts up at the system clock frequency and wraps after 2^24 cycles (16/32-bit timers)
+ * or 2^32 cycles (wide timers). The counter value at every edge is passed to the task.
+ *
+ * @param instance The timer to be configured.
+ *
+ * @param half GPTM_TIMER_A or GPTM_TIMER_B.
+ *
+ * @param edge The edges to be captured (GPTM_EDGE_RISING, GPTM_EDGE_FALLING or GPTM_EDGE_BOTH).
+ *
+ * @param task A pointer to the user-defined function that receives the captured counter value.
+ *
+ * @param priority The interrupt priority level (0 to 7).
+ *
+ * @return None
+ */
+void GPTM_Init_Edge_Time(GPTM_Instance instance, GPTM_Half half, uint8_t edge, void(*task)(uint32_t capture), uint8_t priority);
+
+/**
+ * @brief Lets Timer A of a timer trigger the ADC on every time-out.
+ *
+ * @param instance The timer that triggers the ADC.
+ *
+ * @return None
+ */
+void GPTM_Enable_ADC_Trigger(GPTM_Instance instance);
+
+/**
+ * @brief Starts one half of a timer (GPTM_TIMER_A for the concatenated modes).
+ *
+ * @param instance The timer to be started.
+ *
+ * @param half GPTM_TIMER_A or GPTM_TIMER_B.
+ *
+ * @return None
+ */
+void GPTM_Enable(GPTM_Instance instance, GPTM_Half half);
+
+/**
+ * @brief Stops one half of a timer (GPTM_TIMER_A for the concatenated modes).
+ *
+ * @param instance The timer to be stopped.
+ *
+ * @param half GPTM_TIMER_A or GPTM_TIMER_B.
+ *
+ * @return None
+ */
+void GPTM_Disable(GPTM_Instance instance, GPTM_Half half);
+
+/**
+ * @brief Starts several timers in the same clock cycle.
+ *
+ * Every configured half of the selected timers is enabled and then reloaded at once through
+ * the GPTMSYNC register. The time-out caused by the synchronization itself is discarded.
+ *
+ * @param instance_mask The timers to be started, combined with GPTM_MASK.
+ *
+ * @return None
+ */
+void GPTM_Sync_Start(uint32_t instance_mask);
+
+/**
+ * @brief Stops both halves of a timer and releases its clock.
+ *
+ * The clock of the timer is gated if no other driver holds a reference to it.
+ * The timer must be configured again before it can be used.
+ *
+ * @param instance The timer to be released.
+ *
+ * @return None
+ */
+void GPTM_Deinit(GPTM_Instance instance);
+
+/**
+ * @brief Installs a raw handler for the interrupt of one half of a timer.
+ *
+ * The raw handler is executed from the interrupt instead of the GPTM callbacks and must clear
+ * the interrupts of the half itself. It is used by drivers whose interrupt is not raised by a
+ * GPTM event, such as the completion of a uDMA transfer that is triggered by the timer.
+ * The raw handler remains installed until it is replaced or the timer is released with GPTM_Deinit.
+ *
+ * @param instance The timer whose interrupt is handled.
+ *
+ * @param half GPTM_TIMER_A or GPTM_TIMER_B.
+ *
+ * @param handler A pointer to the raw handler, or NULL to restore the GPTM callbacks.
+ *
+ * @return None
+ */
+void GPTM_Set_Raw_Handler(GPTM_Instance instance, GPTM_Half half, void(*handler)(void));
+
+/**
+ * @brief Installs a handler that receives the exception frame of the Wide Timer 5A interrupt.
+ *
+ * The frame handler is executed from the interrupt instead of the GPTM callbacks and must clear
+ * the interrupts of Wide Timer 5A itself. The stacked PC is the seventh word of the frame, with
+ * or without the floating-point registers. The frame handler remains installed until it is
+ * replaced or Wide Timer 5 is released with GPTM_Deinit.
+ *
+ * @param handler A pointer to the frame handler, or NULL to restore the GPTM callbacks.
+ *
+ * @return None
+ */
+void GPTM_Set_WTIMER5A_Frame_Handler(void(*handler)(const uint32_t *frame));
+
+/**
+ * @brief Sets the interval of a split periodic half.
+ *
+ * @param instance The timer to be changed.
+ *
+ * @param half GPTM_TIMER_A or GPTM_TIMER_B.
+ *
+ * @param interval The new period in prescaled clock cycles. It is loaded at the next time-out.
+ *
+ * @return None
+ */
+void GPTM_Set_Interval(GPTM_Instance instance, GPTM_Half half, uint32_t interval);
+
+/**
+ * @brief Returns the interval of a split periodic half.
+ *
+ * @param instance The timer to be read.
+ *
+ * @param half GPTM_TIMER_A or GPTM_TIMER_B.
+ *
+ * @return The interval in prescaled clock cycles that is loaded at the next time-out.
+ */
+uint32_t GPTM_Get_Interval(GPTM_Instance instance, GPTM_Half half);
+
+/**
+ * @brief Returns the current counter value of one half of a timer.
+ *
+ * @param instance The timer to be read.
+ *
+ * @param half GPTM_TIMER_A or GPTM_TIMER_B.
+ *
+ * @return The value of the GPTMTnV register. In the split modes of the 16/32-bit timers,
+ *         Bits 23 to 16 hold the prescaler.
+ */
+uint32_t GPTM_Get_Count(GPTM_Instance instance, GPTM_Half half);
+
+/**
+ * @brief Checks if a time-out of one half of a timer has not been handled yet.
+ *
+ * @param instance The timer to be checked.
+ *
+ * @param half GPTM_TIMER_A or GPTM_TIMER_B.
+ *
+ * @return 0x01 if the time-out flag is set, 0x00 otherwise.
+ */
+uint8_t GPTM_Timeout_Pending(GPTM_Instance instance, GPTM_Half half);
+
+#endif
@@ -0,0 +1,112 @@
+/**
+ * @file Hibernation_RTC.c
+ *
+ * @brief Source code for the Hibernation_RTC driver.
+ *
+ * This file contains the function definitions for the Hibernation_RTC driver.
+ * It uses the real-time clock (RTC) of the Hibernation module to provide the time of day.
+ *
+ * The RTC is clocked by the 32.768 kHz crystal connected to XOSC0 and XOSC1, so it keeps
+ * running independently of the system clock, including deep sleep and hibernation.
+ * The time is read on demand from the RTC counter (seconds) and the RTC sub-seconds counter
+ * (1 / 32768 s), so no periodic RTC interrupt is needed and the core is never woken up to
+ * keep the time.
+ *
+ * @note Writes to the Hibernation module registers take up to three 32.768 kHz clock periods.
+ * The driver waits for the WRC bit of the HIBCTL register before every write.
+ *
+ * @author Katherine Poz
+ */
+
+#include "Hibernation_RTC.h"
+
+/**
+ * @brief Waits until the Hibernation module can accept a register write.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Hibernation_RTC_Wait_Write_Complete(void)
+{
+	// Wait until the WRC bit (Bit 31) of the HIBCTL register is set
+	while ((HIB->CTL & 0x80000000) == 0);
+}
+
+void Hibernation_RTC_Init(void)
+{
+	// Acquire the clock to the registers of the Hibernation module and wait until they are ready to be accessed
+	// The RTC itself runs from the hibernation oscillator, so the clock is only needed in run mode
+	Clock_Gating_Acquire(CLOCK_GATING_HIB, 0x01, CLOCK_GATING_RUN);
+
+	// Keep the time if the RTC is already running (RTCEN, Bit 0)
+	if (HIB->CTL & 0x01)
+	{
+		return;
+	}
+
+	// Enable the 32.768 kHz oscillator by setting the CLK32EN bit (Bit 6) in the HIBCTL register
+	Hibernation_RTC_Wait_Write_Complete();
+	HIB->CTL |= 0x40;
+
+	// Start the RTC at zero
+	Hibernation_RTC_Wait_Write_Complete();
+	HIB->RTCLD = 0;
+
+	// Enable the RTC by setting the RTCEN bit (Bit 0) in the HIBCTL register
+	Hibernation_RTC_Wait_Write_Complete();
+	HIB->CTL |= 0x01;
+
+	Hibernation_RTC_Wait_Write_Complete();
+}
+
+void Hibernation_RTC_Set(uint32_t seconds)
+{
+	// Loading the HIBRTCLD register loads the RTC counter and clears the sub-seconds counter
+	Hibernation_RTC_Wait_Write_Complete();
+	HIB->RTCLD = seconds;
+	Hibernation_RTC_Wait_Write_Complete();
+}
+
+void Hibernation_RTC_Deinit(void)
+{
+	// Complete the last write before the clock to the registers is gated
+	Hibernation_RTC_Wait_Write_Complete();
+
+	// Release the reference to the clock of the registers. The RTC keeps running from the hibernation oscillator.
+	Clock_Gating_Release(CLOCK_GATING_HIB, 0x01, CLOCK_GATING_RUN);
+}
+
+Hibernation_RTC_Time Hibernation_RTC_Get(void)
+{
+	Hibernation_RTC_Time time;
+	uint32_t seconds;
+
+	// Read the counters again if the seconds counter has changed in between
+	do
+	{
+		seconds = HIB->RTCC;
+
+		// The RTCSSC field (Bits 14 to 0) of the HIBRTCSS register holds the sub-seconds count
+		time.subseconds = (uint16_t)(HIB->RTCSS & 0x7FFF);
+		time.seconds = HIB->RTCC;
+	}
+	while (seconds != time.seconds);
+
+	return time;
+}
+
+Hibernation_RTC_Time_Of_Day Hibernation_RTC_Get_Time_Of_Day(Hibernation_RTC_Time time)
+{
+	Hibernation_RTC_Time_Of_Day time_of_day;
+	uint32_t seconds_of_day = time.seconds % HIBERNATION_RTC_SECONDS_PER_DAY;
+
+	time_of_day.hours = (uint8_t)(seconds_of_day / 3600);
+	time_of_day.minutes = (uint8_t)((seconds_of_day / 60) % 60);
+	time_of_day.seconds = (uint8_t)(seconds_of_day % 60);
+
+	// Convert the 1 / 32768 s sub-seconds count into milliseconds
+	time_of_day.milliseconds = (uint16_t)(((uint32_t)time.subseconds * 1000) / HIBERNATION_RTC_SUBSECONDS);
+
+	return time_of_day;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file Hibernation_RTC.h
+ *
+ * @brief Header file for the Hibernation_RTC driver.
+ *
+ * This file contains the function definitions for the Hibernation_RTC driver.
+ * It uses the real-time clock (RTC) of the Hibernation module to provide the time of day.
+ *
+ * The RTC is clocked by the 32.768 kHz crystal connected to XOSC0 and XOSC1, so it keeps
+ * running independently of the system clock, including deep sleep and hibernation.
+ * The time is read on demand from the RTC counter (seconds) and the RTC sub-seconds counter
+ * (1 / 32768 s), so no periodic RTC interrupt is needed and the core is never woken up to
+ * keep the time.
+ *
+ * @note Writes to the Hibernation module registers take up to three 32.768 kHz clock periods.
+ * The driver waits for the WRC bit of the HIBCTL register before every write.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef HIBERNATION_RTC_H
+#define HIBERNATION_RTC_H
+
+#include "TM4C123GH6PM.h"
+#include "Clock_Gating.h"
+
+// Number of RTC sub-second counts per second
+#define HIBERNATION_RTC_SUBSECONDS		32768
+
+// Number of seconds in a day
+#define HIBERNATION_RTC_SECONDS_PER_DAY	86400
+
+typedef struct
+{
+	uint32_t seconds;			// Value of the RTC counter
+	uint16_t subseconds;		// Value of the RTC sub-seconds counter (0 to 32767)
+} Hibernation_RTC_Time;
+
+typedef struct
+{
+	uint8_t hours;
+	uint8_t minutes;
+	uint8_t seconds;
+	uint16_t milliseconds;
+} Hibernation_RTC_Time_Of_Day;
+
+/**
+ * @brief Initializes the Hibernation module and starts the RTC.
+ *
+ * This function enables the clock to the Hibernation module, enables the 32.768 kHz oscillator
+ * and starts the RTC. If the RTC is already running (for example, after waking up from hibernation
+ * or after a reset of the core), the current time is kept.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Hibernation_RTC_Init(void);
+
+/**
+ * @brief Releases the clock to the registers of the Hibernation module.
+ *
+ * The RTC keeps counting, since it runs from the hibernation oscillator, but the registers cannot be
+ * accessed until Hibernation_RTC_Init is called again. The clock is gated if no other driver holds
+ * a reference to it.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Hibernation_RTC_Deinit(void);
+
+/**
+ * @brief Sets the RTC to a number of seconds.
+ *
+ * The sub-seconds counter is cleared when the RTC counter is loaded.
+ *
+ * @param seconds The new value of the RTC counter (for example, seconds since midnight or since an epoch).
+ *
+ * @return None
+ */
+void Hibernation_RTC_Set(uint32_t seconds);
+
+/**
+ * @brief Reads the RTC counter and the RTC sub-seconds counter consistently.
+ *
+ * @param None
+ *
+ * @return The current time of the RTC.
+ */
+Hibernation_RTC_Time Hibernation_RTC_Get(void);
+
+/**
+ * @brief Converts an RTC time into the time of day.
+ *
+ * @param time The RTC time to be converted.
+ *
+ * @return The time of day with millisecond resolution.
+ */
+Hibernation_RTC_Time_Of_Day Hibernation_RTC_Get_Time_Of_Day(Hibernation_RTC_Time time);
+
+#endif
@@ -0,0 +1,63 @@
+/**
+ * @file TM4C123GH6PM.h
+ *
+ * @brief Host stand-in for the device header of the TM4C123GH6PM.
+ *
+ * The host tests compile the drivers with gcc on the development machine. This header is found
+ * before the device header of the Keil pack and provides the types, the intrinsics and the register
+ * blocks used by the drivers under test. The interrupt intrinsics do nothing, and each register block
+ * is a variable in host memory. The ADC0 block is only written by configuration code that is not
+ * exercised by the tests. The uDMA block is defined by Test_UDMA.c, which checks the register writes
+ * of the driver. Registers that are cleared by writing 1 on the device simply hold the written value.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef HOST_TM4C123GH6PM_H
+#define HOST_TM4C123GH6PM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define __IO volatile
+#define __I volatile const
+#define __O volatile
+
+typedef enum
+{
+	ADC0SS3_IRQn = 17,
+	TIMER0A_IRQn = 19,
+	UDMA_IRQn = 46,
+	UDMAERR_IRQn = 47,
+	UART5_IRQn = 61
+} IRQn_Type;
+
+static inline void NVIC_SetPriority(IRQn_Type irq, uint32_t priority) { (void)irq; (void)priority; }
+static inline void NVIC_EnableIRQ(IRQn_Type irq) { (void)irq; }
+static inline void NVIC_DisableIRQ(IRQn_Type irq) { (void)irq; }
+
+static inline uint32_t __get_PRIMASK(void) { return 0; }
+static inline void __set_PRIMASK(uint32_t primask) { (void)primask; }
+static inline void __disable_irq(void) {}
+static inline void __enable_irq(void) {}
+
+typedef struct
+{
+	__IO uint32_t ACTSS, RIS, IM, ISC, OSTAT, EMUX, USTAT, TSSEL, SSPRI, SPC, PSSI, R0, SAC, DCISC, CTL, R1;
+	__IO uint32_t SSMUX3, SSCTL3, SSFIFO3, SSFSTAT3, SSOP3, SSDC3;
+} ADC0_Type;
+
+static ADC0_Type host_adc0 __attribute__((unused));
+#define ADC0								(&host_adc0)
+
+typedef struct
+{
+	__IO uint32_t STAT, CFG, CTLBASE, ALTBASE, WAITSTAT, SWREQ, USEBURSTSET, USEBURSTCLR, REQMASKSET, REQMASKCLR;
+	__IO uint32_t ENASET, ENACLR, ALTSET, ALTCLR, PRIOSET, PRIOCLR, ERRCLR, CHASGN, CHIS;
+	__IO uint32_t CHMAP0, CHMAP1, CHMAP2, CHMAP3;
+} UDMA_Type;
+
+extern UDMA_Type host_udma;
+#define UDMA								(&host_udma)
+
+#endif
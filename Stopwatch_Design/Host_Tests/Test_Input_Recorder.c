@@ -0,0 +1,284 @@
+/**
+ * @file Test_Input_Recorder.c
+ *
+ * @brief Host test that a replay of the Input_Recorder driver repeats the recorded events exactly.
+ *
+ * The test drives the recorder like the program does: every Timer 0A tick advances a fake time
+ * base by 1 ms and ends with Input_Recorder_Tick, and button presses arrive between two ticks
+ * through the input tasks of the recorder. The tasks of the program are replaced by functions that
+ * log every dispatched event as (source, data, tick, time since the start). The time of a live
+ * event is its timestamp, and the time of a replayed event is Input_Recorder_Get_Replay_Time_us,
+ * as in Get_Button_Time_us of main.c. The log of the replay must be identical to the log of the
+ * recording.
+ *
+ * @author Katherine Poz
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Input_Recorder.h"
+
+static int failures = 0;
+
+#define CHECK_EQUAL(actual, expected) Check_Equal((int64_t)(actual), (int64_t)(expected), #actual, __LINE__)
+
+static void Check_Equal(int64_t actual, int64_t expected, const char *expression, int line)
+{
+	if (actual != expected)
+	{
+		printf("line %d: %s = %lld, expected %lld\n", line, expression, (long long)actual, (long long)expected);
+		failures++;
+	}
+}
+
+// EduBase button that controls the recorder, as in main.c
+#define TEST_CONTROL_MASK			0x03
+
+// Fake time base and PMOD BTN timestamp
+static uint64_t time_base_now_us = 0;
+static uint64_t pmod_btn_timestamp_us = 0;
+
+uint64_t Time_Base_Get_Time_us(void) { return time_base_now_us; }
+uint64_t PMOD_BTN_Get_Timestamp_us(void) { return pmod_btn_timestamp_us; }
+
+// Dispatched event as seen by the program
+typedef struct
+{
+	uint8_t source;
+	uint8_t data;
+	uint32_t tick;
+	uint64_t time_us;
+} Dispatched_Event;
+
+#define LOG_SIZE					32
+
+static Dispatched_Event event_log[LOG_SIZE];
+static uint16_t log_count = 0;
+
+// Ticks and time base value since the last reset of the program state
+static uint32_t program_ticks = 0;
+static uint64_t program_start_us = 0;
+static uint32_t resets = 0;
+static uint32_t control_presses = 0;
+
+static void Log_Event(uint8_t source, uint8_t data, uint64_t time_us)
+{
+	if (log_count < LOG_SIZE)
+	{
+		event_log[log_count].source = source;
+		event_log[log_count].data = data;
+		event_log[log_count].tick = program_ticks;
+		event_log[log_count].time_us = time_us - program_start_us;
+	}
+	log_count++;
+}
+
+static uint64_t Button_Time_us(uint64_t live_time_us)
+{
+	if (Input_Recorder_Get_State() == INPUT_RECORDER_REPLAYING)
+	{
+		return Input_Recorder_Get_Replay_Time_us();
+	}
+
+	return live_time_us;
+}
+
+static void Test_PMOD_BTN_Task(uint8_t pmod_btn_status)
+{
+	Log_Event(INPUT_RECORDER_PMOD_BTN, pmod_btn_status, Button_Time_us(pmod_btn_timestamp_us));
+}
+
+static void Test_EduBase_Button_Task(uint8_t edubase_button_status)
+{
+	if ((edubase_button_status & TEST_CONTROL_MASK) != 0)
+	{
+		control_presses++;
+		return;
+	}
+
+	Log_Event(INPUT_RECORDER_EDUBASE_BUTTON, edubase_button_status, Button_Time_us(time_base_now_us));
+}
+
+static void Test_Reset_Task(void)
+{
+	log_count = 0;
+	program_ticks = 0;
+	program_start_us = time_base_now_us;
+	resets++;
+}
+
+// One Timer 0A interrupt
+static void Tick(void)
+{
+	time_base_now_us += 1000;
+	program_ticks++;
+	Input_Recorder_Tick();
+}
+
+// Button presses between two ticks, given as the tick before the press and the microseconds after it
+typedef struct
+{
+	uint32_t tick;
+	uint32_t offset_us;
+	uint8_t source;
+	uint8_t data;
+} Test_Press;
+
+static const Test_Press test_presses[] =
+{
+	{  0,   5, INPUT_RECORDER_PMOD_BTN,       0x04 },	// Before the first tick
+	{  0, 740, INPUT_RECORDER_EDUBASE_BUTTON, 0x08 },
+	{  3, 250, INPUT_RECORDER_PMOD_BTN,       0x20 },
+	{  3, 251, INPUT_RECORDER_PMOD_BTN,       0x20 },	// Two presses within the same tick
+	{  9, 999, INPUT_RECORDER_PMOD_BTN,       0x08 },
+	{ 10,   0, INPUT_RECORDER_EDUBASE_BUTTON, 0x04 },
+	{ 42, 500, INPUT_RECORDER_PMOD_BTN,       0x10 }
+};
+
+#define TEST_PRESS_COUNT			(sizeof(test_presses) / sizeof(test_presses[0]))
+#define TEST_TICKS					50
+
+static void Press(const Test_Press *press, uint64_t tick_start_us)
+{
+	time_base_now_us = tick_start_us + press->offset_us;
+
+	if (press->source == INPUT_RECORDER_PMOD_BTN)
+	{
+		pmod_btn_timestamp_us = time_base_now_us;
+		Input_Recorder_PMOD_BTN_Input(press->data);
+	}
+	else
+	{
+		Input_Recorder_EduBase_Button_Input(press->data);
+	}
+
+	time_base_now_us = tick_start_us;
+}
+
+// Runs TEST_TICKS ticks and presses the test buttons if live_presses is 0x01
+static void Run(uint8_t live_presses)
+{
+	uint8_t next = 0;
+
+	for (uint32_t tick = 0; tick <= TEST_TICKS; tick++)
+	{
+		uint64_t tick_start_us = time_base_now_us;
+
+		while ((live_presses == 0x01) && (next < TEST_PRESS_COUNT) && (test_presses[next].tick == tick))
+		{
+			Press(&test_presses[next], tick_start_us);
+			next++;
+		}
+
+		if (tick < TEST_TICKS)
+		{
+			Tick();
+		}
+	}
+}
+
+// Compares the dispatched events with an earlier log
+static void Check_Log(const Dispatched_Event *expected, uint16_t expected_count)
+{
+	CHECK_EQUAL(log_count, expected_count);
+
+	for (uint8_t i = 0; (i < expected_count) && (i < log_count); i++)
+	{
+		CHECK_EQUAL(event_log[i].source, expected[i].source);
+		CHECK_EQUAL(event_log[i].data, expected[i].data);
+		CHECK_EQUAL(event_log[i].tick, expected[i].tick);
+		CHECK_EQUAL(event_log[i].time_us, expected[i].time_us);
+	}
+}
+
+static void Test_Replay_Is_Identical(void)
+{
+	Dispatched_Event recorded_log[LOG_SIZE];
+	uint16_t recorded_count;
+
+	Input_Recorder_Init(&Test_PMOD_BTN_Task, &Test_EduBase_Button_Task, TEST_CONTROL_MASK, &Test_Reset_Task);
+
+	// Record the presses, starting at an arbitrary time base value in the middle of a tick
+	time_base_now_us = 123456789;
+	Input_Recorder_Start_Recording();
+	CHECK_EQUAL(resets, 1);
+	Run(0x01);
+	Input_Recorder_Stop();
+
+	CHECK_EQUAL(log_count, TEST_PRESS_COUNT);
+	CHECK_EQUAL(Input_Recorder_Overflowed(), 0x00);
+
+	// The live log holds the presses as they were made
+	for (uint8_t i = 0; i < TEST_PRESS_COUNT; i++)
+	{
+		CHECK_EQUAL(event_log[i].source, test_presses[i].source);
+		CHECK_EQUAL(event_log[i].data, test_presses[i].data);
+		CHECK_EQUAL(event_log[i].tick, test_presses[i].tick);
+		CHECK_EQUAL(event_log[i].time_us, (test_presses[i].tick * 1000) + test_presses[i].offset_us);
+	}
+
+	memcpy(recorded_log, event_log, sizeof(recorded_log));
+	recorded_count = log_count;
+
+	// Replay at a later time base value, which is not aligned with the recording
+	time_base_now_us = 987654321;
+	Input_Recorder_Start_Replay();
+	CHECK_EQUAL(resets, 2);
+	CHECK_EQUAL(Input_Recorder_Get_State(), INPUT_RECORDER_REPLAYING);
+
+	// Live presses during the replay are discarded, except for the recorder controls
+	uint64_t tick_start_us = time_base_now_us;
+	pmod_btn_timestamp_us = time_base_now_us;
+	Input_Recorder_PMOD_BTN_Input(0x08);
+	Input_Recorder_EduBase_Button_Input(0x02);
+	CHECK_EQUAL(control_presses, 1);
+	time_base_now_us = tick_start_us;
+
+	Run(0x00);
+
+	CHECK_EQUAL(Input_Recorder_Get_State(), INPUT_RECORDER_IDLE);
+	Check_Log(recorded_log, recorded_count);
+}
+
+static void Test_Load_Replays_Saved_Events(void)
+{
+	const Input_Event *events;
+	Input_Event saved[INPUT_RECORDER_SIZE];
+	Dispatched_Event replayed_log[LOG_SIZE];
+
+	// Replay the recording once and keep its log
+	uint16_t count = Input_Recorder_Get_Events(&events);
+	CHECK_EQUAL(count, TEST_PRESS_COUNT);
+	memcpy(saved, events, count * sizeof(Input_Event));
+
+	Input_Recorder_Start_Replay();
+	Run(0x00);
+	memcpy(replayed_log, event_log, sizeof(replayed_log));
+	uint16_t replayed_count = log_count;
+
+	// Loading the saved events on another board gives the same replay
+	Input_Recorder_Init(&Test_PMOD_BTN_Task, &Test_EduBase_Button_Task, TEST_CONTROL_MASK, &Test_Reset_Task);
+	CHECK_EQUAL(Input_Recorder_Load(saved, count), 0x01);
+
+	time_base_now_us = 5000;
+	Input_Recorder_Start_Replay();
+	Run(0x00);
+
+	Check_Log(replayed_log, replayed_count);
+
+	// Events cannot be loaded while a replay is running
+	Input_Recorder_Start_Replay();
+	CHECK_EQUAL(Input_Recorder_Load(saved, count), 0x00);
+	Input_Recorder_Stop();
+}
+
+int main(void)
+{
+	Test_Replay_Is_Identical();
+	Test_Load_Replays_Saved_Events();
+
+	printf("Test_Input_Recorder: %s\n", (failures == 0) ? "passed" : "FAILED");
+
+	return (failures == 0) ? 0 : 1;
+}
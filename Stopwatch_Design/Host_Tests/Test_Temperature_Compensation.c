@@ -0,0 +1,114 @@
+/**
+ * @file Test_Temperature_Compensation.c
+ *
+ * @brief Host test of the conversion and the curve lookup of the Temperature_Compensation driver.
+ *
+ * The peripheral functions that are called by Temperature_Compensation_Init are replaced by
+ * empty functions, since only the calculations are tested.
+ *
+ * @author Katherine Poz
+ */
+
+#include <stdio.h>
+
+#include "Temperature_Compensation.h"
+
+static int failures = 0;
+
+#define CHECK_EQUAL(actual, expected) Check_Equal((int64_t)(actual), (int64_t)(expected), #actual, __LINE__)
+
+static void Check_Equal(int64_t actual, int64_t expected, const char *expression, int line)
+{
+	if (actual != expected)
+	{
+		printf("line %d: %s = %lld, expected %lld\n", line, expression, (long long)actual, (long long)expected);
+		failures++;
+	}
+}
+
+void Clock_Gating_Acquire(Clock_Gating_Peripheral peripheral, uint8_t instance_mask, uint8_t modes) {}
+void Clock_Gating_Release(Clock_Gating_Peripheral peripheral, uint8_t instance_mask, uint8_t modes) {}
+void GPTM_Init_Periodic(GPTM_Instance instance, uint32_t period, void(*task)(void), uint8_t priority) {}
+void GPTM_Enable_ADC_Trigger(GPTM_Instance instance) {}
+void GPTM_Enable(GPTM_Instance instance, GPTM_Half half) {}
+void GPTM_Deinit(GPTM_Instance instance) {}
+void Time_Base_Set_Temperature_Trim(int32_t trim_ppb) {}
+
+static const Temperature_Compensation_Point test_curve[] =
+{
+	{ -1000,  12000 },
+	{     0,   4000 },
+	{  2500,      0 },
+	{  5000,  -3500 },
+	{  8500, -15000 }
+};
+
+#define TEST_CURVE_POINTS		(sizeof(test_curve) / sizeof(test_curve[0]))
+
+static void Test_Convert(void)
+{
+	// TEMP = 147.5 - ((75 * 3.3 * ADCCODE) / 4096)
+	CHECK_EQUAL(Temperature_Compensation_Convert(0), 14750);
+	CHECK_EQUAL(Temperature_Compensation_Convert(2048), 2375);
+	CHECK_EQUAL(Temperature_Compensation_Convert(4095), -9993);
+
+	// Room temperature (25 degrees Celsius) is close to code 2027
+	CHECK_EQUAL(Temperature_Compensation_Convert(2027), 2502);
+}
+
+static void Test_Lookup_Exact_Points(void)
+{
+	for (uint8_t i = 0; i < TEST_CURVE_POINTS; i++)
+	{
+		CHECK_EQUAL(Temperature_Compensation_Lookup(test_curve, TEST_CURVE_POINTS, test_curve[i].temperature_centi_c), test_curve[i].frequency_error_ppb);
+	}
+}
+
+static void Test_Lookup_Interpolation(void)
+{
+	// Midpoints of the segments
+	CHECK_EQUAL(Temperature_Compensation_Lookup(test_curve, TEST_CURVE_POINTS, -500), 8000);
+	CHECK_EQUAL(Temperature_Compensation_Lookup(test_curve, TEST_CURVE_POINTS, 1250), 2000);
+	CHECK_EQUAL(Temperature_Compensation_Lookup(test_curve, TEST_CURVE_POINTS, 3750), -1750);
+
+	// The division truncates toward zero
+	CHECK_EQUAL(Temperature_Compensation_Lookup(test_curve, TEST_CURVE_POINTS, 6000), -6785);
+
+	// One step away from a point
+	CHECK_EQUAL(Temperature_Compensation_Lookup(test_curve, TEST_CURVE_POINTS, 1), 3999);
+	CHECK_EQUAL(Temperature_Compensation_Lookup(test_curve, TEST_CURVE_POINTS, 8499), -14996);
+}
+
+static void Test_Lookup_Clamping(void)
+{
+	// Below the first point
+	CHECK_EQUAL(Temperature_Compensation_Lookup(test_curve, TEST_CURVE_POINTS, -1001), 12000);
+	CHECK_EQUAL(Temperature_Compensation_Lookup(test_curve, TEST_CURVE_POINTS, -27315), 12000);
+
+	// Above the last point
+	CHECK_EQUAL(Temperature_Compensation_Lookup(test_curve, TEST_CURVE_POINTS, 8501), -15000);
+	CHECK_EQUAL(Temperature_Compensation_Lookup(test_curve, TEST_CURVE_POINTS, 14750), -15000);
+}
+
+static void Test_Lookup_Short_Curves(void)
+{
+	// An empty curve applies no correction
+	CHECK_EQUAL(Temperature_Compensation_Lookup(test_curve, 0, 2500), 0);
+
+	// A single point is held at every temperature
+	CHECK_EQUAL(Temperature_Compensation_Lookup(&test_curve[2], 1, -1000), 0);
+	CHECK_EQUAL(Temperature_Compensation_Lookup(&test_curve[3], 1, 8500), -3500);
+}
+
+int main(void)
+{
+	Test_Convert();
+	Test_Lookup_Exact_Points();
+	Test_Lookup_Interpolation();
+	Test_Lookup_Clamping();
+	Test_Lookup_Short_Curves();
+
+	printf("Test_Temperature_Compensation: %s\n", (failures == 0) ? "passed" : "FAILED");
+
+	return (failures == 0) ? 0 : 1;
+}
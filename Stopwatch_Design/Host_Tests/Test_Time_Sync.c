@@ -0,0 +1,353 @@
+/**
+ * @file Test_Time_Sync.c
+ *
+ * @brief Host test of the offset, step and drift calculations of the Time_Sync driver.
+ *
+ * The test runs complete two-way exchanges on a slave: the SYNC, FOLLOW_UP and DELAY_RESP
+ * frames are passed to the receive task of the driver, and the DELAY_REQ frame is accepted
+ * by a fake UART5 driver with a chosen transmit timestamp (t3). The time base is replaced by
+ * functions that record the step, the phase adjustment and the rate trim.
+ *
+ * @author Katherine Poz
+ */
+
+#include <stdio.h>
+
+#include "Time_Sync.h"
+
+static int failures = 0;
+
+#define CHECK_EQUAL(actual, expected) Check_Equal((int64_t)(actual), (int64_t)(expected), #actual, __LINE__)
+
+static void Check_Equal(int64_t actual, int64_t expected, const char *expression, int line)
+{
+	if (actual != expected)
+	{
+		printf("line %d: %s = %lld, expected %lld\n", line, expression, (long long)actual, (long long)expected);
+		failures++;
+	}
+}
+
+// Board ID of the slave under test
+#define TEST_BOARD_ID				1
+
+// Fake UART5 driver
+static void (*uart5_rx_task)(uint8_t data, uint64_t timestamp_us);
+static uint64_t uart5_tx_timestamp_us = 0;
+static uint8_t uart5_accept = 0x01;
+static uint8_t uart5_last_type = 0;
+static uint32_t uart5_frames = 0;
+
+void UART5_Init(void(*rx_task)(uint8_t data, uint64_t timestamp_us))
+{
+	uart5_rx_task = rx_task;
+}
+
+uint8_t UART5_Send_Frame(const uint8_t *frame, uint8_t length, uint64_t *tx_timestamp_us)
+{
+	if (uart5_accept == 0x00)
+	{
+		return 0x00;
+	}
+
+	if (tx_timestamp_us != NULL)
+	{
+		*tx_timestamp_us = uart5_tx_timestamp_us;
+	}
+
+	uart5_last_type = frame[1];
+	uart5_frames++;
+
+	return 0x01;
+}
+
+// Fake time base
+static uint64_t time_base_now_us = 0;
+static int32_t time_base_rate_trim_ppb = 0;
+static int32_t time_base_step_ticks = 0;
+static int32_t time_base_phase_us = 0;
+
+uint64_t Time_Base_Get_Time_us(void) { return time_base_now_us; }
+int32_t Time_Base_Get_Rate_Trim(void) { return time_base_rate_trim_ppb; }
+void Time_Base_Set_Rate_Trim(int32_t trim_ppb) { time_base_rate_trim_ppb = trim_ppb; }
+void Time_Base_Step_Ticks(int32_t ticks) { time_base_step_ticks += ticks; }
+void Time_Base_Adjust_Phase(int32_t offset_us) { time_base_phase_us += offset_us; }
+
+// Fake RTC
+static uint32_t rtc_seconds = 0;
+static uint32_t rtc_loads = 0;
+
+Hibernation_RTC_Time Hibernation_RTC_Get(void)
+{
+	Hibernation_RTC_Time time = { rtc_seconds, 0 };
+	return time;
+}
+
+void Hibernation_RTC_Set(uint32_t seconds)
+{
+	rtc_seconds = seconds;
+	rtc_loads++;
+}
+
+static uint32_t start_task_calls = 0;
+
+static void Test_Start_Task(void)
+{
+	start_task_calls++;
+}
+
+/**
+ * @brief Passes a frame to the receive task of the driver.
+ *
+ * @param type The message type.
+ *
+ * @param sender_id The board ID of the sender.
+ *
+ * @param target_id The board ID of the receiver.
+ *
+ * @param timestamp_us The timestamp carried by the frame.
+ *
+ * @param rx_timestamp_us The time base value when the first byte arrives.
+ *
+ * @return None
+ */
+static void Receive_Frame(uint8_t type, uint8_t sender_id, uint8_t target_id, uint64_t timestamp_us, uint64_t rx_timestamp_us)
+{
+	uint8_t frame[13];
+	uint8_t checksum = 0;
+
+	frame[0] = 0xA5;
+	frame[1] = type;
+	frame[2] = sender_id;
+	frame[3] = target_id;
+
+	for (uint8_t i = 0; i < 8; i++)
+	{
+		frame[4 + i] = (uint8_t)(timestamp_us >> (8 * i));
+	}
+
+	for (uint8_t i = 1; i < 12; i++)
+	{
+		checksum = checksum + frame[i];
+	}
+	frame[12] = checksum;
+
+	for (uint8_t i = 0; i < 13; i++)
+	{
+		(*uart5_rx_task)(frame[i], rx_timestamp_us + (i * 87));
+	}
+}
+
+/**
+ * @brief Runs one two-way exchange between the master and the slave under test.
+ *
+ * The slave's clock is ahead of the master's by offset_us, and the link has the same
+ * delay in both directions. The DELAY_REQ message is sent 500 us after the SYNC message arrives.
+ *
+ * @param t1_us The master's transmit timestamp of the SYNC message.
+ *
+ * @param offset_us The offset of the slave's clock (slave - master).
+ *
+ * @param delay_us The path delay of the link.
+ *
+ * @return None
+ */
+static void Run_Exchange(uint64_t t1_us, int64_t offset_us, uint64_t delay_us)
+{
+	uint64_t t2_us = t1_us + delay_us + offset_us;
+	uint64_t t3_us = t2_us + 500;
+	uint64_t t4_us = t3_us - offset_us + delay_us;
+
+	Receive_Frame(0x01, TIME_SYNC_MASTER_ID, TEST_BOARD_ID, 0, t2_us);
+
+	uart5_tx_timestamp_us = t3_us;
+	uart5_last_type = 0;
+	Receive_Frame(0x02, TIME_SYNC_MASTER_ID, TEST_BOARD_ID, t1_us, t2_us + 2000);
+	CHECK_EQUAL(uart5_last_type, 0x03);
+
+	Receive_Frame(0x04, TIME_SYNC_MASTER_ID, TEST_BOARD_ID, t4_us, t3_us + 2000);
+}
+
+/**
+ * @brief Starts the driver on the slave under test with a clean time base.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Reset_Slave(void)
+{
+	time_base_rate_trim_ppb = 0;
+	time_base_step_ticks = 0;
+	time_base_phase_us = 0;
+	uart5_accept = 0x01;
+	Time_Sync_Init(TEST_BOARD_ID, &Test_Start_Task);
+}
+
+static void Test_Offset_And_Path_Delay(void)
+{
+	Time_Sync_Status status;
+
+	Reset_Slave();
+	Run_Exchange(10000000, 300, 120);
+	Time_Sync_Get_Status(&status);
+
+	CHECK_EQUAL(status.offset_us, 300);
+	CHECK_EQUAL(status.path_delay_us, 120);
+	CHECK_EQUAL(status.exchanges, 1);
+	CHECK_EQUAL(status.locked, 0x00);
+
+	// An offset below half a tick is slewed out without a step, and the drift estimate starts
+	CHECK_EQUAL(time_base_step_ticks, 0);
+	CHECK_EQUAL(time_base_phase_us, -300);
+	CHECK_EQUAL(time_base_rate_trim_ppb, 0);
+}
+
+static void Test_Step(void)
+{
+	Time_Sync_Status status;
+
+	// A slave ahead by 2.5 ticks steps back by 3 ticks and slews the remaining +0.5 tick
+	Reset_Slave();
+	Run_Exchange(10000000, 2500, 100);
+	CHECK_EQUAL(time_base_step_ticks, -3);
+	CHECK_EQUAL(time_base_phase_us, 500);
+
+	// A slave behind by 2.4 ticks steps forward by 2 ticks and slews the remaining -0.4 tick
+	Reset_Slave();
+	Run_Exchange(10000000, -2400, 100);
+	CHECK_EQUAL(time_base_step_ticks, 2);
+	CHECK_EQUAL(time_base_phase_us, 400);
+
+	// The time base has jumped, so the next exchange restarts the drift estimate instead of trimming
+	time_base_step_ticks = 0;
+	time_base_phase_us = 0;
+	Run_Exchange(11000000, 40, 100);
+	CHECK_EQUAL(time_base_step_ticks, 0);
+	CHECK_EQUAL(time_base_phase_us, -40);
+	CHECK_EQUAL(time_base_rate_trim_ppb, 0);
+
+	// Offsets above TIME_SYNC_STEP_THRESHOLD_US are stepped even when the drift estimate is running
+	time_base_phase_us = 0;
+	Run_Exchange(12000000, -1600, 100);
+	CHECK_EQUAL(time_base_step_ticks, 2);
+	CHECK_EQUAL(time_base_phase_us, -400);
+	CHECK_EQUAL(time_base_rate_trim_ppb, 0);
+
+	Time_Sync_Get_Status(&status);
+	CHECK_EQUAL(status.offset_us, -1600);
+	CHECK_EQUAL(status.exchanges, 3);
+}
+
+static void Test_Drift(void)
+{
+	Time_Sync_Status status;
+
+	Reset_Slave();
+	Run_Exchange(10000000, 0, 100);
+	CHECK_EQUAL(time_base_phase_us, 0);
+
+	// 10 us gained in 1 s is 10000 ppb fast, and half of the estimate is applied
+	// (t1 is chosen so that the SYNC messages arrive exactly 1 s apart)
+	Run_Exchange(10999990, 10, 100);
+	CHECK_EQUAL(time_base_rate_trim_ppb, -5000);
+	CHECK_EQUAL(time_base_phase_us, -10);
+
+	// 4 us lost in 2 s is 2000 ppb slow, which is added to the current trim
+	Run_Exchange(13000004, -4, 100);
+	CHECK_EQUAL(time_base_rate_trim_ppb, -4000);
+	CHECK_EQUAL(time_base_phase_us, -6);
+
+	Time_Sync_Get_Status(&status);
+	CHECK_EQUAL(status.rate_trim_ppb, -4000);
+	CHECK_EQUAL(status.locked, 0x01);
+
+	// The trim is limited to TIME_SYNC_MAX_TRIM_PPB in both directions
+	Run_Exchange(14000000, 400, 100);
+	CHECK_EQUAL(time_base_rate_trim_ppb, -TIME_SYNC_MAX_TRIM_PPB);
+	Run_Exchange(15000000, -900, 100);
+	Run_Exchange(16000000, -900, 100);
+	CHECK_EQUAL(time_base_rate_trim_ppb, TIME_SYNC_MAX_TRIM_PPB);
+}
+
+static void Test_Start(void)
+{
+	// A slave fires the start on the first tick at or after the master's timestamp
+	Reset_Slave();
+	start_task_calls = 0;
+	Receive_Frame(0x05, TIME_SYNC_MASTER_ID, TIME_SYNC_MAX_BOARDS, 20000000, 19900000);
+
+	time_base_now_us = 19999000;
+	Time_Sync_Tick();
+	CHECK_EQUAL(start_task_calls, 0);
+
+	time_base_now_us = 20000000;
+	Time_Sync_Tick();
+	Time_Sync_Tick();
+	CHECK_EQUAL(start_task_calls, 1);
+
+	// The master retries the START message while the transmit buffer is full
+	start_task_calls = 0;
+	Time_Sync_Init(TIME_SYNC_MASTER_ID, &Test_Start_Task);
+	uart5_accept = 0x00;
+	time_base_now_us = 30000500;
+	CHECK_EQUAL(Time_Sync_Schedule_Start(), 0x01);
+
+	time_base_now_us = 30001000;
+	Time_Sync_Tick();
+	uart5_frames = 0;
+	uart5_accept = 0x01;
+	time_base_now_us = 30002000;
+	Time_Sync_Tick();
+	CHECK_EQUAL(uart5_frames, 1);
+	CHECK_EQUAL(uart5_last_type, 0x05);
+
+	time_base_now_us = 30003000;
+	Time_Sync_Tick();
+	CHECK_EQUAL(uart5_frames, 1);
+
+	time_base_now_us = 30101000;
+	Time_Sync_Tick();
+	CHECK_EQUAL(start_task_calls, 1);
+}
+
+static void Test_Time_Of_Day(void)
+{
+	// A slave keeps its RTC within the tolerance and loads the master's RTC seconds otherwise
+	Reset_Slave();
+	rtc_seconds = 43200;
+	rtc_loads = 0;
+	Receive_Frame(0x06, TIME_SYNC_MASTER_ID, TIME_SYNC_MAX_BOARDS, 43201, 0);
+	CHECK_EQUAL(rtc_loads, 0);
+	Receive_Frame(0x06, TIME_SYNC_MASTER_ID, TIME_SYNC_MAX_BOARDS, 43198, 0);
+	CHECK_EQUAL(rtc_loads, 1);
+	CHECK_EQUAL(rtc_seconds, 43198);
+
+	// A slave ignores SET_TIME frames
+	Receive_Frame(0x07, 0xFF, TEST_BOARD_ID, 3600, 0);
+	CHECK_EQUAL(rtc_seconds, 43198);
+
+	// The master loads its RTC from a SET_TIME frame and distributes it after the next SYNC message
+	Time_Sync_Init(TIME_SYNC_MASTER_ID, &Test_Start_Task);
+	Receive_Frame(0x07, 0xFF, TIME_SYNC_MASTER_ID, 3600, 0);
+	CHECK_EQUAL(rtc_seconds, 3600);
+
+	for (uint32_t i = 0; i < TIME_SYNC_INTERVAL_MS; i++)
+	{
+		Time_Sync_Tick();
+	}
+	CHECK_EQUAL(uart5_last_type, 0x06);
+}
+
+int main(void)
+{
+	Test_Offset_And_Path_Delay();
+	Test_Step();
+	Test_Drift();
+	Test_Start();
+	Test_Time_Of_Day();
+
+	printf("Test_Time_Sync: %s\n", (failures == 0) ? "passed" : "FAILED");
+
+	return (failures == 0) ? 0 : 1;
+}
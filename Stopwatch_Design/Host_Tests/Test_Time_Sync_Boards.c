@@ -0,0 +1,452 @@
+/**
+ * @file Test_Time_Sync_Boards.c
+ *
+ * @brief Host simulation of a master and two slaves that synchronize their time bases over UART5.
+ *
+ * Every board runs its own copy of the Time_Sync driver (see Time_Sync_Board.c) on a model of
+ * its hardware, which is advanced in steps of 1 us of true time:
+ *	- An oscillator with a frequency error in ppm counts the periods of Timer 0A.
+ *	- The time base follows Time_Base.c: every time-out adds one tick to the time base,
+ *	  applies the phase correction and the rate trim to the next period, and calls Time_Sync_Tick.
+ *	- The UART5 link runs at 1 Mbps (10 us per byte) and follows UART5.c: a frame is queued
+ *	  in a buffer of UART5_TX_BUFFER_SIZE bytes, a timestamped frame is only accepted by an idle
+ *	  transmitter, and every received byte is timestamped with the time base of the receiver.
+ *	  The frames of the master are received by both slaves, and the frames of a slave by the master.
+ *
+ * The boards start with different times and oscillator errors. The test checks that the slaves
+ * lock to the master, that their rate trims converge to the frequency errors, and that a
+ * synchronized start fires on the same tick on every board, also when its first broadcast fails.
+ *
+ * @author Katherine Poz
+ */
+
+#include <stdio.h>
+
+#include "Time_Sync.h"
+
+static int failures = 0;
+
+#define CHECK_EQUAL(actual, expected) Check_Equal((int64_t)(actual), (int64_t)(expected), #actual, __LINE__)
+#define CHECK_RANGE(actual, minimum, maximum) Check_Range((int64_t)(actual), (int64_t)(minimum), (int64_t)(maximum), #actual, __LINE__)
+
+static void Check_Equal(int64_t actual, int64_t expected, const char *expression, int line)
+{
+	if (actual != expected)
+	{
+		printf("line %d: %s = %lld, expected %lld\n", line, expression, (long long)actual, (long long)expected);
+		failures++;
+	}
+}
+
+static void Check_Range(int64_t actual, int64_t minimum, int64_t maximum, const char *expression, int line)
+{
+	if ((actual < minimum) || (actual > maximum))
+	{
+		printf("line %d: %s = %lld, expected %lld to %lld\n", line, expression, (long long)actual, (long long)minimum, (long long)maximum);
+		failures++;
+	}
+}
+
+// Number of simulated boards, board 0 is the master
+#define SIM_BOARDS					3
+
+// Length of one byte on the link (start bit, 8 data bits and stop bit at 1 Mbps)
+#define SIM_BYTE_US					10
+
+// Picoseconds in one microsecond, the resolution of the oscillator model
+#define SIM_PS_PER_US				1000000
+
+// Rate trim step of the time base, as in Time_Base.c
+#define SIM_RATE_TRIM_STEP_PPB		1000000
+
+typedef struct
+{
+	// Oscillator: frequency error and the time counted in the current period
+	int32_t error_ppm;
+	int64_t counted_ps;
+
+	// Time base
+	uint64_t time_at_tick_us;
+	uint32_t active_interval_us;
+	uint32_t loaded_interval_us;
+	int32_t phase_remaining_us;
+	int32_t rate_trim_ppb;
+	int32_t rate_accumulator;
+
+	// RTC
+	uint32_t rtc_seconds;
+
+	// UART5 link
+	void (*rx_task)(uint8_t data, uint64_t timestamp_us);
+	uint8_t tx_buffer[UART5_TX_BUFFER_SIZE];
+	uint8_t tx_tail;
+	uint8_t tx_count;
+	uint8_t tx_busy;
+	uint8_t tx_byte;
+	uint32_t tx_remaining_us;
+	uint8_t tx_refuse;
+
+	// Synchronized start: time base and true time when the start task was called
+	uint8_t started;
+	uint64_t start_time_us;
+	uint64_t start_true_us;
+} Sim_Board;
+
+static Sim_Board sim_boards[SIM_BOARDS];
+
+// True time of the simulation
+static uint64_t true_time_us = 0;
+
+static uint64_t Sim_Time_us(Sim_Board *board)
+{
+	// The counter of the time base is read in whole microseconds of the local oscillator
+	int64_t elapsed_us = board->counted_ps / SIM_PS_PER_US;
+	if (elapsed_us > (int64_t)(board->active_interval_us - 1))
+	{
+		elapsed_us = board->active_interval_us - 1;
+	}
+
+	return board->time_at_tick_us + (uint64_t)elapsed_us;
+}
+
+static uint8_t Sim_Send(Sim_Board *board, const uint8_t *frame, uint8_t length, uint64_t *tx_timestamp_us)
+{
+	uint8_t idle = (board->tx_busy == 0x00) && (board->tx_count == 0);
+
+	if ((board->tx_refuse == 0x01) || (length == 0) || ((board->tx_count + length) > UART5_TX_BUFFER_SIZE) || ((idle == 0x00) && (tx_timestamp_us != NULL)))
+	{
+		return 0x00;
+	}
+
+	uint8_t index = 0;
+
+	if (idle == 0x01)
+	{
+		if (tx_timestamp_us != NULL)
+		{
+			*tx_timestamp_us = Sim_Time_us(board);
+		}
+		board->tx_busy = 0x01;
+		board->tx_byte = frame[0];
+		board->tx_remaining_us = SIM_BYTE_US;
+		index = 1;
+	}
+
+	for (; index < length; index++)
+	{
+		board->tx_buffer[(board->tx_tail + board->tx_count) % UART5_TX_BUFFER_SIZE] = frame[index];
+		board->tx_count = board->tx_count + 1;
+	}
+
+	return 0x01;
+}
+
+static Hibernation_RTC_Time Sim_RTC_Get(Sim_Board *board)
+{
+	Hibernation_RTC_Time time;
+
+	time.seconds = board->rtc_seconds;
+	time.subseconds = 0;
+
+	return time;
+}
+
+static void Sim_Start(Sim_Board *board)
+{
+	board->started = 0x01;
+	board->start_time_us = Sim_Time_us(board);
+	board->start_true_us = true_time_us;
+}
+
+// Functions of every board's copy of the driver and the functions it calls
+#define SIM_BOARD_FUNCTIONS(n)																			\
+	void Time_Sync_Init_##n(uint8_t board_id, void(*start_task)(void));									\
+	void Time_Sync_Tick_##n(void);																		\
+	uint8_t Time_Sync_Schedule_Start_##n(void);															\
+	void Time_Sync_Get_Status_##n(Time_Sync_Status *status);											\
+	void UART5_Init_##n(void(*rx_task)(uint8_t data, uint64_t timestamp_us)) { sim_boards[n].rx_task = rx_task; }	\
+	uint8_t UART5_Send_Frame_##n(const uint8_t *frame, uint8_t length, uint64_t *tx_timestamp_us) { return Sim_Send(&sim_boards[n], frame, length, tx_timestamp_us); }	\
+	uint64_t Time_Base_Get_Time_us_##n(void) { return Sim_Time_us(&sim_boards[n]); }					\
+	int32_t Time_Base_Get_Rate_Trim_##n(void) { return sim_boards[n].rate_trim_ppb; }					\
+	void Time_Base_Set_Rate_Trim_##n(int32_t trim_ppb) { sim_boards[n].rate_trim_ppb = trim_ppb; }	\
+	void Time_Base_Step_Ticks_##n(int32_t ticks) { sim_boards[n].time_at_tick_us += (int64_t)ticks * TIME_BASE_TICK_US; }	\
+	void Time_Base_Adjust_Phase_##n(int32_t offset_us) { sim_boards[n].phase_remaining_us = offset_us; }	\
+	Hibernation_RTC_Time Hibernation_RTC_Get_##n(void) { return Sim_RTC_Get(&sim_boards[n]); }		\
+	void Hibernation_RTC_Set_##n(uint32_t seconds) { sim_boards[n].rtc_seconds = seconds; }			\
+	static void Start_Task_##n(void) { Sim_Start(&sim_boards[n]); }
+
+SIM_BOARD_FUNCTIONS(0)
+SIM_BOARD_FUNCTIONS(1)
+SIM_BOARD_FUNCTIONS(2)
+
+typedef struct
+{
+	void (*init)(uint8_t board_id, void(*start_task)(void));
+	void (*tick)(void);
+	void (*get_status)(Time_Sync_Status *status);
+	void (*start_task)(void);
+} Sim_Driver;
+
+static const Sim_Driver sim_drivers[SIM_BOARDS] =
+{
+	{ &Time_Sync_Init_0, &Time_Sync_Tick_0, &Time_Sync_Get_Status_0, &Start_Task_0 },
+	{ &Time_Sync_Init_1, &Time_Sync_Tick_1, &Time_Sync_Get_Status_1, &Start_Task_1 },
+	{ &Time_Sync_Init_2, &Time_Sync_Tick_2, &Time_Sync_Get_Status_2, &Start_Task_2 }
+};
+
+// Time-out of Timer 0A, as in Time_Base_Tick
+static void Sim_Tick(uint8_t n)
+{
+	Sim_Board *board = &sim_boards[n];
+
+	board->time_at_tick_us = board->time_at_tick_us + TIME_BASE_TICK_US;
+	board->active_interval_us = board->loaded_interval_us;
+
+	int32_t trim_us = 0;
+
+	if (board->phase_remaining_us > 0)
+	{
+		trim_us = trim_us - 1;
+		board->phase_remaining_us = board->phase_remaining_us - 1;
+	}
+	else if (board->phase_remaining_us < 0)
+	{
+		trim_us = trim_us + 1;
+		board->phase_remaining_us = board->phase_remaining_us + 1;
+	}
+
+	board->rate_accumulator = board->rate_accumulator + board->rate_trim_ppb;
+	if (board->rate_accumulator >= SIM_RATE_TRIM_STEP_PPB)
+	{
+		board->rate_accumulator = board->rate_accumulator - SIM_RATE_TRIM_STEP_PPB;
+		trim_us = trim_us - 1;
+	}
+	else if (board->rate_accumulator <= -SIM_RATE_TRIM_STEP_PPB)
+	{
+		board->rate_accumulator = board->rate_accumulator + SIM_RATE_TRIM_STEP_PPB;
+		trim_us = trim_us + 1;
+	}
+
+	board->loaded_interval_us = TIME_BASE_TICK_US + trim_us;
+
+	(*sim_drivers[n].tick)();
+}
+
+// Shifts out the byte on the link of a board and delivers it when its stop bit has been sent
+static void Sim_Link(uint8_t n)
+{
+	Sim_Board *board = &sim_boards[n];
+
+	if (board->tx_busy == 0x00)
+	{
+		return;
+	}
+
+	board->tx_remaining_us = board->tx_remaining_us - 1;
+	if (board->tx_remaining_us > 0)
+	{
+		return;
+	}
+
+	for (uint8_t receiver = 0; receiver < SIM_BOARDS; receiver++)
+	{
+		// The master talks to every slave and the slaves only talk to the master
+		if ((receiver != n) && ((n == TIME_SYNC_MASTER_ID) || (receiver == TIME_SYNC_MASTER_ID)))
+		{
+			(*sim_boards[receiver].rx_task)(board->tx_byte, Sim_Time_us(&sim_boards[receiver]));
+		}
+	}
+
+	// Start the next byte from the transmit buffer
+	if (board->tx_count > 0)
+	{
+		board->tx_byte = board->tx_buffer[board->tx_tail];
+		board->tx_tail = (board->tx_tail + 1) % UART5_TX_BUFFER_SIZE;
+		board->tx_count = board->tx_count - 1;
+		board->tx_remaining_us = SIM_BYTE_US;
+	}
+	else
+	{
+		board->tx_busy = 0x00;
+	}
+}
+
+// Advances the simulation by one microsecond of true time
+static void Sim_Step(void)
+{
+	true_time_us = true_time_us + 1;
+
+	for (uint8_t n = 0; n < SIM_BOARDS; n++)
+	{
+		Sim_Board *board = &sim_boards[n];
+
+		board->counted_ps = board->counted_ps + SIM_PS_PER_US + board->error_ppm;
+		if (board->counted_ps >= ((int64_t)board->active_interval_us * SIM_PS_PER_US))
+		{
+			board->counted_ps = board->counted_ps - ((int64_t)board->active_interval_us * SIM_PS_PER_US);
+			Sim_Tick(n);
+		}
+	}
+
+	for (uint8_t n = 0; n < SIM_BOARDS; n++)
+	{
+		Sim_Link(n);
+	}
+}
+
+// Difference between the time bases of a slave and the master at the current true time
+static int64_t Sim_Offset_us(uint8_t n)
+{
+	return (int64_t)(Sim_Time_us(&sim_boards[n]) - Sim_Time_us(&sim_boards[TIME_SYNC_MASTER_ID]));
+}
+
+// Frequency errors, initial time base values, positions in the first period and RTC seconds of the boards
+static const int32_t test_error_ppm[SIM_BOARDS] = { 5, 35, -28 };
+static const uint64_t test_time_us[SIM_BOARDS] = { 5000000000ULL, 1234000ULL, 5002345000ULL };
+static const int64_t test_counted_us[SIM_BOARDS] = { 0, 300, 777 };
+static const uint32_t test_rtc_seconds[SIM_BOARDS] = { 43200, 0, 43201 };
+
+// Time until the slaves are expected to be locked, and the time they are checked afterwards
+#define TEST_CONVERGENCE_US			40000000ULL
+#define TEST_LOCKED_US				20000000ULL
+
+// Rate trims may differ from the frequency errors by the quantization of the drift estimate
+#define TEST_TRIM_TOLERANCE_PPB		2000
+
+static void Test_Convergence(void)
+{
+	for (uint8_t n = 0; n < SIM_BOARDS; n++)
+	{
+		Sim_Board *board = &sim_boards[n];
+
+		board->error_ppm = test_error_ppm[n];
+		board->counted_ps = test_counted_us[n] * SIM_PS_PER_US;
+		board->time_at_tick_us = test_time_us[n];
+		board->active_interval_us = TIME_BASE_TICK_US;
+		board->loaded_interval_us = TIME_BASE_TICK_US;
+		board->rtc_seconds = test_rtc_seconds[n];
+
+		(*sim_drivers[n].init)(n, sim_drivers[n].start_task);
+	}
+
+	while (true_time_us < TEST_CONVERGENCE_US)
+	{
+		Sim_Step();
+	}
+
+	// The slaves stay within the lock threshold of the master for the rest of the run
+	int64_t max_offset_us[SIM_BOARDS] = { 0 };
+
+	while (true_time_us < (TEST_CONVERGENCE_US + TEST_LOCKED_US))
+	{
+		Sim_Step();
+
+		for (uint8_t n = 1; n < SIM_BOARDS; n++)
+		{
+			int64_t offset_us = Sim_Offset_us(n);
+			offset_us = (offset_us < 0) ? -offset_us : offset_us;
+			if (offset_us > max_offset_us[n])
+			{
+				max_offset_us[n] = offset_us;
+			}
+		}
+	}
+
+	for (uint8_t n = 1; n < SIM_BOARDS; n++)
+	{
+		Time_Sync_Status status;
+		(*sim_drivers[n].get_status)(&status);
+
+		// The master polls the slaves in turn, one per interval
+		CHECK_RANGE(status.exchanges, 15, 20);
+		CHECK_EQUAL(status.locked, 0x01);
+		CHECK_RANGE(status.offset_us, -TIME_SYNC_LOCK_THRESHOLD_US, TIME_SYNC_LOCK_THRESHOLD_US);
+		CHECK_RANGE(max_offset_us[n], 0, TIME_SYNC_LOCK_THRESHOLD_US);
+
+		// A frame takes SIM_BYTE_US to arrive, the timestamps are taken at the end of the first byte
+		CHECK_RANGE(status.path_delay_us, SIM_BYTE_US - 1, SIM_BYTE_US + 1);
+
+		// The rate trim cancels the frequency error relative to the master
+		int32_t expected_trim_ppb = -(test_error_ppm[n] - test_error_ppm[TIME_SYNC_MASTER_ID]) * 1000;
+		CHECK_RANGE(status.rate_trim_ppb, expected_trim_ppb - TEST_TRIM_TOLERANCE_PPB, expected_trim_ppb + TEST_TRIM_TOLERANCE_PPB);
+		CHECK_EQUAL(sim_boards[n].rate_trim_ppb, status.rate_trim_ppb);
+
+		// The time of day of the master has been distributed, small differences are kept
+		CHECK_EQUAL(sim_boards[n].rtc_seconds, (n == 1) ? test_rtc_seconds[TIME_SYNC_MASTER_ID] : test_rtc_seconds[n]);
+	}
+}
+
+// Runs the simulation until every board has fired the start or the time runs out
+static void Run_Until_Started(uint64_t duration_us)
+{
+	uint64_t end_us = true_time_us + duration_us;
+	uint8_t started;
+
+	do
+	{
+		Sim_Step();
+
+		started = 0x01;
+		for (uint8_t n = 0; n < SIM_BOARDS; n++)
+		{
+			started = started & sim_boards[n].started;
+		}
+	} while ((started == 0x00) && (true_time_us < end_us));
+}
+
+static void Check_Start(uint64_t scheduled_us)
+{
+	// The start is rounded up to the next tick after the lead time
+	CHECK_RANGE(sim_boards[TIME_SYNC_MASTER_ID].start_time_us, scheduled_us + TIME_SYNC_START_LEAD_US, scheduled_us + TIME_SYNC_START_LEAD_US + TIME_BASE_TICK_US - 1);
+	CHECK_EQUAL(sim_boards[TIME_SYNC_MASTER_ID].start_time_us % TIME_BASE_TICK_US, 0);
+
+	for (uint8_t n = 0; n < SIM_BOARDS; n++)
+	{
+		Sim_Board *board = &sim_boards[n];
+
+		CHECK_EQUAL(board->started, 0x01);
+
+		// Every board fires on the tick of the scheduled timestamp, at the same true time within the lock threshold
+		CHECK_EQUAL(board->start_time_us, sim_boards[TIME_SYNC_MASTER_ID].start_time_us);
+		CHECK_RANGE((int64_t)(board->start_true_us - sim_boards[TIME_SYNC_MASTER_ID].start_true_us), -TIME_SYNC_LOCK_THRESHOLD_US, TIME_SYNC_LOCK_THRESHOLD_US);
+
+		board->started = 0x00;
+	}
+}
+
+static void Test_Synchronized_Start(void)
+{
+	// Only the master schedules a start
+	CHECK_EQUAL(Time_Sync_Schedule_Start_1(), 0x00);
+
+	// The START broadcast is accepted right away
+	uint64_t scheduled_us = Sim_Time_us(&sim_boards[TIME_SYNC_MASTER_ID]);
+	CHECK_EQUAL(Time_Sync_Schedule_Start_0(), 0x01);
+	Run_Until_Started(2 * TIME_SYNC_START_LEAD_US);
+	Check_Start(scheduled_us);
+
+	// The link of the master is not available when the start is scheduled,
+	// so the broadcast is retried from Time_Sync_Tick
+	for (uint8_t i = 0; i < 3; i++)
+	{
+		Sim_Step();
+	}
+	sim_boards[TIME_SYNC_MASTER_ID].tx_refuse = 0x01;
+	scheduled_us = Sim_Time_us(&sim_boards[TIME_SYNC_MASTER_ID]);
+	CHECK_EQUAL(Time_Sync_Schedule_Start_0(), 0x01);
+	CHECK_EQUAL(sim_boards[TIME_SYNC_MASTER_ID].tx_busy, 0x00);
+	sim_boards[TIME_SYNC_MASTER_ID].tx_refuse = 0x00;
+
+	Run_Until_Started(2 * TIME_SYNC_START_LEAD_US);
+	Check_Start(scheduled_us);
+}
+
+int main(void)
+{
+	Test_Convergence();
+	Test_Synchronized_Start();
+
+	printf("Test_Time_Sync_Boards: %s\n", (failures == 0) ? "passed" : "FAILED");
+
+	return (failures == 0) ? 0 : 1;
+}
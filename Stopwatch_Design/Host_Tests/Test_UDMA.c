@@ -0,0 +1,274 @@
+/**
+ * @file Test_UDMA.c
+ *
+ * @brief Host test of the control structures and channel registers written by the UDMA driver.
+ *
+ * The uDMA registers are a variable in host memory, and the completion of a transfer is simulated
+ * by writing the control table and the DMACHIS register the way the controller does. The test is
+ * linked without position independence, so the 32-bit addresses in the control structures hold
+ * the complete host addresses of the static buffers.
+ *
+ * @author Katherine Poz
+ */
+
+#include <stdio.h>
+
+#include "UDMA.h"
+
+static int failures = 0;
+
+#define CHECK_EQUAL(actual, expected) Check_Equal((int64_t)(actual), (int64_t)(expected), #actual, __LINE__)
+
+static void Check_Equal(int64_t actual, int64_t expected, const char *expression, int line)
+{
+	if (actual != expected)
+	{
+		printf("line %d: %s = %lld, expected %lld\n", line, expression, (long long)actual, (long long)expected);
+		failures++;
+	}
+}
+
+// Register block of the uDMA controller
+UDMA_Type host_udma;
+
+void Clock_Gating_Acquire(Clock_Gating_Peripheral peripheral, uint8_t instance_mask, uint8_t modes) {}
+void Clock_Gating_Release(Clock_Gating_Peripheral peripheral, uint8_t instance_mask, uint8_t modes) {}
+
+// Channel and encoding of the Wide Timer 1A capture used by the edge logger
+#define TEST_CHANNEL				12
+#define TEST_ENCODING				3
+
+#define ADDRESS(pointer)			((uint32_t)(uintptr_t)(pointer))
+
+static uint8_t source[64];
+static uint8_t destination[64];
+static UDMA_Task sg_tasks[3];
+
+// Structures reported by the channel callback
+static uint8_t callback_structures[4];
+static uint8_t callback_count = 0;
+
+static void Test_Callback(uint8_t channel, uint8_t structure)
+{
+	if ((channel == TEST_CHANNEL) && (callback_count < sizeof(callback_structures)))
+	{
+		callback_structures[callback_count] = structure;
+	}
+	callback_count++;
+}
+
+static UDMA_Task *Control_Table(void)
+{
+	return (UDMA_Task *)(uintptr_t)UDMA->CTLBASE;
+}
+
+static void Test_Set_Task(void)
+{
+	UDMA_Task task;
+	uint32_t control;
+
+	// 8-bit items: the end address is (count - 1) bytes after the start
+	control = UDMA_CONTROL(UDMA_INC_8, UDMA_INC_8, UDMA_SIZE_8, 0);
+	CHECK_EQUAL(UDMA_Set_Task(&task, control, UDMA_MODE_AUTO, source, destination, 10), 0x01);
+	CHECK_EQUAL(task.src_end, ADDRESS(&source[9]));
+	CHECK_EQUAL(task.dst_end, ADDRESS(&destination[9]));
+	CHECK_EQUAL(task.control, control | (9 << 4) | UDMA_MODE_AUTO);
+
+	// 16-bit items
+	control = UDMA_CONTROL(UDMA_INC_16, UDMA_INC_16, UDMA_SIZE_16, 0);
+	CHECK_EQUAL(UDMA_Set_Task(&task, control, UDMA_MODE_BASIC, source, destination, 8), 0x01);
+	CHECK_EQUAL(task.src_end, ADDRESS(&source[14]));
+	CHECK_EQUAL(task.dst_end, ADDRESS(&destination[14]));
+	CHECK_EQUAL((task.control >> 4) & 0x3FF, 7);
+
+	// 32-bit items
+	control = UDMA_CONTROL(UDMA_INC_32, UDMA_INC_32, UDMA_SIZE_32, 0);
+	CHECK_EQUAL(UDMA_Set_Task(&task, control, UDMA_MODE_BASIC, source, destination, 16), 0x01);
+	CHECK_EQUAL(task.src_end, ADDRESS(&source[60]));
+	CHECK_EQUAL(task.dst_end, ADDRESS(&destination[60]));
+	CHECK_EQUAL((task.control >> 4) & 0x3FF, 15);
+
+	// A register source is not incremented, so its end address is its start address
+	control = UDMA_CONTROL(UDMA_INC_32, UDMA_INC_NONE, UDMA_SIZE_32, 0);
+	CHECK_EQUAL(UDMA_Set_Task(&task, control, UDMA_MODE_BASIC, source, destination, 16), 0x01);
+	CHECK_EQUAL(task.src_end, ADDRESS(source));
+	CHECK_EQUAL(task.dst_end, ADDRESS(&destination[60]));
+
+	// The largest transfer fills the XFERSIZE field
+	CHECK_EQUAL(UDMA_Set_Task(&task, control, UDMA_MODE_BASIC, source, destination, UDMA_MAX_TRANSFER), 0x01);
+	CHECK_EQUAL((task.control >> 4) & 0x3FF, 0x3FF);
+	CHECK_EQUAL(task.control & 0x7, UDMA_MODE_BASIC);
+
+	// A count that does not fit into XFERSIZE is rejected and leaves the task unchanged
+	uint32_t previous = task.control;
+	CHECK_EQUAL(UDMA_Set_Task(&task, control, UDMA_MODE_AUTO, source, destination, 0), 0x00);
+	CHECK_EQUAL(UDMA_Set_Task(&task, control, UDMA_MODE_AUTO, source, destination, UDMA_MAX_TRANSFER + 1), 0x00);
+	CHECK_EQUAL(task.control, previous);
+}
+
+static void Test_Allocate_Free(void)
+{
+	UDMA_Init(5);
+
+	// The encoding is written to its 4 bits of DMACHMAP1 and the other channels are kept
+	UDMA->CHMAP1 = 0xFFFFFFFF;
+	UDMA->ENACLR = 0;
+	UDMA->ALTCLR = 0;
+	CHECK_EQUAL(UDMA_Allocate_Channel(TEST_CHANNEL, TEST_ENCODING, &Test_Callback), 0x01);
+	CHECK_EQUAL(UDMA->CHMAP1, 0xFFF3FFFF);
+	CHECK_EQUAL(UDMA->ENACLR, 1UL << TEST_CHANNEL);
+	CHECK_EQUAL(UDMA->REQMASKCLR, 1UL << TEST_CHANNEL);
+	CHECK_EQUAL(UDMA->USEBURSTCLR, 1UL << TEST_CHANNEL);
+	CHECK_EQUAL(UDMA->PRIOCLR, 1UL << TEST_CHANNEL);
+	CHECK_EQUAL(UDMA->ALTCLR, 1UL << TEST_CHANNEL);
+
+	// A channel in use cannot be allocated again
+	CHECK_EQUAL(UDMA_Allocate_Channel(TEST_CHANNEL, 0, 0), 0x00);
+	CHECK_EQUAL(UDMA->CHMAP1, 0xFFF3FFFF);
+
+	// The last channel of a map register uses its upper 4 bits
+	UDMA->CHMAP0 = 0;
+	CHECK_EQUAL(UDMA_Allocate_Channel(7, 2, 0), 0x01);
+	CHECK_EQUAL(UDMA->CHMAP0, 0x20000000);
+
+	// The controller is kept while channels are allocated
+	CHECK_EQUAL(UDMA_Deinit(), 0x00);
+
+	// A freed channel is stopped, its pending completion is discarded, and it can be allocated again
+	UDMA->ENACLR = 0;
+	UDMA->CHIS = 0;
+	UDMA_Free_Channel(7);
+	CHECK_EQUAL(UDMA->ENACLR, 1UL << 7);
+	CHECK_EQUAL(UDMA->CHIS, 1UL << 7);
+	CHECK_EQUAL(UDMA_Allocate_Channel(7, 0, 0), 0x01);
+	CHECK_EQUAL(UDMA->CHMAP0, 0x00000000);
+
+	UDMA_Free_Channel(7);
+	UDMA_Free_Channel(TEST_CHANNEL);
+	CHECK_EQUAL(UDMA_Deinit(), 0x01);
+	CHECK_EQUAL(UDMA->CFG, 0x00);
+}
+
+static void Test_Ping_Pong(void)
+{
+	uint32_t control = UDMA_CONTROL(UDMA_INC_32, UDMA_INC_NONE, UDMA_SIZE_32, 0);
+	static volatile uint32_t capture_register;
+	static volatile uint32_t ring[32];
+
+	UDMA_Init(5);
+	CHECK_EQUAL(UDMA->CTLBASE % 1024, 0);
+	CHECK_EQUAL(UDMA_Allocate_Channel(TEST_CHANNEL, TEST_ENCODING, &Test_Callback), 0x01);
+
+	UDMA->ENASET = 0;
+	CHECK_EQUAL(UDMA_Start_Ping_Pong(TEST_CHANNEL, control, &capture_register, &ring[0], &capture_register, &ring[16], 16), 0x01);
+	CHECK_EQUAL(UDMA->ENASET, 1UL << TEST_CHANNEL);
+
+	UDMA_Task *primary = &Control_Table()[TEST_CHANNEL];
+	UDMA_Task *alternate = &Control_Table()[UDMA_CHANNEL_COUNT + TEST_CHANNEL];
+	uint32_t armed = control | (15 << 4) | UDMA_MODE_PING_PONG;
+
+	CHECK_EQUAL(primary->src_end, ADDRESS(&capture_register));
+	CHECK_EQUAL(primary->dst_end, ADDRESS(&ring[15]));
+	CHECK_EQUAL(primary->control, armed);
+	CHECK_EQUAL(alternate->src_end, ADDRESS(&capture_register));
+	CHECK_EQUAL(alternate->dst_end, ADDRESS(&ring[31]));
+	CHECK_EQUAL(alternate->control, armed);
+	CHECK_EQUAL(UDMA_Get_Remaining(TEST_CHANNEL, UDMA_PRIMARY), 16);
+
+	// Nothing is reported without a completion of the channel
+	callback_count = 0;
+	UDMA->CHIS = 0;
+	UDMA_Service_Channel(TEST_CHANNEL);
+	CHECK_EQUAL(callback_count, 0);
+
+	// The controller has finished the primary structure and switched to the alternate structure
+	primary->control = control;
+	alternate->control = control | (9 << 4) | UDMA_MODE_PING_PONG;
+	UDMA->CHIS = 1UL << TEST_CHANNEL;
+	CHECK_EQUAL(UDMA_Get_Remaining(TEST_CHANNEL, UDMA_PRIMARY), 0);
+	CHECK_EQUAL(UDMA_Get_Remaining(TEST_CHANNEL, UDMA_ALTERNATE), 10);
+
+	UDMA_Service_Channel(TEST_CHANNEL);
+	CHECK_EQUAL(callback_count, 1);
+	CHECK_EQUAL(callback_structures[0], UDMA_PRIMARY);
+	CHECK_EQUAL(primary->control, armed);
+	CHECK_EQUAL(primary->dst_end, ADDRESS(&ring[15]));
+
+	// The structure that is still running is not touched
+	CHECK_EQUAL(alternate->control, control | (9 << 4) | UDMA_MODE_PING_PONG);
+
+	// Then the alternate structure finishes
+	alternate->control = control;
+	UDMA->CHIS = 1UL << TEST_CHANNEL;
+	UDMA_Service_Channel(TEST_CHANNEL);
+	CHECK_EQUAL(callback_count, 2);
+	CHECK_EQUAL(callback_structures[1], UDMA_ALTERNATE);
+	CHECK_EQUAL(alternate->control, armed);
+	CHECK_EQUAL(alternate->dst_end, ADDRESS(&ring[31]));
+
+	// An out-of-range count does not start the channel
+	UDMA->ENASET = 0;
+	CHECK_EQUAL(UDMA_Start_Ping_Pong(TEST_CHANNEL, control, &capture_register, &ring[0], &capture_register, &ring[16], 0), 0x00);
+	CHECK_EQUAL(UDMA->ENASET, 0);
+
+	UDMA_Free_Channel(TEST_CHANNEL);
+	UDMA_Deinit();
+}
+
+static void Test_Scatter_Gather(void)
+{
+	uint32_t control = UDMA_CONTROL(UDMA_INC_8, UDMA_INC_8, UDMA_SIZE_8, 0);
+
+	UDMA_Init(5);
+	CHECK_EQUAL(UDMA_Allocate_Channel(TEST_CHANNEL, 0, &Test_Callback), 0x01);
+
+	UDMA_Set_Task(&sg_tasks[0], control, UDMA_MODE_ALT_MEMORY_SG, &source[0], &destination[0], 4);
+	UDMA_Set_Task(&sg_tasks[1], control, UDMA_MODE_ALT_MEMORY_SG, &source[4], &destination[8], 4);
+	UDMA_Set_Task(&sg_tasks[2], control, UDMA_MODE_AUTO, &source[8], &destination[16], 4);
+
+	UDMA->ALTCLR = 0;
+	UDMA->ENASET = 0;
+	CHECK_EQUAL(UDMA_Start_Scatter_Gather(TEST_CHANNEL, sg_tasks, 3, 0x00), 0x01);
+
+	// The primary structure copies the 12 words of the list into the alternate structure
+	UDMA_Task *primary = &Control_Table()[TEST_CHANNEL];
+	UDMA_Task *alternate = &Control_Table()[UDMA_CHANNEL_COUNT + TEST_CHANNEL];
+
+	CHECK_EQUAL(primary->src_end, ADDRESS(&sg_tasks[2].unused));
+	CHECK_EQUAL(primary->dst_end, ADDRESS(&alternate->unused));
+	CHECK_EQUAL(primary->control, UDMA_CONTROL(UDMA_INC_32, UDMA_INC_32, UDMA_SIZE_32, 2) | (11 << 4) | UDMA_MODE_MEMORY_SG);
+	CHECK_EQUAL(UDMA->ALTCLR, 1UL << TEST_CHANNEL);
+	CHECK_EQUAL(UDMA->ENASET, 1UL << TEST_CHANNEL);
+
+	// A peripheral list uses the peripheral scatter-gather mode
+	CHECK_EQUAL(UDMA_Start_Scatter_Gather(TEST_CHANNEL, sg_tasks, 3, 0x01), 0x01);
+	CHECK_EQUAL(primary->control & 0x7, UDMA_MODE_PERIPHERAL_SG);
+
+	// The list must fit into one transfer of the primary structure
+	CHECK_EQUAL(UDMA_Start_Scatter_Gather(TEST_CHANNEL, sg_tasks, 0, 0x00), 0x00);
+	CHECK_EQUAL(UDMA_Start_Scatter_Gather(TEST_CHANNEL, sg_tasks, (UDMA_MAX_TRANSFER / 4) + 1, 0x00), 0x00);
+	CHECK_EQUAL(primary->control & 0x7, UDMA_MODE_PERIPHERAL_SG);
+
+	// The channel disables itself when the last task is done, and the callback reports the primary structure
+	callback_count = 0;
+	UDMA->ENASET = 0;
+	UDMA->CHIS = 1UL << TEST_CHANNEL;
+	UDMA_Service_Channel(TEST_CHANNEL);
+	CHECK_EQUAL(callback_count, 1);
+	CHECK_EQUAL(callback_structures[0], UDMA_PRIMARY);
+
+	UDMA_Free_Channel(TEST_CHANNEL);
+	UDMA_Deinit();
+}
+
+int main(void)
+{
+	Test_Set_Task();
+	Test_Allocate_Free();
+	Test_Ping_Pong();
+	Test_Scatter_Gather();
+
+	printf("Test_UDMA: %s\n", (failures == 0) ? "passed" : "FAILED");
+
+	return (failures == 0) ? 0 : 1;
+}
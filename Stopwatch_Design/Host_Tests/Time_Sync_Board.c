@@ -0,0 +1,40 @@
+/**
+ * @file Time_Sync_Board.c
+ *
+ * @brief One board of the time synchronization simulation in Test_Time_Sync_Boards.c.
+ *
+ * The Time_Sync driver keeps its state in static variables, so every simulated board needs its
+ * own copy of the driver. This file is compiled once per board with SIM_BOARD set to the board
+ * number. The functions of the driver and the functions it calls are renamed with the board
+ * number as a suffix (e.g. Time_Sync_Tick_1 and UART5_Send_Frame_1), so each copy is connected
+ * to the simulated UART5 link, time base and RTC of its own board.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef SIM_BOARD
+#error "SIM_BOARD must be set to the number of the simulated board"
+#endif
+
+#define SIM_CONCAT_EXPANDED(name, board)	name##_##board
+#define SIM_CONCAT(name, board)				SIM_CONCAT_EXPANDED(name, board)
+#define SIM_NAME(name)						SIM_CONCAT(name, SIM_BOARD)
+
+// Functions of the driver
+#define Time_Sync_Init						SIM_NAME(Time_Sync_Init)
+#define Time_Sync_Tick						SIM_NAME(Time_Sync_Tick)
+#define Time_Sync_Schedule_Start			SIM_NAME(Time_Sync_Schedule_Start)
+#define Time_Sync_Get_Status				SIM_NAME(Time_Sync_Get_Status)
+
+// Functions called by the driver, provided by the simulation
+#define UART5_Init							SIM_NAME(UART5_Init)
+#define UART5_Send_Frame					SIM_NAME(UART5_Send_Frame)
+#define Time_Base_Get_Time_us				SIM_NAME(Time_Base_Get_Time_us)
+#define Time_Base_Get_Rate_Trim				SIM_NAME(Time_Base_Get_Rate_Trim)
+#define Time_Base_Set_Rate_Trim				SIM_NAME(Time_Base_Set_Rate_Trim)
+#define Time_Base_Step_Ticks				SIM_NAME(Time_Base_Step_Ticks)
+#define Time_Base_Adjust_Phase				SIM_NAME(Time_Base_Adjust_Phase)
+#define Hibernation_RTC_Get					SIM_NAME(Hibernation_RTC_Get)
+#define Hibernation_RTC_Set					SIM_NAME(Hibernation_RTC_Set)
+
+#include "../Time_Sync.c"
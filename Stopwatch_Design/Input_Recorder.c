@@ -0,0 +1,263 @@
+/**
+ * @file Input_Recorder.c
+ *
+ * @brief Source code for the Input_Recorder driver.
+ *
+ * This file contains the function definitions for the Input_Recorder driver.
+ * The buttons have a lower interrupt priority than Timer 0A, so a button event always
+ * happens between two ticks. It is stored with the number of ticks that were processed
+ * before it and replayed at the end of that tick, so the deferred work it posts runs
+ * between the same two ticks as during the recording.
+ *
+ * @author Katherine Poz
+ */
+
+#include "Input_Recorder.h"
+
+static void (*Input_Recorder_PMOD_BTN_Task)(uint8_t pmod_btn_status);
+static void (*Input_Recorder_EduBase_Button_Task)(uint8_t edubase_button_status);
+static void (*Input_Recorder_Reset_Task)(void);
+static uint8_t recorder_control_mask = 0;
+
+// Event buffer
+static Input_Event recorder_events[INPUT_RECORDER_SIZE];
+static volatile uint16_t recorder_count = 0;
+static uint8_t recorder_overflow = 0x00;
+
+static volatile uint8_t recorder_state = INPUT_RECORDER_IDLE;
+
+// Number of ticks since the start of the recording or the replay
+static uint32_t recorder_ticks = 0;
+
+// Time base value at the start of the recording or the replay
+static uint64_t recorder_start_us = 0;
+
+// Index of the next event to be replayed
+static uint16_t replay_index = 0;
+
+// Time base value of the event that is being replayed
+static uint64_t replay_time_us = 0;
+
+/**
+ * @brief Resets the program state and the tick count at the start of a recording or a replay.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Input_Recorder_Restart(void)
+{
+	if (Input_Recorder_Reset_Task != 0)
+	{
+		(*Input_Recorder_Reset_Task)();
+	}
+
+	recorder_ticks = 0;
+	recorder_start_us = Time_Base_Get_Time_us();
+}
+
+/**
+ * @brief Passes the events that happened after the processed number of ticks to their tasks.
+ *
+ * The replay is done after the last event.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Input_Recorder_Replay_Events(void)
+{
+	while ((replay_index < recorder_count) && (recorder_events[replay_index].tick == recorder_ticks))
+	{
+		const Input_Event *event = &recorder_events[replay_index];
+		replay_index++;
+		replay_time_us = recorder_start_us + event->time_us;
+
+		switch (event->source)
+		{
+			case INPUT_RECORDER_PMOD_BTN:
+			{
+				(*Input_Recorder_PMOD_BTN_Task)(event->data);
+				break;
+			}
+
+			case INPUT_RECORDER_EDUBASE_BUTTON:
+			{
+				(*Input_Recorder_EduBase_Button_Task)(event->data);
+				break;
+			}
+
+			default:
+			{
+				break;
+			}
+		}
+	}
+
+	if (replay_index >= recorder_count)
+	{
+		recorder_state = INPUT_RECORDER_IDLE;
+	}
+}
+
+/**
+ * @brief Records an event and decides if it is passed to its task.
+ *
+ * @param source The source of the event.
+ *
+ * @param data The button status.
+ *
+ * @param timestamp_us The time base value of the event.
+ *
+ * @return 0x01 if the event is passed to its task, 0x00 if it is discarded during a replay.
+ */
+static uint8_t Input_Recorder_Event(uint8_t source, uint8_t data, uint64_t timestamp_us)
+{
+	uint8_t forward = 0x01;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	if (recorder_state == INPUT_RECORDER_RECORDING)
+	{
+		if (recorder_count < INPUT_RECORDER_SIZE)
+		{
+			Input_Event *event = &recorder_events[recorder_count];
+
+			event->tick = recorder_ticks;
+			event->time_us = (uint32_t)(timestamp_us - recorder_start_us);
+			event->source = source;
+			event->data = data;
+			recorder_count++;
+		}
+		else
+		{
+			recorder_overflow = 0x01;
+		}
+	}
+	else if (recorder_state == INPUT_RECORDER_REPLAYING)
+	{
+		// Live events would make the replay differ from the recording
+		forward = 0x00;
+	}
+
+	__set_PRIMASK(primask);
+
+	return forward;
+}
+
+void Input_Recorder_Init(void(*pmod_btn_task)(uint8_t), void(*edubase_button_task)(uint8_t), uint8_t control_mask, void(*reset_task)(void))
+{
+	// Store the user-defined task functions
+	Input_Recorder_PMOD_BTN_Task = pmod_btn_task;
+	Input_Recorder_EduBase_Button_Task = edubase_button_task;
+	Input_Recorder_Reset_Task = reset_task;
+	recorder_control_mask = control_mask;
+
+	recorder_state = INPUT_RECORDER_IDLE;
+	recorder_count = 0;
+	recorder_overflow = 0x00;
+}
+
+void Input_Recorder_Start_Recording(void)
+{
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	recorder_count = 0;
+	recorder_overflow = 0x00;
+	Input_Recorder_Restart();
+	recorder_state = INPUT_RECORDER_RECORDING;
+
+	__set_PRIMASK(primask);
+}
+
+void Input_Recorder_Start_Replay(void)
+{
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	replay_index = 0;
+	Input_Recorder_Restart();
+	recorder_state = INPUT_RECORDER_REPLAYING;
+
+	// Replay the events that happened before the first tick of the recording
+	Input_Recorder_Replay_Events();
+
+	__set_PRIMASK(primask);
+}
+
+void Input_Recorder_Stop(void)
+{
+	recorder_state = INPUT_RECORDER_IDLE;
+}
+
+uint8_t Input_Recorder_Get_State(void)
+{
+	return recorder_state;
+}
+
+uint16_t Input_Recorder_Get_Events(const Input_Event **events)
+{
+	*events = recorder_events;
+	return recorder_count;
+}
+
+uint8_t Input_Recorder_Load(const Input_Event *events, uint16_t count)
+{
+	if ((recorder_state != INPUT_RECORDER_IDLE) || (count > INPUT_RECORDER_SIZE))
+	{
+		return 0x00;
+	}
+
+	for (uint16_t i = 0; i < count; i++)
+	{
+		recorder_events[i] = events[i];
+	}
+	recorder_count = count;
+	recorder_overflow = 0x00;
+
+	return 0x01;
+}
+
+uint8_t Input_Recorder_Overflowed(void)
+{
+	return recorder_overflow;
+}
+
+void Input_Recorder_Tick(void)
+{
+	recorder_ticks++;
+
+	if (recorder_state == INPUT_RECORDER_REPLAYING)
+	{
+		// Replay every event that happened after this many ticks
+		Input_Recorder_Replay_Events();
+	}
+}
+
+uint64_t Input_Recorder_Get_Replay_Time_us(void)
+{
+	return replay_time_us;
+}
+
+void Input_Recorder_PMOD_BTN_Input(uint8_t pmod_btn_status)
+{
+	if (Input_Recorder_Event(INPUT_RECORDER_PMOD_BTN, pmod_btn_status, PMOD_BTN_Get_Timestamp_us()))
+	{
+		(*Input_Recorder_PMOD_BTN_Task)(pmod_btn_status);
+	}
+}
+
+void Input_Recorder_EduBase_Button_Input(uint8_t edubase_button_status)
+{
+	// Buttons that control the recorder are neither recorded nor discarded
+	if ((edubase_button_status & recorder_control_mask) != 0)
+	{
+		(*Input_Recorder_EduBase_Button_Task)(edubase_button_status);
+	}
+	else if (Input_Recorder_Event(INPUT_RECORDER_EDUBASE_BUTTON, edubase_button_status, Time_Base_Get_Time_us()))
+	{
+		(*Input_Recorder_EduBase_Button_Task)(edubase_button_status);
+	}
+}
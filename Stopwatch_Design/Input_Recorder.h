@@ -0,0 +1,189 @@
+/**
+ * @file Input_Recorder.h
+ *
+ * @brief Header file for the Input_Recorder driver.
+ *
+ * This file contains the function definitions for the Input_Recorder driver.
+ * It records the input events of the stopwatch with timestamps and replays them later:
+ *	- PMOD BTN presses (passed to the PMOD BTN task)
+ *	- EduBase push button presses (passed to the EduBase button task)
+ *
+ * The PMOD BTN and EduBase button drivers are initialized with Input_Recorder_PMOD_BTN_Input
+ * and Input_Recorder_EduBase_Button_Input as their tasks, which forward every event to the
+ * tasks of the program. Every event is stored with the number of Timer 0A ticks since the start
+ * of the recording. During a replay, each event is passed to its task from Input_Recorder_Tick at
+ * the end of the same tick, so the work that the task defers to PendSV runs after that tick and
+ * before the next one, exactly as it did during the recording. Events that happened before the
+ * first tick are passed to their tasks by Input_Recorder_Start_Replay. The state of the program
+ * is reset by a user-defined task at the start of both the recording and the replay, so a replay
+ * reproduces the recorded run tick for tick.
+ *
+ * Live input events are discarded while a replay is running.
+ *
+ * The UART5 link only carries the time synchronization, which is not recorded. Its frames
+ * carry timestamps of the moment they were sent, so replaying them would step the time base
+ * by the time between the recording and the replay. The link keeps running live during a replay.
+ *
+ * The event buffer can be read with Input_Recorder_Get_Events and loaded with Input_Recorder_Load,
+ * so a recording can be saved by a debugger or a host and replayed on another board.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef INPUT_RECORDER_H
+#define INPUT_RECORDER_H
+
+#include "TM4C123GH6PM.h"
+#include "Time_Base.h"
+#include "PMOD_BTN_Interrupt.h"
+
+// Number of events that can be recorded
+#define INPUT_RECORDER_SIZE					128
+
+// Sources of the events
+#define INPUT_RECORDER_PMOD_BTN				0x01
+#define INPUT_RECORDER_EDUBASE_BUTTON		0x02
+
+// States of the recorder
+#define INPUT_RECORDER_IDLE					0x00
+#define INPUT_RECORDER_RECORDING			0x01
+#define INPUT_RECORDER_REPLAYING			0x02
+
+typedef struct
+{
+	uint32_t tick;						// Number of ticks since the start of the recording
+	uint32_t time_us;					// Time base value since the start of the recording in microseconds
+	uint8_t source;						// INPUT_RECORDER_PMOD_BTN or INPUT_RECORDER_EDUBASE_BUTTON
+	uint8_t data;						// Button status
+} Input_Event;
+
+/**
+ * @brief Initializes the input recorder.
+ *
+ * The recorder starts in the idle state, in which every event is forwarded without being recorded.
+ *
+ * @param pmod_btn_task A pointer to the function that handles the PMOD BTN status.
+ *
+ * @param edubase_button_task A pointer to the function that handles the EduBase button status.
+ *
+ * @param control_mask EduBase button bits that control the recorder. Events that include
+ *                     these bits are always forwarded and never recorded or discarded.
+ *
+ * @param reset_task A pointer to the function that resets the state of the program
+ *                   at the start of a recording and of a replay.
+ *
+ * @return None
+ */
+void Input_Recorder_Init(void(*pmod_btn_task)(uint8_t), void(*edubase_button_task)(uint8_t), uint8_t control_mask, void(*reset_task)(void));
+
+/**
+ * @brief Clears the event buffer, resets the program state and starts recording.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Input_Recorder_Start_Recording(void);
+
+/**
+ * @brief Resets the program state and starts replaying the event buffer.
+ *
+ * The events that were recorded before the first tick are passed to their tasks immediately.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Input_Recorder_Start_Replay(void);
+
+/**
+ * @brief Stops the recording or the replay.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Input_Recorder_Stop(void);
+
+/**
+ * @brief Returns the state of the recorder.
+ *
+ * @param None
+ *
+ * @return INPUT_RECORDER_IDLE, INPUT_RECORDER_RECORDING or INPUT_RECORDER_REPLAYING.
+ */
+uint8_t Input_Recorder_Get_State(void);
+
+/**
+ * @brief Returns the recorded events.
+ *
+ * @param events Pointer that receives the address of the event buffer.
+ *
+ * @return The number of recorded events.
+ */
+uint16_t Input_Recorder_Get_Events(const Input_Event **events);
+
+/**
+ * @brief Replaces the event buffer with events that were recorded earlier.
+ *
+ * @param events Pointer to the events, ordered by time.
+ *
+ * @param count The number of events (at most INPUT_RECORDER_SIZE).
+ *
+ * @return 0x01 if the events were loaded, 0x00 if the recorder is not idle or there are too many events.
+ */
+uint8_t Input_Recorder_Load(const Input_Event *events, uint16_t count);
+
+/**
+ * @brief Returns 0x01 if events were lost because the buffer was full during the recording.
+ *
+ * @param None
+ *
+ * @return 0x01 if the recording is incomplete, otherwise 0x00.
+ */
+uint8_t Input_Recorder_Overflowed(void);
+
+/**
+ * @brief Advances the recorder by one tick and replays the events that followed the tick.
+ *
+ * This function must be called at the end of every Timer 0A interrupt, after the tick is processed.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Input_Recorder_Tick(void);
+
+/**
+ * @brief Returns the time of the event that is being replayed.
+ *
+ * The time is the time base value at the start of the replay plus the time of the event
+ * since the start of the recording, so it keeps the recorded spacing of the events within a tick.
+ * This function must be called from the task of the event during Input_Recorder_Tick
+ * or Input_Recorder_Start_Replay.
+ *
+ * @param None
+ *
+ * @return The time base value of the replayed event in microseconds.
+ */
+uint64_t Input_Recorder_Get_Replay_Time_us(void);
+
+/**
+ * @brief Task for the PMOD BTN driver that records and forwards the PMOD BTN status.
+ *
+ * @param pmod_btn_status The status of the PMOD buttons.
+ *
+ * @return None
+ */
+void Input_Recorder_PMOD_BTN_Input(uint8_t pmod_btn_status);
+
+/**
+ * @brief Task for the EduBase button driver that records and forwards the EduBase button status.
+ *
+ * @param edubase_button_status The status of the EduBase buttons.
+ *
+ * @return None
+ */
+void Input_Recorder_EduBase_Button_Input(uint8_t edubase_button_status);
+
+#endif
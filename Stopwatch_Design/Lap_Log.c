@@ -0,0 +1,493 @@
+/**
+ * @file Lap_Log.c
+ *
+ * @brief Source code for the Lap_Log driver.
+ *
+ * This file contains the function definitions for the Lap_Log driver.
+ * The log area is a ring of four 1 KB flash blocks with 64 slots of 16 bytes each.
+ * Record number N is stored in slot (slot_offset + N) % 256, where slot_offset is the
+ * slot of record 0 (the oldest record found by Lap_Log_Init). Each slot also holds a
+ * 16-bit sequence number, which identifies the newest block after a reset.
+ *
+ * The words of a slot are programmed from last to first, so a slot whose type byte is
+ * valid was programmed completely even if the power failed during the write.
+ *
+ * @author Katherine Poz
+ */
+
+#include "Lap_Log.h"
+
+// Address and size of the log area in the flash memory
+#define LAP_LOG_FLASH_ADDRESS				0x0003F000
+#define LAP_LOG_FLASH_BLOCKS				4
+#define LAP_LOG_RECORDS_PER_BLOCK		(FLASH_BLOCK_SIZE / sizeof(Lap_Log_Slot))
+
+// Record as it is stored in a flash slot
+typedef struct
+{
+	uint8_t type;						// LAP_LOG_SESSION_START or LAP_LOG_LAP (0xFF if the slot is erased)
+	uint8_t lap;
+	uint16_t session;
+	uint32_t elapsed_us;
+	uint32_t rtc_seconds;
+	uint16_t rtc_subseconds;
+	uint16_t sequence;			// Sequence number of the record
+} Lap_Log_Slot;
+
+_Static_assert(sizeof(Lap_Log_Slot) == 16, "Lap_Log_Slot must fill four flash words");
+_Static_assert((LAP_LOG_RECORDS_PER_BLOCK * LAP_LOG_FLASH_BLOCKS) == LAP_LOG_SIZE, "LAP_LOG_SIZE must match the log area");
+
+// Record numbers: oldest stored record, next record to be added,
+// next record to be programmed, and end of the erased slots
+static uint32_t oldest_record = 0;
+static uint32_t next_record = 0;
+static uint32_t flashed_record = 0;
+static uint32_t erased_end = 0;
+
+// Slot of record 0 and sequence number of record 0
+static uint32_t slot_offset = 0;
+static uint16_t sequence_offset = 0;
+
+// Records that are waiting to be programmed (record N is at index N % LAP_LOG_PENDING_SIZE)
+static Lap_Log_Slot pending_records[LAP_LOG_PENDING_SIZE];
+static uint32_t dropped_records = 0;
+
+// Ring of session index entries, numbered in the order the sessions were started
+static Lap_Session session_entries[LAP_LOG_SESSION_INDEX_SIZE];
+static uint32_t session_total = 0;
+static uint32_t session_first = 0;
+
+// Current session and the number of laps recorded in it
+static uint16_t current_session = 0;
+static uint8_t current_lap = 0;
+
+/**
+ * @brief Returns a pointer to the flash slot of a record.
+ *
+ * @param number The record number.
+ *
+ * @return Pointer to the slot.
+ */
+static const Lap_Log_Slot *Lap_Log_Slot_Address(uint32_t number)
+{
+	return (const Lap_Log_Slot *)LAP_LOG_FLASH_ADDRESS + ((slot_offset + number) % LAP_LOG_SIZE);
+}
+
+/**
+ * @brief Checks if a slot holds a valid record.
+ *
+ * @param slot Pointer to the slot.
+ *
+ * @return 0x01 if the slot holds a session start or lap record, otherwise 0x00.
+ */
+static uint8_t Lap_Log_Slot_Valid(const Lap_Log_Slot *slot)
+{
+	return ((slot->type == LAP_LOG_SESSION_START) || (slot->type == LAP_LOG_LAP)) ? 0x01 : 0x00;
+}
+
+/**
+ * @brief Checks if every word of a slot is erased.
+ *
+ * @param slot Pointer to the slot.
+ *
+ * @return 0x01 if the slot is erased, otherwise 0x00.
+ */
+static uint8_t Lap_Log_Slot_Erased(const Lap_Log_Slot *slot)
+{
+	const uint32_t *words = (const uint32_t *)slot;
+
+	for (uint8_t i = 0; i < (sizeof(Lap_Log_Slot) / 4); i++)
+	{
+		if (words[i] != FLASH_ERASED_WORD)
+		{
+			return 0x00;
+		}
+	}
+
+	return 0x01;
+}
+
+/**
+ * @brief Adds a record to the session index.
+ *
+ * A lap record updates the most recent session if it directly follows that session's
+ * earlier records. Lap records of sessions that are not in the index are ignored.
+ *
+ * @param slot Pointer to the record.
+ *
+ * @param number The record number.
+ *
+ * @return None
+ */
+static void Lap_Log_Index_Add(const Lap_Log_Slot *slot, uint32_t number)
+{
+	if (slot->type == LAP_LOG_SESSION_START)
+	{
+		Lap_Session *entry = &session_entries[session_total & (LAP_LOG_SESSION_INDEX_SIZE - 1)];
+
+		entry->session = slot->session;
+		entry->lap_count = 0;
+		entry->best_lap = 0;
+		entry->best_lap_us = 0;
+		entry->last_elapsed_us = slot->elapsed_us;
+		entry->first_record = number;
+
+		session_total++;
+		if ((session_total - session_first) > LAP_LOG_SESSION_INDEX_SIZE)
+		{
+			session_first = session_total - LAP_LOG_SESSION_INDEX_SIZE;
+		}
+	}
+	else if ((slot->type == LAP_LOG_LAP) && (session_total != session_first))
+	{
+		Lap_Session *entry = &session_entries[(session_total - 1) & (LAP_LOG_SESSION_INDEX_SIZE - 1)];
+
+		if ((entry->session == slot->session) && ((entry->first_record + slot->lap) == number))
+		{
+			uint32_t lap_us = slot->elapsed_us - entry->last_elapsed_us;
+
+			if ((entry->best_lap == 0) || (lap_us < entry->best_lap_us))
+			{
+				entry->best_lap = slot->lap;
+				entry->best_lap_us = lap_us;
+			}
+
+			entry->lap_count = slot->lap;
+			entry->last_elapsed_us = slot->elapsed_us;
+		}
+	}
+}
+
+/**
+ * @brief Copies a record into the public record structure.
+ *
+ * @param number The record number.
+ *
+ * @param record Pointer to the structure that receives the record.
+ *
+ * @return 0x01 if the record is valid, otherwise 0x00.
+ */
+static uint8_t Lap_Log_Read(uint32_t number, Lap_Record *record)
+{
+	uint8_t valid = 0x00;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	if ((number >= oldest_record) && (number < next_record))
+	{
+		const Lap_Log_Slot *slot = (number >= flashed_record) ?
+			&pending_records[number & (LAP_LOG_PENDING_SIZE - 1)] : Lap_Log_Slot_Address(number);
+
+		if (Lap_Log_Slot_Valid(slot))
+		{
+			record->type = slot->type;
+			record->lap = slot->lap;
+			record->session = slot->session;
+			record->elapsed_us = slot->elapsed_us;
+			record->rtc.seconds = slot->rtc_seconds;
+			record->rtc.subseconds = slot->rtc_subseconds;
+			valid = 0x01;
+		}
+	}
+
+	__set_PRIMASK(primask);
+
+	return valid;
+}
+
+/**
+ * @brief Numbers a record and queues it with the current RTC time.
+ *
+ * A session start record starts the next session, and a lap record gets the next lap
+ * number of the current session. Lap records are not stored once a session is full.
+ *
+ * @param type The record type.
+ *
+ * @param elapsed_us The stopwatch time of the record in microseconds.
+ *
+ * @return The session number of a session start record, the lap number of a lap record,
+ * or 0 if the session is full.
+ */
+static uint16_t Lap_Log_Store(uint8_t type, uint32_t elapsed_us)
+{
+	uint16_t number;
+
+	// Records can be added from several interrupts, so they are numbered and queued together
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	if (type == LAP_LOG_SESSION_START)
+	{
+		current_session++;
+		current_lap = 0;
+		number = current_session;
+	}
+	else if (current_lap < LAP_LOG_MAX_LAPS)
+	{
+		current_lap++;
+		number = current_lap;
+	}
+	else
+	{
+		__set_PRIMASK(primask);
+		return 0;
+	}
+
+	if ((next_record - flashed_record) >= LAP_LOG_PENDING_SIZE)
+	{
+		dropped_records++;
+	}
+	else
+	{
+		Lap_Log_Slot *slot = &pending_records[next_record & (LAP_LOG_PENDING_SIZE - 1)];
+		Hibernation_RTC_Time rtc = Hibernation_RTC_Get();
+
+		slot->type = type;
+		slot->lap = current_lap;
+		slot->session = current_session;
+		slot->elapsed_us = elapsed_us;
+		slot->rtc_seconds = rtc.seconds;
+		slot->rtc_subseconds = rtc.subseconds;
+		slot->sequence = (uint16_t)(sequence_offset + next_record);
+
+		Lap_Log_Index_Add(slot, next_record);
+		next_record++;
+	}
+
+	__set_PRIMASK(primask);
+
+	return number;
+}
+
+/**
+ * @brief Erases the next flash block after the erased slots.
+ *
+ * The records that were stored in the block are removed from the log,
+ * and the sessions that started in those records are removed from the index.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Lap_Log_Erase_Next_Block(void)
+{
+	uint32_t address = (uintptr_t)Lap_Log_Slot_Address(erased_end);
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	// Remove the records of the block from the log before it is erased
+	// The block holds the records that are LAP_LOG_SIZE numbers before the slots to be erased
+	uint32_t block_end = erased_end + LAP_LOG_RECORDS_PER_BLOCK;
+	if ((block_end > LAP_LOG_SIZE) && ((block_end - LAP_LOG_SIZE) > oldest_record))
+	{
+		oldest_record = block_end - LAP_LOG_SIZE;
+	}
+
+	while ((session_first != session_total) &&
+	       (session_entries[session_first & (LAP_LOG_SESSION_INDEX_SIZE - 1)].first_record < oldest_record))
+	{
+		session_first++;
+	}
+
+	// Instructions cannot be fetched while the block is erased, so Timer 0A can only keep
+	// one of the time-outs of the stall pending. The lost ticks are added to the time base
+	// before the interrupts are enabled again, so no interrupt reads the time base behind.
+	Time_Base_Begin_Stall();
+	Flash_Erase_Block(address);
+	Time_Base_End_Stall();
+
+	__set_PRIMASK(primask);
+
+	erased_end = block_end;
+}
+
+void Lap_Log_Init(void)
+{
+	int32_t newest_block = -1;
+	uint16_t newest_sequence = 0;
+	uint8_t block_used[LAP_LOG_FLASH_BLOCKS];
+
+	oldest_record = 0;
+	next_record = 0;
+	flashed_record = 0;
+	session_total = 0;
+	session_first = 0;
+	current_session = 0;
+	current_lap = 0;
+
+	// Find the used blocks and the newest block from the first slot of every block.
+	// Only a block whose first slot holds a valid record is used. A first slot can also be torn
+	// (the power failed while it was programmed, so its type byte is still erased) or hold other data.
+	// Such a block is skipped, and it is erased by Lap_Log_Service before records are programmed into it.
+	for (uint8_t block = 0; block < LAP_LOG_FLASH_BLOCKS; block++)
+	{
+		const Lap_Log_Slot *first = (const Lap_Log_Slot *)LAP_LOG_FLASH_ADDRESS + (block * LAP_LOG_RECORDS_PER_BLOCK);
+
+		block_used[block] = Lap_Log_Slot_Valid(first);
+
+		if (block_used[block] && ((newest_block < 0) || ((int16_t)(first->sequence - newest_sequence) > 0)))
+		{
+			newest_block = block;
+			newest_sequence = first->sequence;
+		}
+	}
+
+	if (newest_block < 0)
+	{
+		// Erase the whole log area. This is only done when no block starts with a valid record.
+		for (uint8_t block = 0; block < LAP_LOG_FLASH_BLOCKS; block++)
+		{
+			Flash_Erase_Block(LAP_LOG_FLASH_ADDRESS + (block * FLASH_BLOCK_SIZE));
+		}
+
+		slot_offset = 0;
+		sequence_offset = 0;
+		erased_end = LAP_LOG_SIZE;
+		return;
+	}
+
+	// The oldest block is the first used block after the newest block
+	uint8_t oldest_block = (uint8_t)newest_block;
+	for (uint8_t i = 1; i < LAP_LOG_FLASH_BLOCKS; i++)
+	{
+		uint8_t block = (uint8_t)((newest_block + i) % LAP_LOG_FLASH_BLOCKS);
+		if (block_used[block])
+		{
+			oldest_block = block;
+			break;
+		}
+	}
+
+	slot_offset = oldest_block * LAP_LOG_RECORDS_PER_BLOCK;
+	sequence_offset = ((const Lap_Log_Slot *)LAP_LOG_FLASH_ADDRESS + slot_offset)->sequence;
+
+	// Read every record once from the oldest to the newest and rebuild the index.
+	// Every slot of the older blocks keeps its record number, even if it is not valid,
+	// so that record N stays in slot (slot_offset + N). The newest block ends at its first erased slot.
+	uint8_t block = oldest_block;
+	while (1)
+	{
+		for (uint32_t i = 0; i < LAP_LOG_RECORDS_PER_BLOCK; i++)
+		{
+			const Lap_Log_Slot *slot = Lap_Log_Slot_Address(next_record);
+
+			if ((block == newest_block) && Lap_Log_Slot_Erased(slot))
+			{
+				break;
+			}
+
+			if (Lap_Log_Slot_Valid(slot))
+			{
+				Lap_Log_Index_Add(slot, next_record);
+				current_session = slot->session;
+				current_lap = slot->lap;
+			}
+			next_record++;
+		}
+
+		if (block == newest_block)
+		{
+			break;
+		}
+		block = (uint8_t)((block + 1) % LAP_LOG_FLASH_BLOCKS);
+	}
+
+	flashed_record = next_record;
+
+	// The rest of the newest block is erased. If it is full, the next block
+	// is erased by Lap_Log_Service before new records are programmed.
+	uint32_t used_slots = (slot_offset + next_record) % LAP_LOG_RECORDS_PER_BLOCK;
+	erased_end = (used_slots != 0) ? (next_record + LAP_LOG_RECORDS_PER_BLOCK - used_slots) : next_record;
+}
+
+uint16_t Lap_Log_Start_Session(void)
+{
+	return Lap_Log_Store(LAP_LOG_SESSION_START, 0);
+}
+
+uint8_t Lap_Log_Add_Lap(uint32_t elapsed_us)
+{
+	return (uint8_t)Lap_Log_Store(LAP_LOG_LAP, elapsed_us);
+}
+
+void Lap_Log_Service(uint8_t erase_allowed)
+{
+	// Program the queued records into the erased slots
+	while ((flashed_record != next_record) && (flashed_record < erased_end))
+	{
+		const uint32_t *words = (const uint32_t *)&pending_records[flashed_record & (LAP_LOG_PENDING_SIZE - 1)];
+		uint32_t address = (uintptr_t)Lap_Log_Slot_Address(flashed_record);
+
+		// Program the type byte (first word) last
+		for (int8_t i = (sizeof(Lap_Log_Slot) / 4) - 1; i >= 0; i--)
+		{
+			Flash_Write_Word(address + (i * 4), words[i]);
+		}
+
+		// The record is read from the flash memory from now on
+		flashed_record++;
+	}
+
+	// Keep at least one erased block ahead of the queued records
+	if ((erase_allowed != 0x00) && ((erased_end - next_record) < LAP_LOG_RECORDS_PER_BLOCK))
+	{
+		Lap_Log_Erase_Next_Block();
+	}
+}
+
+uint16_t Lap_Log_Count(void)
+{
+	return (uint16_t)(next_record - oldest_record);
+}
+
+uint8_t Lap_Log_Get(uint16_t index, Lap_Record *record)
+{
+	if (index >= Lap_Log_Count())
+	{
+		return 0x00;
+	}
+
+	return Lap_Log_Read(next_record - 1 - index, record);
+}
+
+uint16_t Lap_Log_Session_Count(void)
+{
+	return (uint16_t)(session_total - session_first);
+}
+
+uint8_t Lap_Log_Get_Session(uint16_t index, Lap_Session *session)
+{
+	uint8_t found = 0x00;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	if (index < (session_total - session_first))
+	{
+		*session = session_entries[(session_total - 1 - index) & (LAP_LOG_SESSION_INDEX_SIZE - 1)];
+		found = 0x01;
+	}
+
+	__set_PRIMASK(primask);
+
+	return found;
+}
+
+uint8_t Lap_Log_Get_Lap(uint16_t session_index, uint8_t lap, Lap_Record *record)
+{
+	Lap_Session session;
+
+	if ((Lap_Log_Get_Session(session_index, &session) == 0x00) || (lap > session.lap_count))
+	{
+		return 0x00;
+	}
+
+	return Lap_Log_Read(session.first_record + lap, record);
+}
+
+uint32_t Lap_Log_Get_Dropped(void)
+{
+	return dropped_records;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file Lap_Log.h
+ *
+ * @brief Header file for the Lap_Log driver.
+ *
+ * This file contains the function definitions for the Lap_Log driver.
+ * It stores session and lap records in the last 4 KB of the flash memory, so the history
+ * is kept across resets and power cycles. Every record is timestamped with the time of day
+ * from the Hibernation module RTC, so a logged lap can be tied to when the race happened.
+ *
+ * Records are numbered in the order they were added. A session start record is followed by
+ * the lap records of that session, so lap N of a session is the record N places after its start.
+ * A RAM index of the most recent sessions holds the record number of each session start, the
+ * number of laps, and the best lap. It is updated as records are added and rebuilt from the flash
+ * memory in a single pass by Lap_Log_Init, so the sessions, their laps and the most recent
+ * records can be read in constant time without scanning the log.
+ *
+ * New records are queued in RAM and programmed into the flash memory by Lap_Log_Service from
+ * the main loop. When the log is full, the block with the oldest 64 records is erased. The Timer 0A
+ * ticks that are lost while the processor is stalled by the erase are added back to the time base.
+ *
+ * @note The flash memory from 0x0003F000 to 0x0003FFFF is reserved for the log and must not be
+ * used by the program (the IROM1 size of the project is 0x3F000).
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef LAP_LOG_H
+#define LAP_LOG_H
+
+#include "TM4C123GH6PM.h"
+#include "Hibernation_RTC.h"
+#include "Flash.h"
+#include "Time_Base.h"
+
+// Number of records that can be stored
+#define LAP_LOG_SIZE						256
+
+// Number of sessions in the RAM index (must be a power of two)
+#define LAP_LOG_SESSION_INDEX_SIZE		32
+
+// Number of records that can wait in RAM to be programmed into the flash memory (must be a power of two)
+#define LAP_LOG_PENDING_SIZE				8
+
+// Maximum number of laps that are recorded in a session
+#define LAP_LOG_MAX_LAPS					255
+
+// Record types
+#define LAP_LOG_SESSION_START		0x01
+#define LAP_LOG_LAP							0x02
+
+typedef struct
+{
+	uint8_t type;						// LAP_LOG_SESSION_START or LAP_LOG_LAP
+	uint8_t lap;						// Lap number within the session (0 for the session start)
+	uint16_t session;				// Session number
+	uint32_t elapsed_us;		// Stopwatch time of the record in microseconds
+	Hibernation_RTC_Time rtc;	// RTC time when the record was created
+} Lap_Record;
+
+typedef struct
+{
+	uint16_t session;				// Session number
+	uint8_t lap_count;			// Number of laps recorded in the session
+	uint8_t best_lap;				// Number of the shortest lap (0 if there are no laps)
+	uint32_t best_lap_us;		// Duration of the shortest lap in microseconds
+	uint32_t last_elapsed_us;	// Stopwatch time of the last lap in microseconds
+	uint32_t first_record;	// Record number of the session start
+} Lap_Session;
+
+/**
+ * @brief Rebuilds the session index and the current session from the records in the flash memory.
+ *
+ * The flash memory is read in a single pass. Blocks whose first slot is torn or invalid are skipped.
+ * If no block starts with a valid record, the log area is erased. Hibernation_RTC_Init must be called first.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Lap_Log_Init(void);
+
+/**
+ * @brief Starts a new session and stores a session start record.
+ *
+ * @param None
+ *
+ * @return The number of the new session.
+ */
+uint16_t Lap_Log_Start_Session(void);
+
+/**
+ * @brief Stores a lap record for the current session.
+ *
+ * At most LAP_LOG_MAX_LAPS laps are recorded in a session. Further laps are not stored.
+ *
+ * @param elapsed_us The stopwatch time of the lap in microseconds.
+ *
+ * @return The number of the lap within the current session, or 0 if the session is full.
+ */
+uint8_t Lap_Log_Add_Lap(uint32_t elapsed_us);
+
+/**
+ * @brief Programs the queued records into the flash memory and prepares space for new records.
+ *
+ * This function must be called from the main loop. Erasing a block stalls the processor
+ * for several milliseconds, so it is only done when allowed by the caller. The erase is done
+ * with interrupts disabled, and the Timer 0A ticks that are lost during the stall are added
+ * to the time base before any interrupt reads it.
+ *
+ * @param erase_allowed 0x01 if a block may be erased (e.g. while the stopwatch is stopped), otherwise 0x00.
+ *
+ * @return None
+ */
+void Lap_Log_Service(uint8_t erase_allowed);
+
+/**
+ * @brief Returns the number of records that are stored in the log.
+ *
+ * @param None
+ *
+ * @return The number of records (at most LAP_LOG_SIZE).
+ */
+uint16_t Lap_Log_Count(void);
+
+/**
+ * @brief Reads a record from the log.
+ *
+ * @param index The index of the record, where 0 is the most recent record.
+ *
+ * @param record Pointer to the structure that receives the record.
+ *
+ * @return 0x01 if the record exists, otherwise 0x00.
+ */
+uint8_t Lap_Log_Get(uint16_t index, Lap_Record *record);
+
+/**
+ * @brief Returns the number of sessions in the index whose session start record is still stored.
+ *
+ * @param None
+ *
+ * @return The number of sessions (at most LAP_LOG_SESSION_INDEX_SIZE).
+ */
+uint16_t Lap_Log_Session_Count(void);
+
+/**
+ * @brief Reads the index entry of a session.
+ *
+ * @param index The index of the session, where 0 is the most recent session.
+ *
+ * @param session Pointer to the structure that receives the index entry.
+ *
+ * @return 0x01 if the session exists, otherwise 0x00.
+ */
+uint8_t Lap_Log_Get_Session(uint16_t index, Lap_Session *session);
+
+/**
+ * @brief Reads one record of a session.
+ *
+ * @param session_index The index of the session, where 0 is the most recent session.
+ *
+ * @param lap The lap number within the session (0 for the session start record).
+ *
+ * @param record Pointer to the structure that receives the record.
+ *
+ * @return 0x01 if the record exists, otherwise 0x00.
+ */
+uint8_t Lap_Log_Get_Lap(uint16_t session_index, uint8_t lap, Lap_Record *record);
+
+/**
+ * @brief Returns the number of records that were lost because the RAM queue was full.
+ *
+ * @param None
+ *
+ * @return The number of lost records.
+ */
+uint32_t Lap_Log_Get_Dropped(void);
+
+#endif
@@ -13,6 +13,10 @@
  * It configures the pins to trigger interrupts on rising edges. The PMOD BTN
  * push buttons operate in an active high configuration.
  *
+ * The time base is latched at the start of the interrupt handler and corrected for the
+ * interrupt entry latency, so every button press is timestamped with microsecond resolution
+ * independently of the 1 ms Timer 0A tick.
+ *
  * @author Aaron Nanas
  */
  
@@ -21,30 +25,25 @@
 // Declare pointer to the user-defined task
 void (*PMOD_BTN_Task)(uint8_t pmod_btn_state);
 
+// Number of system clock cycles that the GPIO input synchronizer delays an edge
+#define PMOD_BTN_SYNC_CYCLES 2
+
+// Cycles from the rising edge until the time base is latched in the interrupt handler
+static uint32_t PMOD_BTN_Latency_Cycles = 0;
+
+// Time of the most recent button press in microseconds
+static uint64_t PMOD_BTN_Timestamp_us = 0;
+
 void PMOD_BTN_Interrupt_Init(void(*task)(uint8_t))
 {
 	// Store the user-defined task function for use during interrupt handling
 	PMOD_BTN_Task = task;
 	
-	// Enable the clock to Port A by setting the
-	// R0 bit (Bit 0) in the RCGCGPIO register
-	SYSCTL->RCGCGPIO |= 0x01;
-	
-	// Configure the PA5, PA4, PA3, and PA2 pins as input
-	// by clearing Bits 5 to 2 in the DIR register
-	GPIOA->DIR &= ~0x3C;
-	
-	// Configure the PA5, PA4, PA3, and PA2 pins to function as
-	// GPIO pins by clearing Bits 5 to 2 in the AFSEL register
-	GPIOA->AFSEL &= ~0x3C;
+	// Add the measured interrupt entry latency to the delay of the input synchronizer
+	PMOD_BTN_Latency_Cycles = PMOD_BTN_SYNC_CYCLES + SysTick_Delay_Get_ISR_Entry_Cycles();
 	
-	// Enable the digital functionality for the PA5, PA4, PA3, and PA2 pins
-	// by setting Bits 5 to 2 in the DEN register
-	GPIOA->DEN |= 0x3C;
-	
-	// Enable the weak pull-down resistor for the PA5, PA4, PA3, and PA2 pins
-	// by setting Bits 5 to 2 in the PDR register
-	GPIOA->PDR |= 0x3C;
+	// The PA5, PA4, PA3, and PA2 pins are configured as inputs with
+	// weak pull-down resistors by Board_Pins_Init
 	
 	// Configure the PA5, PA4, PA3, and PA2 pins to detect edges
 	// by clearing Bits 5 to 2 in the IS register
@@ -90,12 +89,23 @@ uint8_t PMOD_BTN_Read(void)
 	return pmod_btn_state;
 }
 
+uint64_t PMOD_BTN_Get_Timestamp_us(void)
+{
+	return PMOD_BTN_Timestamp_us;
+}
+
 void GPIOA_Handler(void)
 {
+	// Latch the time base first and correct it for the time it took to get here
+	uint64_t timestamp_us = Time_Base_Get_Event_Time_us(PMOD_BTN_Latency_Cycles);
+	
 	//Check if an interrupt has been triggered by any of
 	// the following pins: PA5, PA4, PA3, and PA2
 	if (GPIOA->MIS & 0x3C)
 	{
+		// Store the time of the button press for the user-defined function
+		PMOD_BTN_Timestamp_us = timestamp_us;
+		
 		//Execute the user-defined function
 		(*PMOD_BTN_Task)(PMOD_BTN_Read());
 		
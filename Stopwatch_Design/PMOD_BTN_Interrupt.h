@@ -13,10 +13,16 @@
  * It configures the pins to trigger interrupts on rising edges. The PMOD BTN
  * push buttons operate in an active high configuration.
  *
+ * The time base is latched at the start of the interrupt handler and corrected for the
+ * interrupt entry latency, so every button press is timestamped with microsecond resolution
+ * independently of the 1 ms Timer 0A tick.
+ *
  * @author Aaron Nanas
  */
 
 #include "TM4C123GH6PM.h"
+#include "Time_Base.h"
+#include "SysTick_Delay.h"
 
 // Declare pointer to the user-defined task
 extern void (*PMOD_BTN_Task)(uint8_t pmod_btn_state);
@@ -35,6 +41,9 @@ extern void (*PMOD_BTN_Task)(uint8_t pmod_btn_state);
  * When an interrupt occurs, the provided task function is executed with the current button status.
  * Interrupt priority is set to 3 for GPIO Port A.
  *
+ * @note SysTick_Delay_Init must be called first, since the measured interrupt entry latency
+ * is used to correct the timestamps of the button presses.
+ *
  * @param task A pointer to the user-defined function to be executed upon button interrupts.
  *
  * @return None
@@ -52,6 +61,17 @@ void PMOD_BTN_Interrupt_Init(void(*task)(uint8_t));
  */
 uint8_t PMOD_BTN_Read(void);
 
+/**
+ * @brief Returns the time of the most recent button press.
+ *
+ * The value is valid within the user-defined task for the press that is being handled.
+ *
+ * @param None
+ *
+ * @return The time base value of the rising edge in microseconds.
+ */
+uint64_t PMOD_BTN_Get_Timestamp_us(void);
+
 /**
  * @brief The interrupt service routine (ISR) for GPIO Port A.
  *
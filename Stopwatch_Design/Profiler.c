@@ -0,0 +1,92 @@
+/**
+ * @file Profiler.c
+ *
+ * @brief Source code for the Profiler driver.
+ *
+ * This file contains the function definitions for the Profiler driver.
+ * The samples are taken by a frame handler of the GPTM driver, which receives the exception
+ * frame of the Wide Timer 5A interrupt. The stacked PC is the seventh word of the frame,
+ * with or without the floating-point registers.
+ *
+ * @author Katherine Poz
+ */
+
+#include "Profiler.h"
+
+volatile Profiler_Dump profiler_dump;
+
+/**
+ * @brief Counts one sample of the interrupted code.
+ *
+ * @param frame Pointer to the exception frame of the Wide Timer 5A interrupt.
+ *
+ * @return None
+ */
+static void Profiler_Sample(const uint32_t *frame)
+{
+	// Clear the time-out interrupt (TATOCINT, Bit 0)
+	WTIMER5->ICR = 0x01;
+
+	uint32_t bucket = frame[6] >> PROFILER_BUCKET_SHIFT;
+
+	profiler_dump.samples++;
+
+	if (bucket < PROFILER_BUCKET_COUNT)
+	{
+		profiler_dump.histogram[bucket]++;
+	}
+	else
+	{
+		profiler_dump.outside++;
+	}
+}
+
+void Profiler_Init(uint32_t rate_hz)
+{
+	Profiler_Clear();
+
+	profiler_dump.magic = PROFILER_MAGIC;
+	profiler_dump.bucket_shift = PROFILER_BUCKET_SHIFT;
+	profiler_dump.bucket_count = PROFILER_BUCKET_COUNT;
+	profiler_dump.rate_hz = rate_hz;
+}
+
+void Profiler_Start(void)
+{
+	// Configure Wide Timer 5 as a 64-bit periodic timer without a GPTM task
+	GPTM_Init_Periodic(GPTM_WTIMER5, PROFILER_SYSTEM_CLOCK_HZ / profiler_dump.rate_hz, 0, 0);
+
+	// Take the samples from the exception frame of the Wide Timer 5A interrupt
+	GPTM_Set_WTIMER5A_Frame_Handler(&Profiler_Sample);
+
+	// Enable the time-out interrupt (TATOIM, Bit 0), which is handled by Profiler_Sample
+	WTIMER5->IMR |= 0x01;
+
+	// Set the priority level to 0, so the samples include every other interrupt handler
+	NVIC_SetPriority(WTIMER5A_IRQn, 0);
+	NVIC_EnableIRQ(WTIMER5A_IRQn);
+
+	GPTM_Enable(GPTM_WTIMER5, GPTM_TIMER_A);
+}
+
+void Profiler_Stop(void)
+{
+	// Stop sampling and release the clock of Wide Timer 5
+	GPTM_Deinit(GPTM_WTIMER5);
+}
+
+void Profiler_Clear(void)
+{
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	profiler_dump.samples = 0;
+	profiler_dump.outside = 0;
+
+	for (uint32_t i = 0; i < PROFILER_BUCKET_COUNT; i++)
+	{
+		profiler_dump.histogram[i] = 0;
+	}
+
+	__set_PRIMASK(primask);
+}
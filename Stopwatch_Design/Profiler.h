@@ -0,0 +1,107 @@
+/**
+ * @file Profiler.h
+ *
+ * @brief Header file for the Profiler driver.
+ *
+ * This file contains the function definitions for the Profiler driver.
+ * It periodically samples the program counter (PC) of the interrupted code and counts
+ * the samples in a histogram over the flash memory. Wide Timer 5A runs in the 64-bit periodic
+ * mode with the priority level 0, so it preempts every other interrupt, and its handler reads
+ * the PC from the exception frame that was stacked on entry.
+ *
+ * Each bucket of the histogram covers PROFILER_BUCKET_SIZE bytes of code starting at address 0x0.
+ * Samples outside of the histogram range are counted separately. The histogram and its layout
+ * are kept in one structure (profiler_dump). Its address is listed in the linker map, and the
+ * 0x1018 bytes from that address can be saved with the debugger, e.g. for 0x20000400:
+ *
+ *	SAVE profile.hex 0x20000400, 0x20001417
+ *
+ * The dump is symbolized on the host by Profiler_Symbolize.py with the linker map
+ * (Listings/Stopwatch_Design.map) or the image (Objects/Stopwatch_Design.axf), which prints
+ * a flat profile of the sampled functions.
+ *
+ * @note Code that runs with interrupts disabled cannot be sampled. Its samples are attributed
+ * to the instruction at which interrupts are enabled again.
+ *
+ * @note The sampling rate should not be a multiple of the rate of another periodic interrupt
+ * (e.g. the 1 kHz Timer 0A interrupt), otherwise the samples are correlated with it.
+ *
+ * @note Wide Timer 5 must not be used by any other driver while the profiler is initialized.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "TM4C123GH6PM.h"
+#include "GPTM.h"
+
+// Identifies a valid dump for the host tool ("PROF")
+#define PROFILER_MAGIC						0x464F5250
+
+// Each bucket covers 2^PROFILER_BUCKET_SHIFT bytes of code
+#define PROFILER_BUCKET_SHIFT				4
+#define PROFILER_BUCKET_SIZE				(1U << PROFILER_BUCKET_SHIFT)
+
+// Number of buckets (the histogram covers PROFILER_BUCKET_COUNT * PROFILER_BUCKET_SIZE bytes)
+#define PROFILER_BUCKET_COUNT				1024
+
+// System clock frequency in Hz
+#define PROFILER_SYSTEM_CLOCK_HZ			50000000
+
+typedef struct
+{
+	uint32_t magic;							// PROFILER_MAGIC
+	uint32_t bucket_shift;					// PROFILER_BUCKET_SHIFT
+	uint32_t bucket_count;					// PROFILER_BUCKET_COUNT
+	uint32_t rate_hz;						// Sampling rate in Hz
+	uint32_t samples;						// Total number of samples
+	uint32_t outside;						// Samples with a PC outside of the histogram range
+	uint32_t histogram[PROFILER_BUCKET_COUNT];
+} Profiler_Dump;
+
+// Histogram and layout, read by the debugger and the host tool
+extern volatile Profiler_Dump profiler_dump;
+
+/**
+ * @brief Initializes the profiler.
+ *
+ * The histogram is cleared and the sampling rate is stored. Wide Timer 5 is not used until Profiler_Start is called.
+ *
+ * @param rate_hz The sampling rate in Hz (e.g. 997).
+ *
+ * @return None
+ */
+void Profiler_Init(uint32_t rate_hz);
+
+/**
+ * @brief Configures Wide Timer 5A as the sampling timer and starts sampling.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Profiler_Start(void);
+
+/**
+ * @brief Stops sampling and releases Wide Timer 5, so its clock is gated.
+ *
+ * The histogram is kept until Profiler_Clear is called.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Profiler_Stop(void);
+
+/**
+ * @brief Clears the histogram and the sample counters.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Profiler_Clear(void);
+
+#endif
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""
+@file Profiler_Symbolize.py
+
+@brief Prints a flat profile from a dump of the Profiler histogram.
+
+The dump is the Profiler_Dump structure (profiler_dump) saved with the debugger, either as
+an Intel HEX file (SAVE command) or as a raw binary file. The functions are read from the
+Image Symbol Table of the linker map (Listings/Stopwatch_Design.map) or from the symbol
+table of the image (Objects/Stopwatch_Design.axf).
+
+Each bucket is attributed to the function that contains its first address (or that starts
+within it after padding), so functions smaller than a bucket can share the samples of their
+neighbours.
+
+usage: Profiler_Symbolize.py dump.hex Listings/Stopwatch_Design.map
+       Profiler_Symbolize.py dump.bin Objects/Stopwatch_Design.axf
+
+@author Katherine Poz
+"""
+
+import bisect
+import re
+import struct
+import sys
+
+PROFILER_MAGIC = 0x464F5250
+HEADER_FORMAT = "<6I"
+
+
+def read_dump(path):
+	"""Returns the bytes of the dump from an Intel HEX or a raw binary file."""
+	with open(path, "rb") as f:
+		data = f.read()
+
+	if not data.startswith(b":"):
+		return data
+
+	memory = {}
+	upper = 0
+	for line in data.decode("ascii").split():
+		record = bytes.fromhex(line[1:])
+		count, address, kind = record[0], (record[1] << 8) | record[2], record[3]
+		payload = record[4:4 + count]
+		if kind == 0x00:
+			for i, value in enumerate(payload):
+				memory[upper + address + i] = value
+		elif kind == 0x02:
+			upper = ((payload[0] << 8) | payload[1]) << 4
+		elif kind == 0x04:
+			upper = ((payload[0] << 8) | payload[1]) << 16
+		elif kind == 0x01:
+			break
+
+	base = min(memory)
+	return bytes(memory.get(base + i, 0) for i in range(max(memory) - base + 1))
+
+
+def parse_dump(data):
+	"""Returns the sampling rate, the number of samples outside the histogram and the histogram."""
+	header_size = struct.calcsize(HEADER_FORMAT)
+	magic, shift, count, rate_hz, samples, outside = struct.unpack_from(HEADER_FORMAT, data)
+	if magic != PROFILER_MAGIC:
+		sys.exit("not a profiler dump (magic 0x%08X)" % magic)
+	if len(data) < header_size + 4 * count:
+		sys.exit("dump is truncated (%d of %d bytes)" % (len(data), header_size + 4 * count))
+
+	histogram = struct.unpack_from("<%dI" % count, data, header_size)
+	return shift, rate_hz, samples, outside, histogram
+
+
+def read_map_symbols(path):
+	"""Returns (address, size, name) of every code symbol in the Image Symbol Table of a linker map."""
+	pattern = re.compile(r"^\s+(\S+)\s+0x([0-9a-fA-F]+)\s+(?:Thumb|ARM) Code\s+(\d+)")
+	symbols = []
+	with open(path) as f:
+		for line in f:
+			match = pattern.match(line)
+			if match:
+				symbols.append((int(match.group(2), 16) & ~1, int(match.group(3)), match.group(1)))
+	return symbols
+
+
+def read_elf_symbols(path):
+	"""Returns (address, size, name) of every function in the symbol table of an ELF32 image."""
+	with open(path, "rb") as f:
+		elf = f.read()
+
+	if elf[:4] != b"\x7fELF" or elf[4] != 1:
+		sys.exit("%s is not an ELF32 file" % path)
+
+	shoff, = struct.unpack_from("<I", elf, 0x20)
+	shentsize, shnum = struct.unpack_from("<HH", elf, 0x2E)
+	sections = [struct.unpack_from("<10I", elf, shoff + i * shentsize) for i in range(shnum)]
+
+	symbols = []
+	for section in sections:
+		# SHT_SYMTAB
+		if section[1] != 2:
+			continue
+		strtab = sections[section[6]]
+		for offset in range(section[4], section[4] + section[5], 16):
+			name, value, size, info = struct.unpack_from("<IIIB", elf, offset)
+			# STT_FUNC
+			if (info & 0x0F) != 2:
+				continue
+			start = strtab[4] + name
+			symbol_name = elf[start:elf.index(b"\x00", start)].decode("ascii")
+			symbols.append((value & ~1, size, symbol_name))
+	return symbols
+
+
+def main():
+	if len(sys.argv) != 3:
+		sys.exit("usage: Profiler_Symbolize.py <dump.hex|dump.bin> <image.map|image.axf>")
+
+	shift, rate_hz, samples, outside, histogram = parse_dump(read_dump(sys.argv[1]))
+
+	if sys.argv[2].endswith(".map"):
+		symbols = read_map_symbols(sys.argv[2])
+	else:
+		symbols = read_elf_symbols(sys.argv[2])
+
+	# Labels without a size (e.g. loop entries of library code) would split their functions
+	symbols = sorted(symbol for symbol in symbols if symbol[1] > 0)
+	starts = [symbol[0] for symbol in symbols]
+
+	profile = {}
+	for bucket, count in enumerate(histogram):
+		if count == 0:
+			continue
+		address = bucket << shift
+		index = bisect.bisect_right(starts, address) - 1
+		name = "<unknown>"
+		if index >= 0 and address < symbols[index][0] + symbols[index][1]:
+			name = symbols[index][2]
+		elif index + 1 < len(symbols) and symbols[index + 1][0] < address + (1 << shift):
+			# The bucket starts in the padding before a function
+			name = symbols[index + 1][2]
+		profile[name] = profile.get(name, 0) + count
+
+	if outside:
+		profile["<outside of histogram>"] = outside
+
+	print("%d samples at %d Hz (%.1f s), %d-byte buckets" % (samples, rate_hz, samples / max(rate_hz, 1), 1 << shift))
+	print()
+	print("%10s %8s %8s  %s" % ("samples", "%", "cum. %", "function"))
+
+	cumulative = 0
+	for name, count in sorted(profile.items(), key=lambda item: -item[1]):
+		cumulative += count
+		print("%10d %8.2f %8.2f  %s" % (count, 100.0 * count / max(samples, 1), 100.0 * cumulative / max(samples, 1), name))
+
+
+if __name__ == "__main__":
+	main()
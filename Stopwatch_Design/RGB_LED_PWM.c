@@ -0,0 +1,270 @@
+/**
+ * @file RGB_LED_PWM.c
+ *
+ * @brief Source code for the RGB_LED_PWM driver.
+ *
+ * This file contains the function definitions for the RGB_LED_PWM driver.
+ * It drives the user LED (RGB) with M1PWM5, M1PWM6 and M1PWM7 and steps the blinking
+ * and breathing patterns from the Timer 4A interrupt.
+ *
+ * The generators count down from the load value. Each output is driven high when the counter
+ * is reloaded and low when it reaches the compare value. The compare and generator registers
+ * are locally synchronized, so a new brightness level takes effect at the end of the current
+ * PWM period and never produces a shortened pulse.
+ *
+ * @note This driver assumes that the system clock's frequency is 50 MHz.
+ *
+ * @author Katherine Poz
+ */
+
+#include "RGB_LED_PWM.h"
+
+// PWM period: (50 MHz / 50000) = 1 kHz
+#define RGB_LED_PWM_PERIOD				50000
+
+// PWMnGENx actions: drive high on the load value (ACTLOAD = 0x3)
+// and drive low on the compare value while counting down (ACTCMPAD or ACTCMPBD = 0x2)
+#define RGB_LED_PWM_GEN_A				0x008C
+#define RGB_LED_PWM_GEN_B				0x080C
+
+// PWMnGENx actions for a constant output: drive low or high on the load value only
+#define RGB_LED_PWM_GEN_LOW				0x0008
+#define RGB_LED_PWM_GEN_HIGH			0x000C
+
+typedef enum
+{
+	RGB_LED_PWM_RED = 0,
+	RGB_LED_PWM_GREEN,
+	RGB_LED_PWM_BLUE,
+	RGB_LED_PWM_CHANNEL_COUNT
+} RGB_LED_PWM_Channel;
+
+typedef struct
+{
+	volatile uint32_t *cmp;				// Compare register of the output
+	volatile uint32_t *gen;				// Generator register of the output
+	uint32_t gen_compare;				// Generator actions for a duty cycle between 0% and 100%
+} RGB_LED_PWM_Output;
+
+// PWM outputs of the red, green and blue channels
+static const RGB_LED_PWM_Output rgb_outputs[RGB_LED_PWM_CHANNEL_COUNT] =
+{
+	{ &PWM1->_2_CMPB, &PWM1->_2_GENB, RGB_LED_PWM_GEN_B },
+	{ &PWM1->_3_CMPB, &PWM1->_3_GENB, RGB_LED_PWM_GEN_B },
+	{ &PWM1->_3_CMPA, &PWM1->_3_GENA, RGB_LED_PWM_GEN_A }
+};
+
+// Pattern that is stepped by the Timer 4A interrupt
+static volatile RGB_LED_PWM_Pattern rgb_pattern = RGB_LED_PWM_SOLID;
+static uint8_t rgb_color[RGB_LED_PWM_CHANNEL_COUNT];
+static uint16_t rgb_pattern_steps;
+static uint16_t rgb_pattern_position;
+
+// 0x01 while PWM Module 1 holds a reference to its clock
+static uint8_t rgb_clock_acquired = 0x00;
+
+/**
+ * @brief Sets the brightness level of one color channel.
+ *
+ * The duty cycle follows the square of the level, so equal steps of the level
+ * are seen as roughly equal steps of brightness.
+ *
+ * @param channel The color channel.
+ *
+ * @param level The brightness level (0 to 255).
+ *
+ * @return None
+ */
+static void RGB_LED_PWM_Write(RGB_LED_PWM_Channel channel, uint8_t level)
+{
+	const RGB_LED_PWM_Output *output = &rgb_outputs[channel];
+
+	// high_cycles = period * (level / 255)^2
+	uint32_t high_cycles = (uint32_t)(((uint64_t)RGB_LED_PWM_PERIOD * level * level) / (RGB_LED_PWM_MAX * RGB_LED_PWM_MAX));
+
+	if (high_cycles == 0)
+	{
+		*output->gen = RGB_LED_PWM_GEN_LOW;
+	}
+	else if (high_cycles >= (RGB_LED_PWM_PERIOD - 1))
+	{
+		*output->gen = RGB_LED_PWM_GEN_HIGH;
+	}
+	else
+	{
+		// The output is high from the load value (period - 1) down to the compare value
+		*output->cmp = (RGB_LED_PWM_PERIOD - 1) - high_cycles;
+		*output->gen = output->gen_compare;
+	}
+}
+
+/**
+ * @brief Writes the current step of the pattern to the three color channels.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void RGB_LED_PWM_Show_Step(void)
+{
+	uint16_t half = rgb_pattern_steps / 2;
+	uint32_t scale = RGB_LED_PWM_MAX;
+
+	if (rgb_pattern == RGB_LED_PWM_BLINK)
+	{
+		scale = (rgb_pattern_position < half) ? RGB_LED_PWM_MAX : 0;
+	}
+	else if (rgb_pattern == RGB_LED_PWM_BREATHE)
+	{
+		// Rise during the first half of the period and fall during the second half
+		uint16_t distance = (rgb_pattern_position < half) ? rgb_pattern_position : (rgb_pattern_steps - rgb_pattern_position);
+		scale = ((uint32_t)distance * RGB_LED_PWM_MAX) / half;
+	}
+
+	for (uint8_t channel = 0; channel < RGB_LED_PWM_CHANNEL_COUNT; channel++)
+	{
+		RGB_LED_PWM_Write((RGB_LED_PWM_Channel)channel, (uint8_t)((rgb_color[channel] * scale) / RGB_LED_PWM_MAX));
+	}
+}
+
+/**
+ * @brief Advances the pattern by one step. Executed from the Timer 4A interrupt.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void RGB_LED_PWM_Step(void)
+{
+	if (rgb_pattern == RGB_LED_PWM_SOLID)
+	{
+		return;
+	}
+
+	rgb_pattern_position++;
+	if (rgb_pattern_position >= rgb_pattern_steps)
+	{
+		rgb_pattern_position = 0;
+	}
+
+	RGB_LED_PWM_Show_Step();
+}
+
+void RGB_LED_PWM_Init(void)
+{
+	// Acquire the clock to PWM Module 1 in run and sleep mode and wait until it is ready
+	// The module keeps its single reference if it is initialized again
+	if (rgb_clock_acquired == 0x00)
+	{
+		Clock_Gating_Acquire(CLOCK_GATING_PWM, 0x02, CLOCK_GATING_RUN_SLEEP);
+		rgb_clock_acquired = 0x01;
+	}
+
+	// Clock the PWM module directly from the system clock (clear USEPWMDIV, Bit 20)
+	SYSCTL->RCC &= ~0x00100000;
+
+	// Disable Generators 2 and 3 during configuration
+	PWM1->_2_CTL = 0;
+	PWM1->_3_CTL = 0;
+
+	// Set the period of both generators
+	PWM1->_2_LOAD = RGB_LED_PWM_PERIOD - 1;
+	PWM1->_3_LOAD = RGB_LED_PWM_PERIOD - 1;
+
+	// Start with the LED off
+	for (uint8_t channel = 0; channel < RGB_LED_PWM_CHANNEL_COUNT; channel++)
+	{
+		*rgb_outputs[channel].cmp = 0;
+		*rgb_outputs[channel].gen = RGB_LED_PWM_GEN_LOW;
+	}
+
+	// Select the count-down mode (MODE = 0) with locally synchronized updates of the
+	// load and compare registers (LOADUPD = 0, CMPAUPD = 0, CMPBUPD = 0) and of the
+	// generator registers (GENAUPD = 0x2, GENBUPD = 0x2), then enable the generators
+	PWM1->_2_CTL = 0x0280;
+	PWM1->_3_CTL = 0x0280;
+	PWM1->_2_CTL |= 0x01;
+	PWM1->_3_CTL |= 0x01;
+
+	// Reset the counters of Generators 2 and 3 in the same clock cycle so their periods are aligned
+	PWM1->SYNC = 0x0C;
+
+	// Enable the M1PWM5, M1PWM6 and M1PWM7 outputs
+	PWM1->ENABLE |= 0xE0;
+
+	// Configure Timer 4A to step the patterns
+	// The prescaler divides the 50 MHz system clock by 50
+	// New timer clock frequency = (50 MHz / 50) = 1 MHz
+	// Interval: (1 us * 20000) = 20 ms
+	// The priority level of the Timer 4A interrupt (IRQ 70) is set to 6
+	GPTM_Init_Split_Periodic(GPTM_TIMER4, GPTM_TIMER_A, 50, RGB_LED_PWM_STEP_MS * 1000, &RGB_LED_PWM_Step, 6);
+}
+
+void RGB_LED_PWM_Deinit(void)
+{
+	if (rgb_clock_acquired == 0x00)
+	{
+		return;
+	}
+
+	// Stop stepping the patterns and release Timer 4
+	GPTM_Deinit(GPTM_TIMER4);
+	rgb_pattern = RGB_LED_PWM_SOLID;
+
+	// Disable the M1PWM5, M1PWM6 and M1PWM7 outputs, which turns the LED off, and stop Generators 2 and 3
+	PWM1->ENABLE &= ~0xE0;
+	PWM1->_2_CTL = 0;
+	PWM1->_3_CTL = 0;
+
+	// Release the reference of PWM Module 1 to its clock
+	Clock_Gating_Release(CLOCK_GATING_PWM, 0x02, CLOCK_GATING_RUN_SLEEP);
+	rgb_clock_acquired = 0x00;
+}
+
+void RGB_LED_PWM_Set_Color(uint8_t red, uint8_t green, uint8_t blue)
+{
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	// Stop stepping the pattern
+	GPTM_Disable(GPTM_TIMER4, GPTM_TIMER_A);
+	rgb_pattern = RGB_LED_PWM_SOLID;
+
+	rgb_color[RGB_LED_PWM_RED] = red;
+	rgb_color[RGB_LED_PWM_GREEN] = green;
+	rgb_color[RGB_LED_PWM_BLUE] = blue;
+	RGB_LED_PWM_Show_Step();
+
+	__set_PRIMASK(primask);
+}
+
+void RGB_LED_PWM_Start_Pattern(RGB_LED_PWM_Pattern pattern, uint8_t red, uint8_t green, uint8_t blue, uint16_t period_ms)
+{
+	// Number of steps per period, rounded to an even number of at least two
+	uint16_t steps = (period_ms / (2 * RGB_LED_PWM_STEP_MS)) * 2;
+	if (steps < 2)
+	{
+		steps = 2;
+	}
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	GPTM_Disable(GPTM_TIMER4, GPTM_TIMER_A);
+
+	rgb_pattern = pattern;
+	rgb_pattern_steps = steps;
+	rgb_pattern_position = 0;
+	rgb_color[RGB_LED_PWM_RED] = red;
+	rgb_color[RGB_LED_PWM_GREEN] = green;
+	rgb_color[RGB_LED_PWM_BLUE] = blue;
+	RGB_LED_PWM_Show_Step();
+
+	// Step the pattern from the Timer 4A interrupt
+	if (pattern != RGB_LED_PWM_SOLID)
+	{
+		GPTM_Enable(GPTM_TIMER4, GPTM_TIMER_A);
+	}
+
+	__set_PRIMASK(primask);
+}
@@ -0,0 +1,102 @@
+/**
+ * @file RGB_LED_PWM.h
+ *
+ * @brief Header file for the RGB_LED_PWM driver.
+ *
+ * This file contains the function definitions for the RGB_LED_PWM driver.
+ * It drives the user LED (RGB) of the Tiva C Series TM4C123G LaunchPad with the outputs of
+ * PWM Module 1, so any color can be mixed from 256 brightness levels per channel:
+ *	- LED_R (PF1): M1PWM5 (Generator 2, Output B)
+ *	- LED_B (PF2): M1PWM6 (Generator 3, Output A)
+ *	- LED_G (PF3): M1PWM7 (Generator 3, Output B)
+ *
+ * Blinking and breathing patterns are stepped by the Timer 4A interrupt every 20 ms, which only
+ * writes the compare registers of the three outputs. The main loop does not spend any time on
+ * the status indication.
+ *
+ * @note The pins are configured for the PWM function (PCTL = 0x5) by Board_Pins_Init, which
+ * must be called first. RGB_LED_Init, RGB_LED_Output and RGB_LED_Status cannot be used together
+ * with this driver.
+ *
+ * @note This driver assumes that the system clock's frequency is 50 MHz.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef RGB_LED_PWM_H
+#define RGB_LED_PWM_H
+
+#include "TM4C123GH6PM.h"
+#include "GPTM.h"
+#include "Clock_Gating.h"
+
+// Highest brightness level of each color channel
+#define RGB_LED_PWM_MAX					255
+
+// Interval of the pattern steps in milliseconds
+#define RGB_LED_PWM_STEP_MS				20
+
+typedef enum
+{
+	RGB_LED_PWM_SOLID = 0,				// The color is shown continuously
+	RGB_LED_PWM_BLINK,					// The color is on for the first half of the period and off for the second half
+	RGB_LED_PWM_BREATHE					// The brightness of the color rises and falls linearly over the period
+} RGB_LED_PWM_Pattern;
+
+/**
+ * @brief Initializes the PWM outputs of the RGB LED.
+ *
+ * This function configures Generators 2 and 3 of PWM Module 1 with a period of 1 ms, starts both
+ * generators in the same clock cycle with the LED off, and configures Timer 4A to step the patterns.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void RGB_LED_PWM_Init(void);
+
+/**
+ * @brief Turns the RGB LED off and releases PWM Module 1 and Timer 4.
+ *
+ * The clocks are gated if no other driver holds a reference to them.
+ * RGB_LED_PWM_Init must be called again before a color or a pattern can be shown.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void RGB_LED_PWM_Deinit(void);
+
+/**
+ * @brief Shows a color continuously and stops the current pattern.
+ *
+ * @param red The brightness level of the red channel (0 to 255).
+ *
+ * @param green The brightness level of the green channel (0 to 255).
+ *
+ * @param blue The brightness level of the blue channel (0 to 255).
+ *
+ * @return None
+ */
+void RGB_LED_PWM_Set_Color(uint8_t red, uint8_t green, uint8_t blue);
+
+/**
+ * @brief Shows a color with a blinking or breathing pattern.
+ *
+ * The pattern starts at the beginning of its period and repeats until another color or pattern is set.
+ *
+ * @param pattern The pattern to be shown.
+ *
+ * @param red The peak brightness level of the red channel (0 to 255).
+ *
+ * @param green The peak brightness level of the green channel (0 to 255).
+ *
+ * @param blue The peak brightness level of the blue channel (0 to 255).
+ *
+ * @param period_ms The period of the pattern in milliseconds (rounded to a multiple of 40 ms).
+ *
+ * @return None
+ */
+void RGB_LED_PWM_Start_Pattern(RGB_LED_PWM_Pattern pattern, uint8_t red, uint8_t green, uint8_t blue, uint16_t period_ms);
+
+#endif
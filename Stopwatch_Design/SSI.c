@@ -0,0 +1,318 @@
+/**
+ * @file SSI.c
+ *
+ * @brief Source code for the SSI driver.
+ *
+ * This file contains the function definitions for the SSI driver.
+ * It operates the Synchronous Serial Interface modules (SSI0 to SSI3) as SPI masters
+ * and lets several devices share one bus through a transaction queue.
+ *
+ * The end of transmission mode (EOT) is used, so the transmit interrupt is raised once
+ * the transmit FIFO is empty and the last bit has been shifted out. At that point every
+ * byte of the block is in the receive FIFO, the block can be read back, and the next block
+ * or transaction can be started.
+ *
+ * @author Katherine Poz
+ */
+
+#include "SSI.h"
+
+// Depth of the transmit and receive FIFOs
+#define SSI_FIFO_SIZE				8
+
+typedef struct
+{
+	SSI0_Type *ssi;					// Base address of the SSI module
+	IRQn_Type irq;					// Interrupt Request (IRQ) number of the module
+} SSI_Config;
+
+typedef struct
+{
+	SSI_Transaction queue[SSI_QUEUE_SIZE];
+	volatile uint8_t head;			// Index of the next free queue entry
+	volatile uint8_t tail;			// Index of the transaction in progress
+	uint16_t tx_index;				// Number of bytes written to the transmit FIFO
+	uint16_t rx_index;				// Number of bytes read from the receive FIFO
+	uint8_t clock_acquired;			// 0x01 once the clock of the module has been acquired
+	uint32_t start_cycle;			// Cycle counter value when the transaction in progress was started
+	SSI_Stats stats;				// Bus utilization counters
+} SSI_State;
+
+// Instance table of all SSI modules
+static const SSI_Config ssi_config[SSI_MODULE_COUNT] =
+{
+	{ SSI0, SSI0_IRQn },
+	{ SSI1, SSI1_IRQn },
+	{ SSI2, SSI2_IRQn },
+	{ SSI3, SSI3_IRQn }
+};
+
+static SSI_State ssi_state[SSI_MODULE_COUNT];
+
+/**
+ * @brief Drives the chip select pin of a transaction.
+ *
+ * Only the chip select pin is written through the address mask of the GPIO DATA register,
+ * so other pins of the same port can be changed from thread mode at the same time.
+ *
+ * @param transaction Pointer to the transaction.
+ *
+ * @param level 0x00 to assert (low), 0x01 to deassert (high).
+ *
+ * @return None
+ */
+static void SSI_Write_Chip_Select(const SSI_Transaction *transaction, uint8_t level)
+{
+	if (transaction->cs_port != 0)
+	{
+		volatile uint32_t *data_bits = (volatile uint32_t *)((uintptr_t)transaction->cs_port + ((uint32_t)transaction->cs_pin << 2));
+		*data_bits = (level != 0x00) ? transaction->cs_pin : 0x00;
+	}
+}
+
+/**
+ * @brief Writes the next block of up to 8 bytes of the current transaction to the transmit FIFO.
+ *
+ * @param module The SSI module.
+ *
+ * @return None
+ */
+static void SSI_Fill_FIFO(SSI_Module module)
+{
+	SSI0_Type *ssi = ssi_config[module].ssi;
+	SSI_State *state = &ssi_state[module];
+	const SSI_Transaction *transaction = &state->queue[state->tail & (SSI_QUEUE_SIZE - 1)];
+
+	// Limit the block to the depth of the receive FIFO so that no received byte is lost
+	uint16_t end = state->tx_index + SSI_FIFO_SIZE;
+	if (end > transaction->length)
+	{
+		end = transaction->length;
+	}
+
+	while (state->tx_index < end)
+	{
+		ssi->DR = (transaction->tx_data != 0) ? transaction->tx_data[state->tx_index] : 0xFF;
+		state->tx_index++;
+	}
+}
+
+/**
+ * @brief Starts the transaction at the tail of the queue.
+ *
+ * @param module The SSI module.
+ *
+ * @return None
+ */
+static void SSI_Start(SSI_Module module)
+{
+	SSI_State *state = &ssi_state[module];
+
+	state->tx_index = 0;
+	state->rx_index = 0;
+	state->start_cycle = DWT->CYCCNT;
+
+	SSI_Write_Chip_Select(&state->queue[state->tail & (SSI_QUEUE_SIZE - 1)], 0x00);
+	SSI_Fill_FIFO(module);
+
+	// Enable the end of transmission interrupt (TXIM, Bit 3)
+	ssi_config[module].ssi->IM |= 0x08;
+}
+
+void SSI_Init(SSI_Module module, uint8_t clock_prescale, uint8_t spi_mode, uint8_t priority)
+{
+	const SSI_Config *config = &ssi_config[module];
+	SSI0_Type *ssi = config->ssi;
+
+	ssi_state[module].head = 0;
+	ssi_state[module].tail = 0;
+
+	// Acquire the clock to the SSI module in run and sleep mode and wait until it is ready
+	// A module that is initialized again keeps its single reference
+	if (ssi_state[module].clock_acquired == 0x00)
+	{
+		Clock_Gating_Acquire(CLOCK_GATING_SSI, (1U << module), CLOCK_GATING_RUN_SLEEP);
+		ssi_state[module].clock_acquired = 0x01;
+	}
+
+	// Disable the SSI module during configuration
+	ssi->CR1 = 0;
+
+	// Use the system clock as the clock source
+	ssi->CC = 0;
+
+	// SCLK = System Clock / CPSR (SCR = 0)
+	ssi->CPSR = clock_prescale;
+
+	// Select 8-bit data (DSS = 0x7) and the Freescale SPI frame format (FRF = 0)
+	// The clock polarity (SPO, Bit 6) and clock phase (SPH, Bit 7) are selected by the SPI mode
+	ssi->CR0 = 0x0007 | ((spi_mode & 0x02) << 5) | ((spi_mode & 0x01) << 7);
+
+	// Mask all SSI interrupts until a transaction is started
+	ssi->IM = 0;
+
+	// Set the priority level and enable the interrupt of the SSI module
+	NVIC_SetPriority(config->irq, priority);
+	NVIC_EnableIRQ(config->irq);
+
+	// Select the end of transmission mode for the transmit interrupt (EOT, Bit 4)
+	// and enable the SSI module in master mode (SSE, Bit 1)
+	ssi->CR1 = 0x10;
+	ssi->CR1 |= 0x02;
+}
+
+void SSI_Deinit(SSI_Module module)
+{
+	const SSI_Config *config = &ssi_config[module];
+	SSI_State *state = &ssi_state[module];
+
+	if (state->clock_acquired == 0x00)
+	{
+		return;
+	}
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	// Mask the SSI interrupts and disable the SSI module (SSE, Bit 1)
+	NVIC_DisableIRQ(config->irq);
+	config->ssi->IM = 0;
+	config->ssi->CR1 = 0;
+
+	// Deassert the chip select of an aborted transaction and discard the queue
+	if (state->head != state->tail)
+	{
+		SSI_Write_Chip_Select(&state->queue[state->tail & (SSI_QUEUE_SIZE - 1)], 0x01);
+	}
+	state->head = 0;
+	state->tail = 0;
+
+	__set_PRIMASK(primask);
+
+	// Release the reference of the module to its clock
+	Clock_Gating_Release(CLOCK_GATING_SSI, (1U << module), CLOCK_GATING_RUN_SLEEP);
+	state->clock_acquired = 0x00;
+}
+
+uint8_t SSI_Submit(SSI_Module module, const SSI_Transaction *transaction)
+{
+	SSI_State *state = &ssi_state[module];
+	uint8_t accepted = 0x00;
+
+	if (transaction->length == 0)
+	{
+		return 0x00;
+	}
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	if ((uint8_t)(state->head - state->tail) < SSI_QUEUE_SIZE)
+	{
+		state->queue[state->head & (SSI_QUEUE_SIZE - 1)] = *transaction;
+		state->head++;
+		accepted = 0x01;
+
+		// Start the transaction if the module was idle
+		if ((uint8_t)(state->head - state->tail) == 1)
+		{
+			SSI_Start(module);
+		}
+	}
+	else
+	{
+		state->stats.rejected++;
+	}
+
+	__set_PRIMASK(primask);
+
+	return accepted;
+}
+
+uint8_t SSI_Get_Pending(SSI_Module module)
+{
+	return (uint8_t)(ssi_state[module].head - ssi_state[module].tail);
+}
+
+void SSI_Get_Stats(SSI_Module module, SSI_Stats *stats)
+{
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	*stats = ssi_state[module].stats;
+
+	__set_PRIMASK(primask);
+}
+
+/**
+ * @brief Handles the end of transmission interrupt of an SSI module.
+ *
+ * @param module The SSI module that generated the interrupt.
+ *
+ * @return None
+ */
+static void SSI_Handler(SSI_Module module)
+{
+	SSI0_Type *ssi = ssi_config[module].ssi;
+	SSI_State *state = &ssi_state[module];
+
+	if ((ssi->MIS & 0x08) == 0)
+	{
+		return;
+	}
+
+	uint32_t entry_cycle = DWT->CYCCNT;
+
+	const SSI_Transaction *transaction = &state->queue[state->tail & (SSI_QUEUE_SIZE - 1)];
+
+	// Read back every byte of the block while the receive FIFO is not empty (RNE, Bit 2)
+	while (ssi->SR & 0x04)
+	{
+		uint8_t data = ssi->DR;
+
+		if ((transaction->rx_data != 0) && (state->rx_index < transaction->length))
+		{
+			transaction->rx_data[state->rx_index] = data;
+		}
+		state->rx_index++;
+	}
+
+	// Continue with the next block of the transaction
+	if (state->tx_index < transaction->length)
+	{
+		SSI_Fill_FIFO(module);
+		state->stats.isr_cycles += DWT->CYCCNT - entry_cycle;
+		return;
+	}
+
+	// The transaction is done
+	SSI_Write_Chip_Select(transaction, 0x01);
+	void (*callback)(void) = transaction->callback;
+
+	state->stats.transactions++;
+	state->stats.bytes += transaction->length;
+	state->stats.busy_cycles += entry_cycle - state->start_cycle;
+
+	// The transmit interrupt cannot be cleared while the FIFO is empty, so mask it
+	ssi->IM &= ~0x08;
+	state->tail++;
+
+	// Start the next transaction before the callback, so a transaction submitted
+	// by the callback is queued behind it instead of being started twice
+	if (state->head != state->tail)
+	{
+		SSI_Start(module);
+	}
+
+	if (callback != 0)
+	{
+		(*callback)();
+	}
+
+	state->stats.isr_cycles += DWT->CYCCNT - entry_cycle;
+}
+
+void SSI0_Handler(void) { SSI_Handler(SSI_MODULE_0); }
+void SSI1_Handler(void) { SSI_Handler(SSI_MODULE_1); }
+void SSI2_Handler(void) { SSI_Handler(SSI_MODULE_2); }
+void SSI3_Handler(void) { SSI_Handler(SSI_MODULE_3); }
@@ -0,0 +1,138 @@
+/**
+ * @file SSI.h
+ *
+ * @brief Header file for the SSI driver.
+ *
+ * This file contains the function definitions for the SSI driver.
+ * It operates the Synchronous Serial Interface modules (SSI0 to SSI3) as SPI masters
+ * and lets several devices share one bus through a transaction queue.
+ *
+ * A transaction describes one chip select assertion: the chip select pin, the data to be sent,
+ * an optional buffer for the received data, the length, and an optional completion callback.
+ * Transactions are executed in the order they were submitted. The transmit FIFO is filled
+ * from the SSI interrupt in blocks of up to 8 bytes, and the end of transmission interrupt
+ * reports when a block has been shifted out, so neither the caller nor the driver waits on
+ * the BSY bit.
+ *
+ * The pins of the modules are configured by Board_Pins_Init:
+ *	- SSI0: PA2 (CLK), PA4 (RX), PA5 (TX)
+ *	- SSI1: PD0 (CLK), PD2 (RX), PD3 (TX) or PF2 (CLK), PF0 (RX), PF1 (TX)
+ *	- SSI2: PB4 (CLK), PB6 (RX), PB7 (TX)
+ *	- SSI3: PD0 (CLK), PD2 (RX), PD3 (TX)
+ *
+ * Each module counts its completed transactions, the bytes sent, the cycles during which a
+ * transaction was in progress (bus busy), and the cycles spent in its interrupt handler, so the
+ * load of a device on the bus and on the CPU can be measured.
+ *
+ * @note The data buffers of a transaction must stay valid until its callback has been executed.
+ *
+ * @note The cycle counts use the DWT cycle counter, which is enabled by SysTick_Delay_Init.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef SSI_H
+#define SSI_H
+
+#include "TM4C123GH6PM.h"
+#include "Clock_Gating.h"
+
+// Number of transactions that can be queued on each SSI module (must be a power of two)
+#define SSI_QUEUE_SIZE					8
+
+typedef enum
+{
+	SSI_MODULE_0 = 0,
+	SSI_MODULE_1,
+	SSI_MODULE_2,
+	SSI_MODULE_3,
+	SSI_MODULE_COUNT
+} SSI_Module;
+
+typedef struct
+{
+	GPIOA_Type *cs_port;			// Port of the active low chip select pin, or NULL if no chip select is used
+	uint8_t cs_pin;					// Bit mask of the chip select pin (e.g. 0x80 for Pin 7)
+	const uint8_t *tx_data;			// Data to be sent, or NULL to send 0xFF
+	uint8_t *rx_data;				// Buffer for the received data, or NULL to discard it
+	uint16_t length;				// Number of bytes to be transferred
+	void (*callback)(void);			// Function executed from the SSI interrupt when the transaction is done, or NULL
+} SSI_Transaction;
+
+typedef struct
+{
+	uint32_t transactions;			// Number of completed transactions (chip select windows)
+	uint32_t bytes;					// Number of bytes sent
+	uint32_t busy_cycles;			// System clock cycles from the start to the end of each transaction
+	uint32_t isr_cycles;			// System clock cycles spent in the SSI interrupt handler
+	uint32_t rejected;				// Number of transactions rejected because the queue was full
+} SSI_Stats;
+
+/**
+ * @brief Initializes an SSI module as an SPI master with 8-bit data.
+ *
+ * The CLK, TX and (if used) RX pins of the module are configured by Board_Pins_Init.
+ * Chip select pins are configured in the board pin table as GPIO outputs that are initialized high.
+ *
+ * @param module The SSI module to be initialized.
+ *
+ * @param clock_prescale The divider applied to the system clock to generate SCLK (even number from 2 to 254).
+ *
+ * @param spi_mode The SPI mode (0 to 3) which selects the clock polarity (SPO) and clock phase (SPH).
+ *
+ * @param priority The interrupt priority level (0 to 7) of the SSI interrupt.
+ *
+ * @return None
+ */
+void SSI_Init(SSI_Module module, uint8_t clock_prescale, uint8_t spi_mode, uint8_t priority);
+
+/**
+ * @brief Disables an SSI module and releases its clock.
+ *
+ * A transaction in progress is aborted, its chip select is deasserted and the queue is discarded,
+ * so this function should be called once SSI_Get_Pending returns 0. The clock of the module is gated
+ * if no other driver holds a reference to it. The module must be initialized again before it can be used.
+ *
+ * @param module The SSI module to be released.
+ *
+ * @return None
+ */
+void SSI_Deinit(SSI_Module module);
+
+/**
+ * @brief Adds a transaction to the queue of an SSI module.
+ *
+ * The transaction is copied into the queue, so the SSI_Transaction structure itself does not need
+ * to stay valid. The transfer starts immediately if the module is idle.
+ *
+ * @param module The SSI module that executes the transaction.
+ *
+ * @param transaction Pointer to the description of the transaction.
+ *
+ * @return 0x01 if the transaction was queued, 0x00 if the queue is full.
+ */
+uint8_t SSI_Submit(SSI_Module module, const SSI_Transaction *transaction);
+
+/**
+ * @brief Returns the number of transactions that are queued or in progress.
+ *
+ * @param module The SSI module to be checked.
+ *
+ * @return The number of unfinished transactions.
+ */
+uint8_t SSI_Get_Pending(SSI_Module module);
+
+/**
+ * @brief Reads the bus utilization counters of an SSI module.
+ *
+ * The counters wrap around, so rates are calculated from the difference of two readings.
+ *
+ * @param module The SSI module to be read.
+ *
+ * @param stats Pointer to the structure that receives the counters.
+ *
+ * @return None
+ */
+void SSI_Get_Stats(SSI_Module module, SSI_Stats *stats);
+
+#endif
@@ -6,7 +6,19 @@
  * This file contains the function definitions for the Seven_Segment_Display driver.
  * It interfaces with the Seven-Segment Display module on the EduBase board.
  *
- * @note Assumes that a 16 MHz clock is used.
+ * The frames are sent to the shift registers through the transaction queue of the SSI driver,
+ * so writing to the display does not wait for the SPI transfer.
+ *
+ * The digits are scanned with an adaptive schedule. Leading zeros are blanked and only the
+ * lit digits are written, each for an equal share of the 4 ms scan period, so the lit digits
+ * are evenly bright and no SSI transactions are spent on blank digits. If a single digit is lit
+ * and its frame is already latched in the shift registers, nothing is sent at all.
+ *
+ * The display path counts its scans, transactions, dropped frames and the cycles spent waiting
+ * between digits. Once per second, these counters and the SSI2 counters are turned into the
+ * display telemetry (frames per second, bus utilization and CPU load).
+ *
+ * @note Assumes that a 50 MHz system clock is used.
  *
  * @author Aaron Nanas
  */
@@ -34,81 +46,182 @@ const uint8_t number_pattern[16] =
 	0x8E  // F
 };
 
+// Number of display frames that can be in flight at the same time
+#define DISPLAY_FRAME_COUNT				4
+
+// Frames (segment pattern and digit select) that are sent to the shift registers
+// Each frame must stay unchanged until its SSI transaction is done
+static uint8_t display_frames[DISPLAY_FRAME_COUNT][2];
+
+// Number of frames submitted to and completed by the SSI driver
+static uint8_t frames_submitted = 0;
+static volatile uint8_t frames_done = 0;
+
+// Counters of the display path
+static Seven_Segment_Display_Stats display_stats;
+
+// Telemetry of the last full second, and the counters and cycle counter value at its start
+static Seven_Segment_Display_Telemetry display_telemetry;
+static Seven_Segment_Display_Stats window_display_stats;
+static SSI_Stats window_ssi_stats;
+static uint32_t window_start_cycle = 0;
+
+// Frame that was submitted last and stays latched in the shift registers
+static uint8_t latched_pattern = DISPLAY_BLANK_PATTERN;
+static uint8_t latched_digit_select = 0x00;
+
+// Blank leading zeros and skip unchanged frames (0x01) or scan all four digits (0x00)
+static uint8_t adaptive_scan = 0x01;
+
+/**
+ * @brief Counts a completed display frame.
+ *
+ * This function is executed from the SSI2 interrupt when a frame has been latched.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Seven_Segment_Display_Frame_Done(void)
+{
+	frames_done++;
+}
+
 void Seven_Segment_Display_Init(void)
 {
-	// Enable the clock to Port B (Bit 1)
-	SYSCTL->RCGCGPIO |= 0x02;
+	// PB4 (SSI2 CLK), PB7 (SSI2 TX Data) and PC7 (SSI2 SS) are configured by Board_Pins_Init
+	// Note: Slave Select pin is active low and is initialized high
 
-	// Enable the clock to Port C (Bit 2)
-	SYSCTL->RCGCGPIO |= 0x04;
+	// Initialize SSI2 in SPI mode 0
+	// SCLK = (50 MHz / 50) = 1 MHz
+	SSI_Init(SSI_MODULE_2, 50, 0, 4);
+}
+
+void Seven_Segment_Display_Write(uint8_t pattern, uint8_t digit_select)
+{
+	// Drop the frame if every frame buffer is still in flight
+	if ((uint8_t)(frames_submitted - frames_done) >= DISPLAY_FRAME_COUNT)
+	{
+		display_stats.dropped++;
+		return;
+	}
 
-	// Enable the clock to SSI2 (Bit 2)
-	SYSCTL->RCGCSSI |= 0x04;
+	uint8_t *frame = display_frames[frames_submitted % DISPLAY_FRAME_COUNT];
 
-	// Configure PB4 (SSI2 CLK) and PB7 (SSI2 TX Data) to use alternate function
-	GPIOB->AFSEL |= 0x90;
+	// The segment pattern is shifted through to the second shift register,
+	// so it is sent first and the digit select second
+	frame[0] = pattern;
+	frame[1] = digit_select;
 
-	// Clear functions for PB4 (SSI2 CLK) and PB7 (SSI2 TX Data)
-	GPIOB->PCTL &= ~0xF00F0000;
+	// Keep the slave select pin (PC7) asserted for both bytes. The shift registers
+	// latch the frame on the rising edge of the slave select pin.
+	SSI_Transaction transaction =
+	{
+		.cs_port = GPIOC,
+		.cs_pin = 0x80,
+		.tx_data = frame,
+		.rx_data = 0,
+		.length = 2,
+		.callback = &Seven_Segment_Display_Frame_Done
+	};
 
-	// Enable SSI2 function for PB4 (SSI2 CLK) and PB7 (SSI2 TX Data)
-	GPIOB->PCTL |= 0x20020000;
+	if (SSI_Submit(SSI_MODULE_2, &transaction) == 0x01)
+	{
+		frames_submitted++;
+		display_stats.transactions++;
+		latched_pattern = pattern;
+		latched_digit_select = digit_select;
+	}
+}
 
-	// Enable digital functionality for PB4 and PB7
-	GPIOB->DEN |= 0x90;
+/**
+ * @brief Calculates a share of a time window in permille.
+ *
+ * @param cycles The number of cycles of the share.
+ *
+ * @param window_cycles The number of cycles of the window.
+ *
+ * @return The share in permille.
+ */
+static uint16_t Seven_Segment_Display_Permille(uint32_t cycles, uint32_t window_cycles)
+{
+	return (uint16_t)(((uint64_t)cycles * 1000) / window_cycles);
+}
 
-	// Set PC7 as an output GPIO pin for SSI2 Slave Select (SSI2 SS)
-	// Note: Slave Select pin is active low
-	GPIOC->DIR |= 0x80;
+/**
+ * @brief Updates the telemetry once a second has passed since the start of the current window.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Seven_Segment_Display_Update_Telemetry(void)
+{
+	uint32_t now = DWT->CYCCNT;
+	uint32_t window_cycles = now - window_start_cycle;
+	uint32_t cycles_per_second = SysTick_Delay_Get_Cycles_Per_us() * 1000000;
 
-	// Configure PC7 (SSI2 SS) to function as a GPIO pin
-	GPIOC->AFSEL &= ~0x80;
+	if (window_cycles < cycles_per_second)
+	{
+		return;
+	}
 
-	// Enable digital functionality for PC7 (SSI2 SS)
-	GPIOC->DEN |= 0x80;
+	SSI_Stats ssi_stats;
+	SSI_Get_Stats(SSI_MODULE_2, &ssi_stats);
 
-	// Initialize the output of PC7 (SSI2 SS) to high
-	GPIOC->DATA |= 0x80;
+	// Scale the counts to one second, since the window ends at the first scan after a full second
+	display_telemetry.frames_per_second = (uint16_t)(((uint64_t)(display_stats.scans - window_display_stats.scans) * cycles_per_second) / window_cycles);
+	display_telemetry.transactions_per_second = (uint16_t)(((uint64_t)(ssi_stats.transactions - window_ssi_stats.transactions) * cycles_per_second) / window_cycles);
+	display_telemetry.bytes_per_second = (uint32_t)(((uint64_t)(ssi_stats.bytes - window_ssi_stats.bytes) * cycles_per_second) / window_cycles);
+	display_telemetry.bus_busy_permille = Seven_Segment_Display_Permille(ssi_stats.busy_cycles - window_ssi_stats.busy_cycles, window_cycles);
+	display_telemetry.isr_load_permille = Seven_Segment_Display_Permille(ssi_stats.isr_cycles - window_ssi_stats.isr_cycles, window_cycles);
+	display_telemetry.wait_load_permille = Seven_Segment_Display_Permille(display_stats.wait_cycles - window_display_stats.wait_cycles, window_cycles);
 
-	// Disable SSI2 during configuration
-	SSI2->CR1 = 0;
-	
-	// Use system clock as the clock source
-	SSI2->CC = 5;
-
-	// Assumes that a 16 MHz clock is used
-	// Set the prescale value to 16
-	// New clock frequency = (16 MHz / 16) = 1 MHz
-	SSI2->CPSR = 16;
-
-	// Select 8-bit data format (DSS = 0x07)
-	// Use Freescale SPI Frame Format (FRF = 0)
-	// Select steady state low value on SCLK pin (Clock Polarity, SPO = 0)
-	// Capture data on the first clock edge transition (Clock Phase, SPH = 0)
-	// Set Serial Clock Rate to to 0 (SCR = 0)
-	SSI2->CR0 = 0x0007;
-
-	// Set the Synchronous Serial Enable bit (SSE)
-	// Enable SSI in master mode (MS = 0)
-	SSI2->CR1 |= 0x02;
+	// Start the next window
+	window_display_stats = display_stats;
+	window_ssi_stats = ssi_stats;
+	window_start_cycle = now;
 }
 
-void SSI2_Write(uint8_t data)
+/**
+ * @brief Scans the lit digits once.
+ *
+ * Each lit digit is written and shown for an equal share of the scan period. A single lit digit
+ * is only written if its frame is not already latched in the shift registers.
+ *
+ * @param patterns The segment patterns of the four digits, starting with the rightmost digit.
+ *
+ * @param lit_digits The number of digits to be shown, starting with the rightmost digit (1 to 4).
+ *
+ * @return None
+ */
+static void Seven_Segment_Display_Scan(const uint8_t patterns[DISPLAY_DIGIT_COUNT], uint8_t lit_digits)
 {
-	// Assert the slave select pin by clearing Bit 7
-	// of the DATA register for Port C
-	GPIOC->DATA &= ~0x80;
+	if (adaptive_scan == 0x00)
+	{
+		lit_digits = DISPLAY_DIGIT_COUNT;
+	}
 
-	// Write the data to the SSI Data Register (SSIDR)
-	SSI2->DR = data;
+	// Share the scan period evenly between the lit digits
+	uint32_t digit_time_us = DISPLAY_SCAN_PERIOD_US / lit_digits;
 
-	// Wait until data transmission is done by checking
-	// the BSY bit of the SSI Status Register (SSISR)
-	while (SSI2->SR & 0x10);
+	for (uint8_t i = 0; i < lit_digits; i++)
+	{
+		uint8_t digit_select = (uint8_t)(1 << i);
+
+		if ((adaptive_scan == 0x00) || (lit_digits > 1) ||
+		    (patterns[i] != latched_pattern) || (digit_select != latched_digit_select))
+		{
+			Seven_Segment_Display_Write(patterns[i], digit_select);
+		}
+
+		uint32_t wait_start = DWT->CYCCNT;
+		SysTick_Delay1us(digit_time_us);
+		display_stats.wait_cycles += DWT->CYCCNT - wait_start;
+	}
 
-	// Deassert the slave select pin by setting Bit 7
-	// of the DATA register for Port C
-	GPIOC->DATA |= 0x80;
+	display_stats.scans++;
+	Seven_Segment_Display_Update_Telemetry();
 }
 
 int Count_Digits(int value)
@@ -132,70 +245,89 @@ int Count_Digits(int value)
 
 void Seven_Segment_Display(int count_value)
 {
-	// If the count value is zero, then display "0" on the seven-segment display
-	if (count_value == 0)
+	uint8_t patterns[DISPLAY_DIGIT_COUNT];
+	
+	// Negative values have no pattern, so they are shown as "0"
+	if (count_value < 0)
 	{
-		// Send the command to write "0" on the seven-segment display
-		SSI2_Write(number_pattern[0]);
-		
-		// Send the command to write "0" as the first digit on the seven-segment display
-		SSI2_Write(1);
-		
-		// Exit the function
-		return;
+		count_value = 0;
 	}
-
-	// Count the number of digits in count_value
-	int num_digits = Count_Digits(count_value);
 	
-	// Initialize a local variable to store the extracted digit
-	int digit = 0;
+	// Count the number of digits in count_value, a zero value is shown as "0"
+	// Only the four least significant digits fit on the display
+	int num_digits = Count_Digits(count_value);
+	if (num_digits == 0)
+	{
+		num_digits = 1;
+	}
+	else if (num_digits > DISPLAY_DIGIT_COUNT)
+	{
+		num_digits = DISPLAY_DIGIT_COUNT;
+	}
 
-	// Iterate through each digit in count_value
-	for (int i = 1; i < (num_digits * 2); i = i * 2)
+	// Extract each digit, starting with the least significant digit
+	for (uint8_t i = 0; i < DISPLAY_DIGIT_COUNT; i++)
 	{
 		// Get the least significant digit
-		digit = count_value % 10;
+		int digit = count_value % 10;
 		
 		// Remove the least significant digit from count_value by dividing by 10
 		count_value = count_value / 10;
 		
-		// Send the command to write the extracted digit's pattern on the seven-segment display
-		SSI2_Write(number_pattern[digit]);
-		
-		// Send the command to write each digit in the correct place on the seven-segment display
-		SSI2_Write(i);
-		
-		// Add a short delay in order to show all digits on the seven-segment display
-		SysTick_Delay1ms(1);
+		patterns[i] = number_pattern[digit];
 	}
+	
+	// Show the digits without the leading zeros
+	Seven_Segment_Display_Scan(patterns, (uint8_t)num_digits);
 }
 
-void Seven_Segment_Display_Stopwatch(uint8_t stopwatch_value[])
+void Seven_Segment_Display_Stopwatch(uint8_t stopwatch_value[], uint8_t decimal_points)
 {
-	int stopwatch_value_idx = 0;
+	uint8_t patterns[DISPLAY_DIGIT_COUNT];
 	
-	// Iterate through each segment of the display
-	for (uint8_t i = 1; i <= 8; i = i * 2)
+	// Look up the pattern of each digit of the stopwatch value
+	// and light the decimal points by clearing their segment
+	for (uint8_t i = 0; i < DISPLAY_DIGIT_COUNT; i++)
 	{
-		if (stopwatch_value[stopwatch_value_idx] == 0)
+		patterns[i] = number_pattern[stopwatch_value[i]];
+		
+		if (decimal_points & (1 << i))
 		{
-			// Send the command to write "0" on the seven-segment display if the value is zero
-			SSI2_Write(number_pattern[0]);
+			patterns[i] &= ~DISPLAY_DECIMAL_POINT;
 		}
-		else
+	}
+	
+	// The digit with the rightmost decimal point holds the units of the seconds
+	// It is always shown, together with the fraction digits to its right
+	uint8_t lit_digits = 1;
+	while ((lit_digits < DISPLAY_DIGIT_COUNT) && ((decimal_points & ((1 << lit_digits) - 1)) == 0))
+	{
+		lit_digits++;
+	}
+	
+	// Blank the leading zeros to the left of the units
+	for (uint8_t i = lit_digits; i < DISPLAY_DIGIT_COUNT; i++)
+	{
+		if (stopwatch_value[i] != 0)
 		{
-			// Send the corresponding digit on the seven-segment display
-			SSI2_Write(number_pattern[stopwatch_value[stopwatch_value_idx]]);
+			lit_digits = i + 1;
 		}
-		
-		// Send the command to write each digit in the correct place on the seven-segment display
-		SSI2_Write(i);
-		
-		// Increment a counter to move to the next digit of the stopwatch value
-		stopwatch_value_idx++;
-		
-		// Provide a 1 ms delay between each segment update
-		SysTick_Delay1ms(1);
 	}
+	
+	Seven_Segment_Display_Scan(patterns, lit_digits);
+}
+
+void Seven_Segment_Display_Set_Adaptive_Scan(uint8_t enable)
+{
+	adaptive_scan = enable;
+}
+
+void Seven_Segment_Display_Get_Stats(Seven_Segment_Display_Stats *stats)
+{
+	*stats = display_stats;
+}
+
+void Seven_Segment_Display_Get_Telemetry(Seven_Segment_Display_Telemetry *telemetry)
+{
+	*telemetry = display_telemetry;
 }
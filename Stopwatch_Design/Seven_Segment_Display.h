@@ -6,43 +6,77 @@
  * This file contains the function definitions for the Seven_Segment_Display driver.
  * It interfaces with the Seven-Segment Display module on the EduBase board.
  *
- * @note Assumes that a 16 MHz clock is used.
+ * @note Assumes that a 50 MHz system clock is used.
  *
  * @author Aaron Nanas
  */
 
 #include "TM4C123GH6PM.h"
 #include "SysTick_Delay.h"
+#include "SSI.h"
 
 extern const uint8_t number_pattern[16];
 
+// Number of digits on the display
+#define DISPLAY_DIGIT_COUNT				4
+
+// Segment pattern of a blank digit (active low)
+#define DISPLAY_BLANK_PATTERN			0xFF
+
+// Segment of the decimal point (active low)
+#define DISPLAY_DECIMAL_POINT			0x80
+
+// Time to scan all lit digits once in microseconds
+#define DISPLAY_SCAN_PERIOD_US		4000
+
+typedef struct
+{
+	uint32_t scans;					// Number of scans (display frames)
+	uint32_t transactions;			// Number of SSI transactions submitted for the display
+	uint32_t dropped;				// Number of digit frames dropped because every frame buffer was in flight
+	uint32_t wait_cycles;			// System clock cycles spent waiting between the digits of a scan
+} Seven_Segment_Display_Stats;
+
+typedef struct
+{
+	uint16_t frames_per_second;		// Scans per second
+	uint16_t transactions_per_second;	// SSI transactions (chip select windows) per second
+	uint32_t bytes_per_second;		// Bytes sent on SSI2 per second
+	uint16_t bus_busy_permille;		// Share of the time in which an SSI2 transaction was in progress
+	uint16_t isr_load_permille;		// Share of the CPU time spent in the SSI2 interrupt handler
+	uint16_t wait_load_permille;	// Share of the CPU time spent waiting between the digits of a scan
+} Seven_Segment_Display_Telemetry;
+
 /**
  * @brief Initializes the Seven-Segment Display module on the EduBase board.
  *
  * This function initializes the pins connected to the shift register ICs that will communicate
  * with the Seven-Segment Display module on the EduBase board. It configures the
- * Synchronous Serial Interface 2 (SSI2) peripheral to operate in SPI mode.
+ * Synchronous Serial Interface 2 (SSI2) peripheral to operate in SPI mode through the SSI driver.
  *
  * @param None
  *
  * @return None
  *
- * @note Assumes that a 16 MHz clock is used.
+ * @note Assumes that a 50 MHz system clock is used.
  */
 void Seven_Segment_Display_Init(void);
 
 /**
- * @brief Transmits data using the SSI2 module.
+ * @brief Writes one digit to the Seven-Segment Display module on the EduBase board.
  *
- * This function writes the specified data to the Transmit Buffer of the SSI2 peripheral.
- * It asserts the slave select pin, writes the data to the SSI data register, waits for the data transmission to complete,
- * and then deasserts the slave select pin.
+ * This function queues a two-byte SSI2 transaction that sends the segment pattern and the
+ * digit select to the shift registers while the slave select pin (PC7) is asserted.
+ * It returns without waiting for the transfer. The frame is dropped if the previous
+ * frames are still being sent.
  *
- * @param data The 8-bit data to be written.
+ * @param pattern The segment pattern of the digit (active low).
+ *
+ * @param digit_select The bit of the digit to be enabled (0x01, 0x02, 0x04 or 0x08).
  *
  * @return None
  */
-void SSI2_Write(uint8_t data);
+void Seven_Segment_Display_Write(uint8_t pattern, uint8_t digit_select);
 
 /**
  * @brief Counts the number of digits in an integer value.
@@ -62,7 +96,8 @@ int Count_Digits(int value);
  *
  * This function displays the specified number in decimal representation on the Seven-Segment Display module.
  * It calculates the number of digits in the value, extracts each digit, retrieves the corresponding pattern from
- * the number_pattern array, and writes the pattern to the seven-segment display sequentially.
+ * the number_pattern array, and scans the digits once without the leading zeros. Only the four least
+ * significant digits are shown. Negative values are shown as 0.
  *
  * @param count_value The decimal number to be displayed on the Seven-Segment Display module.
  *
@@ -75,14 +110,55 @@ void Seven_Segment_Display(int count_value);
  *
  * This function displays the stopwatch value, represented by an array of integers,
  * on a seven-segment display. It writes the corresponding pattern for each digit of 
- * the stopwatch value. If a digit is 0, it displays "0" on the segment. Otherwise, it 
- * displays the corresponding digit. It provides a short delay (1 ms) between each
- * segment update.
+ * the stopwatch value. The rightmost decimal point marks the units of the seconds:
+ * that digit and the digits to its right are always shown, and the leading zeros to
+ * its left are blanked. The lit digits share the 4 ms scan period evenly.
  *
  * @param stopwatch_value An array of integers representing the stopwatch value.
- *                        Each integer corresponds to a digit of the stopwatch value.
- *                        The array must have a length of 8.
+ *                        Each integer corresponds to a digit of the stopwatch value,
+ *                        starting with the rightmost digit. The array must have a length of 4.
+ *
+ * @param decimal_points The digits that show a decimal point (Bit N for the digit at Index N).
+ *
+ * @return None
+ */
+void Seven_Segment_Display_Stopwatch(uint8_t stopwatch_value[], uint8_t decimal_points);
+
+/**
+ * @brief Enables or disables the adaptive scan.
+ *
+ * With the adaptive scan disabled, all four digits are written in every scan including
+ * the leading zeros, which allows the SSI traffic of both schedules to be compared.
+ *
+ * @param enable 0x01 to blank leading zeros and skip unchanged frames (default), 0x00 to scan all digits.
+ *
+ * @return None
+ */
+void Seven_Segment_Display_Set_Adaptive_Scan(uint8_t enable);
+
+/**
+ * @brief Reads the counters of the display path.
+ *
+ * The counters wrap around, so rates are calculated from the difference of two readings.
+ * By calculation, a full scan of four digits every 4 ms submits 1000 transactions per second, while
+ * a stopwatch value below 10 seconds with the adaptive scan submits 500 transactions per second.
+ * These rates have not been measured on a board yet; main.c keeps the measured telemetry in
+ * display_telemetry for both settings of DISPLAY_ADAPTIVE_SCAN.
+ *
+ * @param stats Pointer to the structure that receives the counters.
+ *
+ * @return None
+ */
+void Seven_Segment_Display_Get_Stats(Seven_Segment_Display_Stats *stats);
+
+/**
+ * @brief Reads the display telemetry of the last full second.
+ *
+ * The rates are calculated from the display and SSI2 counters at the end of the first scan
+ * after every second, so they can be compared between display transports and scan schedules.
+ *
+ * @param telemetry Pointer to the structure that receives the telemetry.
  *
  * @return None
  */
-void Seven_Segment_Display_Stopwatch(uint8_t stopwatch_value[]);
+void Seven_Segment_Display_Get_Telemetry(Seven_Segment_Display_Telemetry *telemetry);
@@ -4,78 +4,182 @@
  * @brief Source code for the SysTick_Delay driver.
  *
  * It provides two blocking functions, SysTick_Delay1ms and SysTick_Delay1us,
- * to create a delay with a busy-wait loop. It uses the SysTick timer with 
- * a specified reload value to generate interrupts every 1 us.
+ * to create a delay with a busy-wait loop on the DWT cycle counter (CYCCNT),
+ * which counts every cycle of the system clock.
  * 
- * In addition, it uses the Peripheral Internal Oscillator (PIOSC) 
- * as the clock source. The PIOSC provides 16 MHz which is then divided by 4. 
- * The timer is used for creating delays in either microseconds or milliseconds.
+ * SysTick_Delay_Init runs a calibration pass that measures the fixed number of cycles
+ * spent in a delay call (call, setup, and return) and the cost of entering and leaving
+ * an interrupt with the cycle counter. The delay functions subtract the measured call
+ * overhead, so short delays are not systematically long.
  *
  * @author Aaron Nanas
  */
 
 #include "SysTick_Delay.h"
 
-// Global variable used to keep track of elapsed time in microseconds
-static uint32_t us_elapsed = 0;
+// Number of measurements of each calibration value (the smallest result is used)
+#define CALIBRATION_RUNS		8
 
-// Global variable used to keep track of elapsed time in milliseconds
-static uint32_t ms_elapsed = 0;
+// System clock cycles per microsecond
+static uint32_t cycles_per_us = 50;
 
-// Global flag used to indicate if milliseconds delay is active
-static uint8_t ms_active = 0;
+// Cycles spent in a call of SysTick_Delay1us in addition to the requested delay
+static uint32_t delay_overhead_cycles = 0;
+
+// Cycles from the request of an interrupt to the first instruction of its handler
+static uint32_t isr_entry_cycles = 0;
+
+// Cycles from the request of an interrupt until the interrupted code continues (with an empty handler)
+static uint32_t isr_round_trip_cycles = 0;
+
+// Cycle counter value recorded by the SysTick handler during the calibration
+static volatile uint32_t isr_entry_timestamp = 0;
+
+/**
+ * @brief Waits until a number of cycles has elapsed since a cycle counter value.
+ *
+ * @param start The value of the cycle counter at the start of the delay.
+ *
+ * @param cycles The number of cycles to wait.
+ *
+ * @return None
+ */
+static void SysTick_Delay_Wait_Cycles(uint32_t start, uint32_t cycles)
+{
+	// The unsigned subtraction is correct when the cycle counter wraps around
+	while ((DWT->CYCCNT - start) < cycles);
+}
+
+/**
+ * @brief Measures the overhead of a delay call and of an interrupt with the cycle counter.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void SysTick_Delay_Calibrate(void)
+{
+	uint32_t min_delay = 0xFFFFFFFF;
+	uint32_t min_entry = 0xFFFFFFFF;
+	uint32_t min_round_trip = 0xFFFFFFFF;
+	uint32_t min_read = 0xFFFFFFFF;
+	
+	// Measure the cycles between two back-to-back reads of the cycle counter
+	// This is subtracted from the other measurements
+	for (uint8_t i = 0; i < CALIBRATION_RUNS; i++)
+	{
+		uint32_t start = DWT->CYCCNT;
+		uint32_t end = DWT->CYCCNT;
+		if ((end - start) < min_read)
+		{
+			min_read = end - start;
+		}
+	}
+	
+	// Measure a delay of 1 us without correction. Interrupts that occur during a
+	// measurement only make it longer, so the smallest result is used.
+	delay_overhead_cycles = 0;
+	for (uint8_t i = 0; i < CALIBRATION_RUNS; i++)
+	{
+		uint32_t start = DWT->CYCCNT;
+		SysTick_Delay1us(1);
+		uint32_t end = DWT->CYCCNT;
+		if ((end - start) < min_delay)
+		{
+			min_delay = end - start;
+		}
+	}
+	
+	// Measure the entry and the round trip of the SysTick exception
+	// Enable the SysTick interrupt without starting the counter
+	SysTick->CTRL = 0x02;
+	for (uint8_t i = 0; i < CALIBRATION_RUNS; i++)
+	{
+		isr_entry_timestamp = 0;
+		uint32_t start = DWT->CYCCNT;
+		
+		// Pend the SysTick exception by setting the PENDSTSET bit (Bit 26) of the ICSR register
+		SCB->ICSR = 0x04000000;
+		__DSB();
+		__ISB();
+		
+		uint32_t end = DWT->CYCCNT;
+		if ((isr_entry_timestamp != 0) && ((isr_entry_timestamp - start) < min_entry))
+		{
+			min_entry = isr_entry_timestamp - start;
+		}
+		if ((end - start) < min_round_trip)
+		{
+			min_round_trip = end - start;
+		}
+	}
+	SysTick->CTRL = 0;
+	
+	delay_overhead_cycles = (min_delay > (cycles_per_us + min_read)) ? (min_delay - cycles_per_us - min_read) : 0;
+	isr_entry_cycles = ((min_entry != 0xFFFFFFFF) && (min_entry > min_read)) ? (min_entry - min_read) : 0;
+	isr_round_trip_cycles = (min_round_trip > min_read) ? (min_round_trip - min_read) : 0;
+}
 
 void SysTick_Delay_Init(void)
 {	
-	// Set the SysTick timer reload value for 1 us intervals
-	// Each clock cycle is (1 / 4 MHz) = 0.25 us
-	SysTick->LOAD = (4 - 1);
+	// Read the system clock frequency from the clock configuration registers
+	SystemCoreClockUpdate();
+	cycles_per_us = SystemCoreClock / 1000000;
 	
-	// Clear the VAL register by writing any value to it
-	SysTick->VAL = 0;
+	// Enable the trace unit (TRCENA, Bit 24 of DEMCR) and start the DWT cycle counter
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
 	
-	// Enable the SysTick timer and its interrupt
-	// with the Peripheral Internal Oscillator (PIOSC) as the clock source
-	SysTick->CTRL |= 0x03;
+	// Measure the overhead of the delay function and of an interrupt
+	SysTick_Delay_Calibrate();
 }
 
 void SysTick_Delay1us(uint32_t delay_in_us)
 {
-	// Reset the global variable, us_elapsed
-	us_elapsed = 0;
+	uint32_t start = DWT->CYCCNT;
+	uint32_t cycles = delay_in_us * cycles_per_us;
 	
-	// Wait until ms_value reaches the specified delay_in_ms
-	while (delay_in_us > us_elapsed);
+	// Return immediately if the delay is shorter than the overhead of the call
+	if (cycles <= delay_overhead_cycles)
+	{
+		return;
+	}
+	
+	// Wait until the requested time minus the measured overhead has elapsed
+	SysTick_Delay_Wait_Cycles(start, cycles - delay_overhead_cycles);
 }
 
 void SysTick_Delay1ms(uint32_t delay_in_ms)
 {
-	// Reset the global variables, us_elapsed and ms_elapsed
-	us_elapsed = 0;
-	ms_elapsed = 0;
-	
-	// Set the ms_active global flag
-	ms_active = 0x01;
-	
-	// Wait until ms_elapsed reaches the specified delay_in_ms
-	while (delay_in_ms > ms_elapsed);
+	uint32_t start = DWT->CYCCNT;
+	uint32_t cycles_per_ms = cycles_per_us * 1000;
 	
-	// Reset the ms_active global flag
-	ms_active = 0x00;
+	// Wait one millisecond at a time so that long delays do not overflow the cycle count
+	for (uint32_t i = 0; i < delay_in_ms; i++)
+	{
+		SysTick_Delay_Wait_Cycles(start, cycles_per_ms);
+		start = start + cycles_per_ms;
+	}
+}
+
+uint32_t SysTick_Delay_Get_Cycles_Per_us(void)
+{
+	return cycles_per_us;
+}
+
+uint32_t SysTick_Delay_Get_ISR_Entry_Cycles(void)
+{
+	return isr_entry_cycles;
+}
+
+uint32_t SysTick_Delay_Get_ISR_Round_Trip_Cycles(void)
+{
+	return isr_round_trip_cycles;
 }
 
 void SysTick_Handler(void)
 {
-	// Increment the global variable, us_elapsed
-	us_elapsed = us_elapsed + 1;
-	
-	// Check if us_elapsed has reached 1000 (1 millisecond) and if milliseconds delay is active
-	if (us_elapsed == 1000 && (ms_active == 0x01))
-	{
-		// Reset us_elapsed
-		us_elapsed = 0;
-		
-		// Increment ms_elapsed to indicate that 1 millisecond has passed
-		ms_elapsed = ms_elapsed + 1;
-	}
+	// Record the time of entry during the calibration
+	isr_entry_timestamp = DWT->CYCCNT;
 }
@@ -4,12 +4,16 @@
  * @brief Header file for the SysTick_Delay driver.
  *
  * It provides two blocking functions, SysTick_Delay1ms and SysTick_Delay1us,
- * to create a delay with a busy-wait loop. It uses the SysTick timer with 
- * a specified reload value to generate interrupts every 1 us.
+ * to create a delay with a busy-wait loop on the DWT cycle counter (CYCCNT),
+ * which counts every cycle of the system clock.
  * 
- * In addition, it uses the Peripheral Internal Oscillator (PIOSC) 
- * as the clock source. The PIOSC provides 16 MHz which is then divided by 4. 
- * The timer is used for creating delays in either microseconds or milliseconds.
+ * The number of cycles per microsecond is derived from the clock configuration when
+ * SysTick_Delay_Init is called, so the delays are correct at any system clock setting.
+ * A calibration pass then measures the fixed overhead of a delay call and the cost of
+ * an interrupt entry and exit with the cycle counter. The call overhead is subtracted
+ * from every delay, and the interrupt costs can be read by other drivers.
+ *
+ * The SysTick timer is only used during the calibration to measure the interrupt overhead.
  *
  * @author Aaron Nanas
  */
@@ -17,12 +21,11 @@
 #include "TM4C123GH6PM.h"
 
 /**
- * @brief The SysTick_Delay_Init function initializes the SysTick timer to be used for a blocking delay function.
+ * @brief The SysTick_Delay_Init function initializes the cycle counter used by the blocking delay functions.
  *
- * This function configures the SysTick timer and its interrupt with a specified reload value to 
- * generate interrupts every 1 us. It uses the Peripheral Internal Oscillator (PIOSC) as the clock source.
- * The PIOSC provides 16 MHz which is then divided by 4. The timer is used for creating delays in either 
- * microseconds or milliseconds.
+ * This function reads the system clock frequency, enables the DWT cycle counter, and measures
+ * the overhead of a delay call and of an interrupt. It must be called again if the system clock
+ * is changed. Interrupts must be enabled for the interrupt overhead to be measured.
  *
  * @param None
  *
@@ -31,10 +34,11 @@
 void SysTick_Delay_Init(void);
 
 /**
- * @brief The SysTick_Delay1us function provides a blocking delay in microseconds using the SysTick timer.
+ * @brief The SysTick_Delay1us function provides a blocking delay in microseconds.
  *
- * This function resets the global variable, us_elapsed, to zero and waits until us_elapsed reaches 
- * the specified delay_in_us.
+ * This function waits until the specified time minus the measured overhead of the call has elapsed
+ * on the cycle counter. Interrupts that occur during the delay do not make it longer unless they
+ * are still running when the delay ends.
  *
  * @param delay_in_us The delay time in microseconds.
  *
@@ -43,11 +47,9 @@ void SysTick_Delay_Init(void);
 void SysTick_Delay1us(uint32_t delay_in_us);
 
 /**
- * @brief The SysTick_Delay1ms function provides a blocking delay in milliseconds using the SysTick timer.
+ * @brief The SysTick_Delay1ms function provides a blocking delay in milliseconds.
  *
- * This function clears the global variables, us_elapsed and ms_elapsed, to zero and sets ms_active flag to 0x01 
- * indicating that milliseconds delay is active. It then waits until ms_elapsed reaches the specified delay_in_ms.
- * After the delay, it clears ms_active flag back to 0x00.
+ * This function waits for the specified number of milliseconds on the cycle counter.
  *
  * @param delay_in_ms The delay time in milliseconds.
  *
@@ -55,12 +57,38 @@ void SysTick_Delay1us(uint32_t delay_in_us);
  */
 void SysTick_Delay1ms(uint32_t delay_in_ms);
 
+/**
+ * @brief Returns the number of system clock cycles per microsecond used by the delay functions.
+ *
+ * @param None
+ *
+ * @return The number of cycles per microsecond.
+ */
+uint32_t SysTick_Delay_Get_Cycles_Per_us(void);
+
+/**
+ * @brief Returns the measured number of cycles from an interrupt request to the first instruction of its handler.
+ *
+ * @param None
+ *
+ * @return The interrupt entry latency in system clock cycles, or 0 if it could not be measured.
+ */
+uint32_t SysTick_Delay_Get_ISR_Entry_Cycles(void);
+
+/**
+ * @brief Returns the measured number of cycles that an interrupt with an empty handler takes from the interrupted code.
+ *
+ * @param None
+ *
+ * @return The interrupt entry and exit time in system clock cycles.
+ */
+uint32_t SysTick_Delay_Get_ISR_Round_Trip_Cycles(void);
+
 /**
  * @brief The SysTick_Handler function is the interrupt service routine for the SysTick timer.
  *
- * This function is called whenever the SysTick timer generates an interrupt. It increments the global variable
- * us_elapsed by 1, indicating that 1 microsecond has passed. Additionally, if us_elapsed reaches 1000 and ms_active
- * flag is set to 0x01, it resets us_elapsed and increments ms_elapsed by 1, indicating that 1 millisecond has passed.
+ * This function is only executed during the calibration. It records the value of the cycle counter
+ * to measure the interrupt entry latency.
  *
  * @param None
  *
@@ -0,0 +1,176 @@
+/**
+ * @file Temperature_Compensation.c
+ *
+ * @brief Source code for the Temperature_Compensation driver.
+ *
+ * This file contains the function definitions for the Temperature_Compensation driver.
+ * It compensates the frequency drift of the oscillator over temperature.
+ *
+ * Timer 1A triggers a conversion of the internal temperature sensor on ADC0 sample sequencer 3
+ * once per TEMPERATURE_COMPENSATION_PERIOD_MS without any CPU involvement. The ADC0 sequence 3
+ * interrupt filters the temperature, looks up the frequency error of the oscillator in the
+ * per-board correction curve, and applies the opposite correction to the time base as a rate trim.
+ *
+ * @note This driver assumes that the system clock's frequency is 50 MHz.
+ *
+ * @author Katherine Poz
+ */
+
+#include "Temperature_Compensation.h"
+
+// Weight of a new sample in the temperature filter (1 / 2^TEMPERATURE_FILTER_SHIFT)
+#define TEMPERATURE_FILTER_SHIFT		3
+
+// Correction curve of this board
+static const Temperature_Compensation_Point *correction_curve;
+static uint8_t correction_points = 0;
+
+// Filtered temperature, scaled by 2^TEMPERATURE_FILTER_SHIFT
+static int32_t filtered_temperature = 0;
+static uint8_t filter_valid = 0x00;
+
+// 0x01 while the compensation holds the clocks of ADC0 and Timer 1
+static uint8_t compensation_running = 0x00;
+
+void Temperature_Compensation_Init(const Temperature_Compensation_Point *curve, uint8_t num_points)
+{
+	correction_curve = curve;
+	correction_points = num_points;
+	filter_valid = 0x00;
+
+	// Acquire the clock to ADC0 in run and sleep mode and wait until it is ready to be accessed
+	// ADC0 keeps its single reference if the compensation is started again
+	if (compensation_running == 0x00)
+	{
+		Clock_Gating_Acquire(CLOCK_GATING_ADC, 0x01, CLOCK_GATING_RUN_SLEEP);
+		compensation_running = 0x01;
+	}
+
+	// Disable sample sequencer 3 during configuration by clearing the ASEN3 bit (Bit 3)
+	ADC0->ACTSS &= ~0x08;
+
+	// Select the timer as the trigger for sample sequencer 3 (EM3 field, Bits 15 to 12 = 0x5)
+	ADC0->EMUX = (ADC0->EMUX & ~0xF000) | 0x5000;
+
+	// Sample the temperature sensor (TS0, Bit 3), set the interrupt flag (IE0, Bit 2)
+	// and end the sequence (END0, Bit 1) after the first sample
+	ADC0->SSMUX3 = 0;
+	ADC0->SSCTL3 = 0x0E;
+
+	// Average 64 samples in hardware to reduce the noise of the temperature sensor
+	ADC0->SAC = 0x6;
+
+	// Clear the interrupt flag and enable the interrupt for sample sequencer 3
+	ADC0->ISC = 0x08;
+	ADC0->IM |= 0x08;
+
+	// Set the priority level of the interrupt to 3. ADC0 sequence 3 has an Interrupt Request (IRQ) number of 17
+	NVIC_SetPriority(ADC0SS3_IRQn, 3);
+
+	// Enable IRQ 17 for ADC0 sequence 3
+	NVIC_EnableIRQ(ADC0SS3_IRQn);
+
+	// Enable sample sequencer 3
+	ADC0->ACTSS |= 0x08;
+
+	// Configure Timer 1A as a periodic timer with an interval of TEMPERATURE_COMPENSATION_PERIOD_MS
+	// using the 50 MHz system clock. No interrupt is needed, the time-out only triggers the ADC.
+	GPTM_Init_Periodic(GPTM_TIMER1, 50000 * TEMPERATURE_COMPENSATION_PERIOD_MS, 0, 0);
+
+	// Enable the ADC trigger output and start Timer 1A
+	GPTM_Enable_ADC_Trigger(GPTM_TIMER1);
+	GPTM_Enable(GPTM_TIMER1, GPTM_TIMER_A);
+}
+
+void Temperature_Compensation_Stop(void)
+{
+	if (compensation_running == 0x00)
+	{
+		return;
+	}
+
+	// Stop the trigger and release Timer 1
+	GPTM_Deinit(GPTM_TIMER1);
+
+	// Disable IRQ 17, mask the interrupt of sample sequencer 3 and disable the sequencer
+	NVIC_DisableIRQ(ADC0SS3_IRQn);
+	ADC0->IM &= ~0x08;
+	ADC0->ACTSS &= ~0x08;
+	ADC0->ISC = 0x08;
+
+	// Release the reference of ADC0 to its clock
+	Clock_Gating_Release(CLOCK_GATING_ADC, 0x01, CLOCK_GATING_RUN_SLEEP);
+	compensation_running = 0x00;
+
+	// Remove the correction from the time base
+	Time_Base_Set_Temperature_Trim(0);
+}
+
+int32_t Temperature_Compensation_Convert(uint32_t adc_code)
+{
+	// TEMP = 147.5 - ((75 * 3.3 * ADCCODE) / 4096)
+	// In 0.01 degrees Celsius: 14750 - ((24750 * ADCCODE) / 4096)
+	return 14750 - (int32_t)((24750 * adc_code) / 4096);
+}
+
+int32_t Temperature_Compensation_Lookup(const Temperature_Compensation_Point *curve, uint8_t num_points, int32_t temperature_centi_c)
+{
+	if (num_points == 0)
+	{
+		return 0;
+	}
+
+	// Hold the frequency error constant outside of the curve
+	if (temperature_centi_c <= curve[0].temperature_centi_c)
+	{
+		return curve[0].frequency_error_ppb;
+	}
+
+	if (temperature_centi_c >= curve[num_points - 1].temperature_centi_c)
+	{
+		return curve[num_points - 1].frequency_error_ppb;
+	}
+
+	// Find the segment that contains the temperature and interpolate linearly
+	uint8_t i = 1;
+	while (temperature_centi_c > curve[i].temperature_centi_c)
+	{
+		i++;
+	}
+
+	int32_t t0 = curve[i - 1].temperature_centi_c;
+	int32_t t1 = curve[i].temperature_centi_c;
+	int32_t e0 = curve[i - 1].frequency_error_ppb;
+	int32_t e1 = curve[i].frequency_error_ppb;
+
+	return e0 + (int32_t)(((int64_t)(e1 - e0) * (temperature_centi_c - t0)) / (t1 - t0));
+}
+
+int32_t Temperature_Compensation_Get_Temperature(void)
+{
+	return filtered_temperature >> TEMPERATURE_FILTER_SHIFT;
+}
+
+void ADC0SS3_Handler(void)
+{
+	// Read the temperature sensor sample from the FIFO of sample sequencer 3
+	int32_t temperature_centi_c = Temperature_Compensation_Convert(ADC0->SSFIFO3 & 0xFFF);
+
+	// Acknowledge the interrupt of sample sequencer 3 and clear it
+	ADC0->ISC = 0x08;
+
+	// Filter the temperature with a first-order low-pass filter
+	if (filter_valid == 0x00)
+	{
+		filtered_temperature = temperature_centi_c << TEMPERATURE_FILTER_SHIFT;
+		filter_valid = 0x01;
+	}
+	else
+	{
+		filtered_temperature = filtered_temperature + temperature_centi_c - (filtered_temperature >> TEMPERATURE_FILTER_SHIFT);
+	}
+
+	// Run the time base slower when the oscillator runs fast and vice versa
+	int32_t frequency_error_ppb = Temperature_Compensation_Lookup(correction_curve, correction_points, Temperature_Compensation_Get_Temperature());
+	Time_Base_Set_Temperature_Trim(-frequency_error_ppb);
+}
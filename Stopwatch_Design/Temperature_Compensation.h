@@ -0,0 +1,111 @@
+/**
+ * @file Temperature_Compensation.h
+ *
+ * @brief Header file for the Temperature_Compensation driver.
+ *
+ * This file contains the function definitions for the Temperature_Compensation driver.
+ * It compensates the frequency drift of the oscillator over temperature.
+ *
+ * Timer 1A triggers a conversion of the internal temperature sensor on ADC0 sample sequencer 3
+ * once per TEMPERATURE_COMPENSATION_PERIOD_MS without any CPU involvement. The ADC0 sequence 3
+ * interrupt filters the temperature, looks up the frequency error of the oscillator in the
+ * per-board correction curve, and applies the opposite correction to the time base as a rate trim.
+ *
+ * The correction curve is a table of points (temperature, frequency error) sorted by temperature.
+ * The frequency error between two points is interpolated linearly and held constant outside the table.
+ *
+ * @note This driver assumes that the system clock's frequency is 50 MHz.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef TEMPERATURE_COMPENSATION_H
+#define TEMPERATURE_COMPENSATION_H
+
+#include "TM4C123GH6PM.h"
+#include "Time_Base.h"
+#include "GPTM.h"
+#include "Clock_Gating.h"
+
+// Interval between temperature samples in milliseconds
+#define TEMPERATURE_COMPENSATION_PERIOD_MS		1000
+
+typedef struct
+{
+	int16_t temperature_centi_c;		// Temperature in 0.01 degrees Celsius
+	int32_t frequency_error_ppb;		// Measured frequency error of the oscillator in parts per billion
+} Temperature_Compensation_Point;
+
+/**
+ * @brief Initializes the temperature sampling and starts the compensation.
+ *
+ * This function configures ADC0 sample sequencer 3 to sample the internal temperature sensor
+ * whenever Timer 1A times out, and configures Timer 1A as a periodic trigger.
+ * The ADC0 sequence 3 interrupt priority is set to 3.
+ *
+ * @param curve Pointer to the correction curve of this board, sorted by temperature.
+ *
+ * @param num_points The number of points in the correction curve.
+ *
+ * @return None
+ */
+void Temperature_Compensation_Init(const Temperature_Compensation_Point *curve, uint8_t num_points);
+
+/**
+ * @brief Stops the compensation and releases ADC0 and Timer 1.
+ *
+ * The temperature trim of the time base is cleared. The clocks are gated if no other driver
+ * holds a reference to them. Temperature_Compensation_Init starts the compensation again.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Temperature_Compensation_Stop(void);
+
+/**
+ * @brief Converts a temperature sensor reading into a temperature.
+ *
+ * TEMP = 147.5 - ((75 * 3.3 V * ADCCODE) / 4096)
+ *
+ * @param adc_code The 12-bit conversion result of the temperature sensor.
+ *
+ * @return The temperature in 0.01 degrees Celsius.
+ */
+int32_t Temperature_Compensation_Convert(uint32_t adc_code);
+
+/**
+ * @brief Looks up the frequency error at a temperature in a correction curve.
+ *
+ * @param curve Pointer to the correction curve, sorted by temperature.
+ *
+ * @param num_points The number of points in the correction curve.
+ *
+ * @param temperature_centi_c The temperature in 0.01 degrees Celsius.
+ *
+ * @return The interpolated frequency error in parts per billion.
+ */
+int32_t Temperature_Compensation_Lookup(const Temperature_Compensation_Point *curve, uint8_t num_points, int32_t temperature_centi_c);
+
+/**
+ * @brief Returns the filtered temperature.
+ *
+ * @param None
+ *
+ * @return The temperature in 0.01 degrees Celsius.
+ */
+int32_t Temperature_Compensation_Get_Temperature(void);
+
+/**
+ * @brief The interrupt service routine (ISR) for ADC0 sample sequencer 3.
+ *
+ * This function reads the temperature sensor sample, filters it, and updates the
+ * temperature trim of the time base.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void ADC0SS3_Handler(void);
+
+#endif
@@ -0,0 +1,259 @@
+/**
+ * @file Text_Format.c
+ *
+ * @brief Source code for the Text_Format driver.
+ *
+ * This file contains the function definitions for the Text_Format driver.
+ * It formats human-readable text (UART debug messages, display lines, scrolling text)
+ * into a caller-provided buffer without using the heap, varargs, or a format string
+ * that has to be parsed at runtime.
+ *
+ * @author Katherine Poz
+ */
+
+#include "Text_Format.h"
+
+#ifdef TEXT_FORMAT_BENCHMARK
+#include <stdio.h>
+#endif
+
+// Characters used for hexadecimal digits
+static const char hex_digits[16] =
+{
+	'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+/**
+ * @brief Appends the decimal digits of value, padded on the left to at least width characters.
+ *
+ * @param buffer Pointer to the Text_Buffer.
+ *
+ * @param value The value to be appended.
+ *
+ * @param width The minimum number of characters.
+ *
+ * @param pad The character used for padding.
+ *
+ * @return None
+ */
+static void Text_Append_Decimal(Text_Buffer *buffer, uint32_t value, uint8_t width, char pad)
+{
+	// Collect the digits starting with the least significant one
+	char digits[10];
+	uint8_t num_digits = 0;
+
+	do
+	{
+		digits[num_digits] = (char)('0' + (value % 10));
+		value = value / 10;
+		num_digits++;
+	}
+	while (value != 0);
+
+	for (uint8_t i = num_digits; i < width; i++)
+	{
+		Text_Append_Char(buffer, pad);
+	}
+
+	while (num_digits > 0)
+	{
+		num_digits--;
+		Text_Append_Char(buffer, digits[num_digits]);
+	}
+}
+
+void Text_Buffer_Init(Text_Buffer *buffer, char *data, uint16_t size)
+{
+	buffer->data = data;
+	buffer->size = size;
+	Text_Buffer_Clear(buffer);
+}
+
+void Text_Buffer_Clear(Text_Buffer *buffer)
+{
+	buffer->length = 0;
+	buffer->overflow = 0x00;
+
+	if (buffer->size > 0)
+	{
+		buffer->data[0] = '\0';
+	}
+}
+
+void Text_Append_Char(Text_Buffer *buffer, char character)
+{
+	// Always keep room for the null terminator
+	if ((buffer->length + 1) < buffer->size)
+	{
+		buffer->data[buffer->length] = character;
+		buffer->length++;
+		buffer->data[buffer->length] = '\0';
+	}
+	else
+	{
+		buffer->overflow = 0x01;
+	}
+}
+
+void Text_Append_String(Text_Buffer *buffer, const char *string)
+{
+	while (*string != '\0')
+	{
+		Text_Append_Char(buffer, *string);
+		string++;
+	}
+}
+
+void Text_Append_Int32(Text_Buffer *buffer, int value)
+{
+	Text_Append_Int(buffer, (Text_Int){ value, 0, ' ' });
+}
+
+void Text_Append_Uint32(Text_Buffer *buffer, unsigned int value)
+{
+	Text_Append_Decimal(buffer, value, 0, ' ');
+}
+
+void Text_Append_Long(Text_Buffer *buffer, long value)
+{
+	Text_Append_Int(buffer, (Text_Int){ (int32_t)value, 0, ' ' });
+}
+
+void Text_Append_Ulong(Text_Buffer *buffer, unsigned long value)
+{
+	Text_Append_Decimal(buffer, (uint32_t)value, 0, ' ');
+}
+
+void Text_Append_Uint(Text_Buffer *buffer, Text_Uint argument)
+{
+	Text_Append_Decimal(buffer, argument.value, argument.width, argument.pad);
+}
+
+void Text_Append_Int(Text_Buffer *buffer, Text_Int argument)
+{
+	uint32_t magnitude = (argument.value < 0) ? (0 - (uint32_t)argument.value) : (uint32_t)argument.value;
+	uint8_t sign_width = (argument.value < 0) ? 1 : 0;
+	uint8_t num_digits = 1;
+
+	// Count the digits to place the padding in front of the sign
+	for (uint32_t remaining = magnitude / 10; remaining != 0; remaining = remaining / 10)
+	{
+		num_digits++;
+	}
+
+	for (uint8_t i = num_digits + sign_width; i < argument.width; i++)
+	{
+		Text_Append_Char(buffer, argument.pad);
+	}
+
+	if (sign_width != 0)
+	{
+		Text_Append_Char(buffer, '-');
+	}
+
+	Text_Append_Decimal(buffer, magnitude, 0, ' ');
+}
+
+void Text_Append_Hex(Text_Buffer *buffer, Text_Hex argument)
+{
+	// Append the requested number of nibbles starting with the most significant one
+	for (int8_t shift = (int8_t)((argument.digits - 1) * 4); shift >= 0; shift = shift - 4)
+	{
+		Text_Append_Char(buffer, hex_digits[(argument.value >> shift) & 0xF]);
+	}
+}
+
+void Text_Append_Fixed(Text_Buffer *buffer, Text_Fixed argument)
+{
+	uint32_t magnitude = (argument.value < 0) ? (0 - (uint32_t)argument.value) : (uint32_t)argument.value;
+	uint32_t scale = 1;
+
+	for (uint8_t i = 0; i < argument.decimals; i++)
+	{
+		scale = scale * 10;
+	}
+
+	if (argument.value < 0)
+	{
+		Text_Append_Char(buffer, '-');
+	}
+
+	// Integer part followed by the zero-padded fractional part
+	Text_Append_Decimal(buffer, magnitude / scale, 0, ' ');
+
+	if (argument.decimals > 0)
+	{
+		Text_Append_Char(buffer, '.');
+		Text_Append_Decimal(buffer, magnitude % scale, argument.decimals, '0');
+	}
+}
+
+void Text_Append_Time(Text_Buffer *buffer, Text_Time argument)
+{
+	uint32_t minutes = argument.time_ms / 60000;
+	uint32_t seconds = (argument.time_ms / 1000) % 60;
+	uint32_t fraction = argument.time_ms % 1000;
+
+	// Minutes without padding, seconds with two digits
+	Text_Append_Decimal(buffer, minutes, 0, ' ');
+	Text_Append_Char(buffer, ':');
+	Text_Append_Decimal(buffer, seconds, 2, '0');
+
+	// Truncate the milliseconds to the requested number of decimals
+	if (argument.decimals > 0)
+	{
+		for (uint8_t i = argument.decimals; i < 3; i++)
+		{
+			fraction = fraction / 10;
+		}
+
+		Text_Append_Char(buffer, '.');
+		Text_Append_Decimal(buffer, fraction, argument.decimals, '0');
+	}
+}
+
+#ifdef TEXT_FORMAT_BENCHMARK
+
+// Number of calls that are averaged for each measurement
+#define TEXT_FORMAT_BENCHMARK_CALLS		100
+
+void Text_Format_Benchmark(Text_Format_Benchmark_Result *result)
+{
+	char line[32];
+	uint32_t start_cycles;
+	uint32_t lap = 7;
+	uint32_t lap_ms = 83456;
+	uint32_t flags = 0x1A2B;
+
+	// Enable the DWT cycle counter
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	// Measure TEXT_FORMAT
+	start_cycles = DWT->CYCCNT;
+	for (uint32_t i = 0; i < TEXT_FORMAT_BENCHMARK_CALLS; i++)
+	{
+		Text_Buffer text = TEXT_BUFFER(line);
+		TEXT_FORMAT(&text, "Lap ", TEXT_UINT(lap, 2), " ", TEXT_TIME(lap_ms, 2), " 0x", TEXT_HEX(flags, 4));
+	}
+	result->text_format_cycles = (DWT->CYCCNT - start_cycles) / TEXT_FORMAT_BENCHMARK_CALLS;
+
+	// Measure snprintf producing the same text
+	start_cycles = DWT->CYCCNT;
+	for (uint32_t i = 0; i < TEXT_FORMAT_BENCHMARK_CALLS; i++)
+	{
+		snprintf(line, sizeof(line), "Lap %02u %u:%02u.%02u 0x%04X", (unsigned int)lap, (unsigned int)(lap_ms / 60000),
+			(unsigned int)((lap_ms / 1000) % 60), (unsigned int)((lap_ms % 1000) / 10), (unsigned int)flags);
+	}
+	result->snprintf_cycles = (DWT->CYCCNT - start_cycles) / TEXT_FORMAT_BENCHMARK_CALLS;
+
+	// The compiler defines __MICROLIB when the project is linked with microlib
+#ifdef __MICROLIB
+	result->microlib = 0x01;
+#else
+	result->microlib = 0x00;
+#endif
+}
+
+#endif
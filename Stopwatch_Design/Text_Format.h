@@ -0,0 +1,185 @@
+/**
+ * @file Text_Format.h
+ *
+ * @brief Header file for the Text_Format driver.
+ *
+ * This file contains the function definitions for the Text_Format driver.
+ * It formats human-readable text (UART debug messages, display lines, scrolling text)
+ * into a caller-provided buffer without using the heap, varargs, or a format string
+ * that has to be parsed at runtime.
+ *
+ * A message is described as a list of arguments that are passed to the TEXT_FORMAT macro:
+ *
+ *	char line[16];
+ *	Text_Buffer text = TEXT_BUFFER(line);
+ *	TEXT_FORMAT(&text, "Lap ", TEXT_UINT(lap, 2), " ", TEXT_TIME(lap_ms, 2), " 0x", TEXT_HEX(flags, 4));
+ *
+ * Every argument is dispatched at build time with _Generic to the matching append function,
+ * so an argument of an unsupported type, a missing argument, or a field width that is out of range
+ * causes a compile error instead of wrong output at runtime. Field widths, digits and decimals
+ * must be integer constant expressions.
+ * Note that a character constant such as ' ' has the type int in C and is appended as a number,
+ * so single characters are passed as strings (" ") or as char variables.
+ *
+ * The text is always null-terminated. If the buffer is too small, the text is truncated and the
+ * overflow flag of the buffer is set.
+ *
+ * @note Building with TEXT_FORMAT_BENCHMARK defined adds Text_Format_Benchmark, which measures
+ * the cycles per call of TEXT_FORMAT against the snprintf of the linked C library with the DWT
+ * cycle counter. The code size of both is listed in the Image component sizes section of
+ * Listings/Stopwatch_Design.map. The project links the standard C library (Use MicroLIB is off),
+ * since the firmware does not call any stdio function: the Library Totals of the map are 326 bytes
+ * of startup code, which microlib would not reduce. To compare against the smaller snprintf of
+ * microlib, build the benchmark with Use MicroLIB checked; the result records which library was used.
+ * The cycle counts have not been measured on a board yet.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef TEXT_FORMAT_H
+#define TEXT_FORMAT_H
+
+#include "TM4C123GH6PM.h"
+
+typedef struct
+{
+	char *data;				// Caller-provided storage
+	uint16_t size;			// Size of the storage in bytes (including the null terminator)
+	uint16_t length;		// Number of characters written so far
+	uint8_t overflow;		// 0x01 if characters had to be dropped
+} Text_Buffer;
+
+// Argument descriptors created by the TEXT_* macros below
+typedef struct { uint32_t value; uint8_t width; char pad; } Text_Uint;
+typedef struct { int32_t value; uint8_t width; char pad; } Text_Int;
+typedef struct { uint32_t value; uint8_t digits; } Text_Hex;
+typedef struct { int32_t value; uint8_t decimals; } Text_Fixed;
+typedef struct { uint32_t time_ms; uint8_t decimals; } Text_Time;
+
+// Produces a compile error if an argument is out of range or is not an integer constant expression
+// A static assertion is used, since a negative array size in sizeof would become a variable-length array
+#define TEXT_CHECK(condition)					(0 * sizeof(struct { _Static_assert((condition), "TEXT_* argument must be a constant in range"); char valid; }))
+
+/**
+ * @brief Creates a Text_Buffer that writes into a character array.
+ *
+ * The array size is taken with sizeof, so the array must not be a pointer.
+ */
+#define TEXT_BUFFER(array)						{ (array), (uint16_t)(sizeof(array) + TEXT_CHECK(!__builtin_types_compatible_p(__typeof__(array), __typeof__(&(array)[0])))), 0, 0x00 }
+
+// Unsigned decimal, right-aligned to at least width characters with leading zeros or spaces
+#define TEXT_UINT(value, width)				((Text_Uint){ (value), (uint8_t)((width) + TEXT_CHECK((width) <= 10)), '0' })
+#define TEXT_UINT_SPACE(value, width)	((Text_Uint){ (value), (uint8_t)((width) + TEXT_CHECK((width) <= 10)), ' ' })
+
+// Signed decimal, right-aligned to at least width characters with leading spaces
+#define TEXT_INT(value, width)				((Text_Int){ (value), (uint8_t)((width) + TEXT_CHECK((width) <= 11)), ' ' })
+
+// Hexadecimal with exactly digits characters (1 to 8), upper case, no prefix
+#define TEXT_HEX(value, digits)				((Text_Hex){ (value), (uint8_t)((digits) + TEXT_CHECK(((digits) >= 1) && ((digits) <= 8))) })
+
+// Fixed-point value scaled by 10^decimals, e.g. TEXT_FIXED(-1234, 2) = "-12.34"
+#define TEXT_FIXED(value, decimals)		((Text_Fixed){ (value), (uint8_t)((decimals) + TEXT_CHECK((decimals) <= 6)) })
+
+// Stopwatch time in milliseconds formatted as M:SS with 0 to 3 decimals, e.g. TEXT_TIME(83456, 2) = "1:23.45"
+#define TEXT_TIME(time_ms, decimals)	((Text_Time){ (time_ms), (uint8_t)((decimals) + TEXT_CHECK((decimals) <= 3)) })
+
+// Dispatches a single argument to the matching append function at build time
+#define TEXT_APPEND(buffer, argument) _Generic((argument),	\
+	char *: Text_Append_String,															\
+	const char *: Text_Append_String,												\
+	char: Text_Append_Char,																	\
+	signed char: Text_Append_Int32,													\
+	unsigned char: Text_Append_Uint32,											\
+	short: Text_Append_Int32,																\
+	unsigned short: Text_Append_Uint32,											\
+	int: Text_Append_Int32,																	\
+	unsigned int: Text_Append_Uint32,												\
+	long: Text_Append_Long,																	\
+	unsigned long: Text_Append_Ulong,												\
+	Text_Uint: Text_Append_Uint,														\
+	Text_Int: Text_Append_Int,															\
+	Text_Hex: Text_Append_Hex,															\
+	Text_Fixed: Text_Append_Fixed,													\
+	Text_Time: Text_Append_Time)((buffer), (argument))
+
+// Expands TEXT_APPEND for up to 12 arguments
+#define TEXT_ARGS_1(b, a)							TEXT_APPEND(b, a)
+#define TEXT_ARGS_2(b, a, ...)				TEXT_APPEND(b, a); TEXT_ARGS_1(b, __VA_ARGS__)
+#define TEXT_ARGS_3(b, a, ...)				TEXT_APPEND(b, a); TEXT_ARGS_2(b, __VA_ARGS__)
+#define TEXT_ARGS_4(b, a, ...)				TEXT_APPEND(b, a); TEXT_ARGS_3(b, __VA_ARGS__)
+#define TEXT_ARGS_5(b, a, ...)				TEXT_APPEND(b, a); TEXT_ARGS_4(b, __VA_ARGS__)
+#define TEXT_ARGS_6(b, a, ...)				TEXT_APPEND(b, a); TEXT_ARGS_5(b, __VA_ARGS__)
+#define TEXT_ARGS_7(b, a, ...)				TEXT_APPEND(b, a); TEXT_ARGS_6(b, __VA_ARGS__)
+#define TEXT_ARGS_8(b, a, ...)				TEXT_APPEND(b, a); TEXT_ARGS_7(b, __VA_ARGS__)
+#define TEXT_ARGS_9(b, a, ...)				TEXT_APPEND(b, a); TEXT_ARGS_8(b, __VA_ARGS__)
+#define TEXT_ARGS_10(b, a, ...)				TEXT_APPEND(b, a); TEXT_ARGS_9(b, __VA_ARGS__)
+#define TEXT_ARGS_11(b, a, ...)				TEXT_APPEND(b, a); TEXT_ARGS_10(b, __VA_ARGS__)
+#define TEXT_ARGS_12(b, a, ...)				TEXT_APPEND(b, a); TEXT_ARGS_11(b, __VA_ARGS__)
+#define TEXT_ARGS_COUNT(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, N, ...)		TEXT_ARGS_##N
+#define TEXT_ARGS(b, ...)							TEXT_ARGS_COUNT(__VA_ARGS__, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)(b, __VA_ARGS__)
+
+/**
+ * @brief Appends every argument to the buffer, in order.
+ *
+ * @param buffer Pointer to the Text_Buffer.
+ *
+ * @param ... Between 1 and 12 arguments: strings, characters, integers, or TEXT_* descriptors.
+ */
+#define TEXT_FORMAT(buffer, ...)			do { TEXT_ARGS((buffer), __VA_ARGS__); } while (0)
+
+/**
+ * @brief Initializes a Text_Buffer with caller-provided storage.
+ *
+ * @param buffer Pointer to the Text_Buffer.
+ *
+ * @param data Pointer to the storage.
+ *
+ * @param size The size of the storage in bytes.
+ *
+ * @return None
+ */
+void Text_Buffer_Init(Text_Buffer *buffer, char *data, uint16_t size);
+
+/**
+ * @brief Clears the text in a Text_Buffer so that it can be reused.
+ *
+ * @param buffer Pointer to the Text_Buffer.
+ *
+ * @return None
+ */
+void Text_Buffer_Clear(Text_Buffer *buffer);
+
+// Append functions used by TEXT_APPEND. Each one appends a single value to the buffer.
+void Text_Append_String(Text_Buffer *buffer, const char *string);
+void Text_Append_Char(Text_Buffer *buffer, char character);
+void Text_Append_Int32(Text_Buffer *buffer, int value);
+void Text_Append_Uint32(Text_Buffer *buffer, unsigned int value);
+void Text_Append_Long(Text_Buffer *buffer, long value);
+void Text_Append_Ulong(Text_Buffer *buffer, unsigned long value);
+void Text_Append_Uint(Text_Buffer *buffer, Text_Uint argument);
+void Text_Append_Int(Text_Buffer *buffer, Text_Int argument);
+void Text_Append_Hex(Text_Buffer *buffer, Text_Hex argument);
+void Text_Append_Fixed(Text_Buffer *buffer, Text_Fixed argument);
+void Text_Append_Time(Text_Buffer *buffer, Text_Time argument);
+
+#ifdef TEXT_FORMAT_BENCHMARK
+
+typedef struct
+{
+	uint32_t text_format_cycles;		// Cycles per call of TEXT_FORMAT
+	uint32_t snprintf_cycles;			// Cycles per call of snprintf producing the same text
+	uint8_t microlib;					// 0x01 if snprintf is the one of microlib
+} Text_Format_Benchmark_Result;
+
+/**
+ * @brief Measures the cycles per call of TEXT_FORMAT and snprintf for the same stopwatch line.
+ *
+ * @param result Pointer to the structure that receives the measured cycle counts.
+ *
+ * @return None
+ */
+void Text_Format_Benchmark(Text_Format_Benchmark_Result *result);
+
+#endif
+
+#endif
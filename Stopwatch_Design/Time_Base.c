@@ -0,0 +1,262 @@
+/**
+ * @file Time_Base.c
+ *
+ * @brief Source code for the Time_Base driver.
+ *
+ * This file contains the function definitions for the Time_Base driver.
+ * It extends the 1 ms Timer 0A tick into a free-running time base with
+ * microsecond resolution by combining the number of elapsed ticks with the
+ * current value of the Timer 0A counter.
+ *
+ * The time base can be disciplined without stopping the timer. Phase corrections
+ * and frequency (rate) corrections are applied by trimming individual Timer 0A
+ * periods by 1 us, so the tick boundaries of every board stay aligned once they
+ * have been synchronized.
+ *
+ * @note Time_Base_Tick must be called once from every Timer 0A interrupt.
+ *
+ * @author Katherine Poz
+ */
+
+#include "Time_Base.h"
+
+// One rate trim step corresponds to shortening a single tick by 1 us
+// (1 us per 1000 us tick = 1,000,000 ppb of that tick)
+#define RATE_TRIM_STEP_PPB			1000000
+
+// Time base value at the most recent tick boundary in microseconds
+static volatile uint64_t time_at_tick_us = 0;
+
+// Number of ticks that have been counted
+static volatile uint32_t tick_count = 0;
+
+// Incremented whenever the time base is updated so that readers can detect a concurrent update
+static volatile uint32_t update_sequence = 0;
+
+// Length of the Timer 0A period that is currently being counted
+static volatile uint32_t active_interval_us = TIME_BASE_TICK_US;
+
+// Length of the Timer 0A period that has already been written to GPTMTAILR
+static volatile uint32_t loaded_interval_us = TIME_BASE_TICK_US;
+
+// Remaining phase correction in microseconds
+static volatile int32_t phase_remaining_us = 0;
+
+// Frequency corrections in parts per billion and their fractional accumulator
+static volatile int32_t rate_trim_ppb = 0;
+static volatile int32_t temperature_trim_ppb = 0;
+static int32_t rate_accumulator = 0;
+
+// DWT cycle counter and time base value at the start of a stall, and 0x01 while a stall is measured
+static uint32_t stall_start_cycles = 0;
+static uint64_t stall_start_us = 0;
+static uint8_t stall_active = 0x00;
+
+void Time_Base_Init(void)
+{
+	time_at_tick_us = 0;
+	tick_count = 0;
+	update_sequence = 0;
+	active_interval_us = TIME_BASE_TICK_US;
+	loaded_interval_us = TIME_BASE_TICK_US;
+	phase_remaining_us = 0;
+	rate_trim_ppb = 0;
+	temperature_trim_ppb = 0;
+	rate_accumulator = 0;
+}
+
+void Time_Base_Tick(void)
+{
+	// Every tick represents one nominal tick of the time base,
+	// regardless of how long the hardware period actually was
+	time_at_tick_us = time_at_tick_us + TIME_BASE_TICK_US;
+	tick_count = tick_count + 1;
+	update_sequence = update_sequence + 1;
+
+	// The period that was written during the previous tick is now being counted
+	active_interval_us = loaded_interval_us;
+
+	int32_t trim_us = 0;
+
+	// Apply the pending phase correction at a rate of 1 us per tick
+	if (phase_remaining_us > 0)
+	{
+		trim_us = trim_us - 1;
+		phase_remaining_us = phase_remaining_us - 1;
+	}
+	else if (phase_remaining_us < 0)
+	{
+		trim_us = trim_us + 1;
+		phase_remaining_us = phase_remaining_us + 1;
+	}
+
+	// Accumulate the rate trims and shorten or lengthen a tick
+	// whenever a full microsecond of correction has built up
+	rate_accumulator = rate_accumulator + rate_trim_ppb + temperature_trim_ppb;
+	if (rate_accumulator >= RATE_TRIM_STEP_PPB)
+	{
+		rate_accumulator = rate_accumulator - RATE_TRIM_STEP_PPB;
+		trim_us = trim_us - 1;
+	}
+	else if (rate_accumulator <= -RATE_TRIM_STEP_PPB)
+	{
+		rate_accumulator = rate_accumulator + RATE_TRIM_STEP_PPB;
+		trim_us = trim_us + 1;
+	}
+
+	// Write the length of the next period, it is loaded at the next time-out
+	loaded_interval_us = TIME_BASE_TICK_US + trim_us;
+	Timer_0A_Set_Interval(loaded_interval_us);
+}
+
+/**
+ * @brief Reads the time base in microseconds and the prescaler of the current microsecond.
+ *
+ * @param prescaler Pointer to the variable that receives the Timer 0A prescaler value (49 to 0).
+ *
+ * @return The current time in microseconds.
+ */
+static uint64_t Time_Base_Read(uint32_t *prescaler)
+{
+	uint32_t sequence;
+	uint64_t base_us;
+	uint32_t interval_us;
+	uint32_t next_interval_us;
+	uint32_t value;
+	uint8_t timeout_pending;
+
+	// The clock of Timer 0 is gated until Timer 0A is started, so an interrupt
+	// that reads the time base during initialization must not access the timer
+	if (Timer_0A_Is_Running() == 0x00)
+	{
+		*prescaler = TIME_BASE_CYCLES_PER_US - 1;
+		return 0;
+	}
+
+	// Repeat the read if a tick was processed in the meantime
+	do
+	{
+		sequence = update_sequence;
+		base_us = time_at_tick_us;
+		interval_us = active_interval_us;
+		next_interval_us = loaded_interval_us;
+		value = Timer_0A_Get_Value();
+		timeout_pending = Timer_0A_Timeout_Pending();
+	}
+	while (sequence != update_sequence);
+
+	// Split the counter (Bits 15 to 0) and the prescaler (Bits 23 to 16)
+	uint32_t counter = value & 0x0000FFFF;
+	*prescaler = (value >> 16) & 0x000000FF;
+
+	// The counter runs down from (interval - 1) to zero
+	uint32_t elapsed_us = (interval_us - 1) - counter;
+
+	// A time-out that has not been handled yet means that the counter has already
+	// been reloaded with the next period, so a full tick has to be added
+	if (timeout_pending && (counter > (interval_us / 2)))
+	{
+		base_us = base_us + TIME_BASE_TICK_US;
+		elapsed_us = (next_interval_us - 1) - counter;
+	}
+
+	// A trimmed period may be slightly longer than a nominal tick
+	if (elapsed_us >= TIME_BASE_TICK_US)
+	{
+		elapsed_us = TIME_BASE_TICK_US - 1;
+	}
+
+	return base_us + elapsed_us;
+}
+
+uint64_t Time_Base_Get_Time_us(void)
+{
+	uint32_t prescaler;
+
+	return Time_Base_Read(&prescaler);
+}
+
+uint64_t Time_Base_Get_Event_Time_us(uint32_t latency_cycles)
+{
+	uint32_t prescaler;
+	uint64_t time_us = Time_Base_Read(&prescaler);
+
+	// The prescaler counts down within the current microsecond
+	uint64_t cycles = (time_us * TIME_BASE_CYCLES_PER_US) + ((TIME_BASE_CYCLES_PER_US - 1) - prescaler);
+
+	if (latency_cycles < cycles)
+	{
+		cycles = cycles - latency_cycles;
+	}
+
+	// Round to the nearest microsecond
+	return (cycles + (TIME_BASE_CYCLES_PER_US / 2)) / TIME_BASE_CYCLES_PER_US;
+}
+
+uint32_t Time_Base_Get_Ticks(void)
+{
+	return tick_count;
+}
+
+void Time_Base_Step_Ticks(int32_t ticks)
+{
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	time_at_tick_us = time_at_tick_us + ((int64_t)ticks * TIME_BASE_TICK_US);
+	update_sequence = update_sequence + 1;
+
+	__set_PRIMASK(primask);
+}
+
+void Time_Base_Begin_Stall(void)
+{
+	stall_active = Timer_0A_Is_Running();
+	stall_start_cycles = DWT->CYCCNT;
+	stall_start_us = Time_Base_Get_Time_us();
+}
+
+uint32_t Time_Base_End_Stall(void)
+{
+	if (stall_active == 0x00)
+	{
+		return 0;
+	}
+
+	stall_active = 0x00;
+
+	uint32_t stall_us = (DWT->CYCCNT - stall_start_cycles) / TIME_BASE_CYCLES_PER_US;
+	uint32_t counted_us = (uint32_t)(Time_Base_Get_Time_us() - stall_start_us);
+
+	if (stall_us <= counted_us)
+	{
+		return 0;
+	}
+
+	// Only whole ticks are lost, so the small difference of the trimmed periods is rounded away
+	uint32_t lost_ticks = ((stall_us - counted_us) + (TIME_BASE_TICK_US / 2)) / TIME_BASE_TICK_US;
+
+	Time_Base_Step_Ticks((int32_t)lost_ticks);
+
+	return lost_ticks;
+}
+
+void Time_Base_Adjust_Phase(int32_t offset_us)
+{
+	phase_remaining_us = offset_us;
+}
+
+void Time_Base_Set_Rate_Trim(int32_t trim_ppb)
+{
+	rate_trim_ppb = trim_ppb;
+}
+
+int32_t Time_Base_Get_Rate_Trim(void)
+{
+	return rate_trim_ppb;
+}
+
+void Time_Base_Set_Temperature_Trim(int32_t trim_ppb)
+{
+	temperature_trim_ppb = trim_ppb;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file Time_Base.h
+ *
+ * @brief Header file for the Time_Base driver.
+ *
+ * This file contains the function definitions for the Time_Base driver.
+ * It extends the 1 ms Timer 0A tick into a free-running time base with
+ * microsecond resolution by combining the number of elapsed ticks with the
+ * current value of the Timer 0A counter.
+ *
+ * The time base can be disciplined without stopping the timer. Phase corrections
+ * and frequency (rate) corrections are applied by trimming individual Timer 0A
+ * periods by 1 us, so the tick boundaries of every board stay aligned once they
+ * have been synchronized.
+ *
+ * @note Time_Base_Tick must be called once from every Timer 0A interrupt.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef TIME_BASE_H
+#define TIME_BASE_H
+
+#include "TM4C123GH6PM.h"
+#include "Timer_0A_Interrupt.h"
+
+// Nominal length of one Timer 0A tick in microseconds
+#define TIME_BASE_TICK_US				1000
+
+// Number of system clock cycles per microsecond of the time base (Timer 0A prescaler)
+#define TIME_BASE_CYCLES_PER_US		50
+
+/**
+ * @brief Initializes the state of the time base.
+ *
+ * This function clears the time base and the pending corrections.
+ * It must be called before Timer 0A starts generating interrupts.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Time_Base_Init(void);
+
+/**
+ * @brief Advances the time base by one tick.
+ *
+ * This function adds one nominal tick to the time base and selects the length of a following
+ * Timer 0A period based on the pending phase correction and the rate trim.
+ *
+ * @note Must be called from the Timer 0A interrupt.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Time_Base_Tick(void);
+
+/**
+ * @brief Returns the current value of the time base in microseconds.
+ *
+ * This function can be called from thread mode or from any interrupt.
+ * It returns a consistent value even if a Timer 0A time-out occurs during the read.
+ * It returns 0 until Timer 0A has been started.
+ *
+ * @param None
+ *
+ * @return The current time in microseconds.
+ */
+uint64_t Time_Base_Get_Time_us(void);
+
+/**
+ * @brief Returns the time base value of an event that happened shortly before the call.
+ *
+ * The position within the current tick is read from the Timer 0A counter and prescaler with
+ * a resolution of one system clock cycle, and the latency between the event and the read is
+ * subtracted before the result is rounded to microseconds. This is meant to be called at the
+ * start of an interrupt handler, with the interrupt entry latency as the correction.
+ *
+ * @param latency_cycles The number of system clock cycles between the event and the call.
+ *
+ * @return The time of the event in microseconds.
+ */
+uint64_t Time_Base_Get_Event_Time_us(uint32_t latency_cycles);
+
+/**
+ * @brief Returns the number of Timer 0A ticks counted by the time base.
+ *
+ * @param None
+ *
+ * @return The number of ticks since Time_Base_Init was called.
+ */
+uint32_t Time_Base_Get_Ticks(void);
+
+/**
+ * @brief Steps the time base by a whole number of ticks.
+ *
+ * The time base jumps immediately, which keeps the tick boundaries on multiples of
+ * TIME_BASE_TICK_US. It is used for large corrections before the time base is in sync.
+ *
+ * @param ticks The number of ticks to add to the time base (negative values step backward).
+ *
+ * @return None
+ */
+void Time_Base_Step_Ticks(int32_t ticks);
+
+/**
+ * @brief Starts measuring a stall of the processor with the DWT cycle counter.
+ *
+ * While the flash memory is erased, instructions cannot be fetched for several milliseconds,
+ * and Timer 0A can only keep one of the time-outs of that time pending.
+ *
+ * @note Must be called with interrupts disabled, followed by Time_Base_End_Stall.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Time_Base_Begin_Stall(void);
+
+/**
+ * @brief Steps the time base by the ticks that were lost since Time_Base_Begin_Stall.
+ *
+ * The duration of the stall measured by the DWT cycle counter is compared with the progress
+ * of the time base, and the difference is rounded to whole ticks. It does nothing if Timer 0A
+ * was not running when the stall began.
+ *
+ * @note Must be called with interrupts still disabled.
+ *
+ * @param None
+ *
+ * @return The number of ticks that were added to the time base.
+ */
+uint32_t Time_Base_End_Stall(void);
+
+/**
+ * @brief Requests a gradual phase correction of the time base.
+ *
+ * The correction is applied by shortening (positive offset) or lengthening (negative offset)
+ * the following Timer 0A periods by 1 us each until the full offset has been applied.
+ *
+ * @param offset_us The amount of time in microseconds that the time base should be advanced.
+ *
+ * @return None
+ */
+void Time_Base_Adjust_Phase(int32_t offset_us);
+
+/**
+ * @brief Sets the frequency correction of the time base.
+ *
+ * @param trim_ppb The rate correction in parts per billion. Positive values make the time base run faster.
+ *
+ * @return None
+ */
+void Time_Base_Set_Rate_Trim(int32_t trim_ppb);
+
+/**
+ * @brief Returns the frequency correction of the time base.
+ *
+ * @param None
+ *
+ * @return The rate correction in parts per billion.
+ */
+int32_t Time_Base_Get_Rate_Trim(void);
+
+/**
+ * @brief Sets the temperature correction of the time base.
+ *
+ * The temperature correction is applied in addition to the rate trim, so the rate trim
+ * only has to correct the drift that remains after temperature compensation.
+ *
+ * @param trim_ppb The temperature correction in parts per billion. Positive values make the time base run faster.
+ *
+ * @return None
+ */
+void Time_Base_Set_Temperature_Trim(int32_t trim_ppb);
+
+#endif
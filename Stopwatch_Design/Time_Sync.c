@@ -0,0 +1,438 @@
+/**
+ * @file Time_Sync.c
+ *
+ * @brief Source code for the Time_Sync driver.
+ *
+ * This file contains the function definitions for the Time_Sync driver.
+ * It keeps the time bases of several boards in agreement using a PTP-style
+ * two-way timestamp exchange over the UART5 link.
+ *
+ * Every message is a frame of TIME_SYNC_FRAME_LENGTH bytes:
+ *	- Byte 0:		Start of frame (0xA5)
+ *	- Byte 1:		Message type
+ *	- Byte 2:		Sender board ID
+ *	- Byte 3:		Target board ID
+ *	- Bytes 4-11:	Timestamp in microseconds (little-endian)
+ *	- Byte 12:	Checksum (sum of bytes 1 to 11)
+ *
+ * The timestamp of a received frame is the time base value captured when its first byte arrived.
+ * The TIME and SET_TIME messages carry RTC seconds in the timestamp field instead of a time base value.
+ *
+ * @author Katherine Poz
+ */
+
+#include "Time_Sync.h"
+
+// Frame layout
+#define TIME_SYNC_FRAME_START				0xA5
+#define TIME_SYNC_FRAME_LENGTH			13
+
+// Message types
+#define TIME_SYNC_MSG_SYNC					0x01
+#define TIME_SYNC_MSG_FOLLOW_UP			0x02
+#define TIME_SYNC_MSG_DELAY_REQ			0x03
+#define TIME_SYNC_MSG_DELAY_RESP		0x04
+#define TIME_SYNC_MSG_START					0x05
+#define TIME_SYNC_MSG_TIME					0x06
+#define TIME_SYNC_MSG_SET_TIME			0x07
+
+// Declare pointer to the user-defined task
+static void (*Time_Sync_Start_Task)(void);
+
+// ID of this board
+static uint8_t sync_board_id = TIME_SYNC_MASTER_ID;
+
+// Receive state of the frame parser
+static uint8_t rx_frame[TIME_SYNC_FRAME_LENGTH];
+static uint8_t rx_index = 0;
+static uint64_t rx_frame_timestamp_us = 0;
+
+// Master state: interval counter and the slave that is polled next
+static uint32_t sync_interval_count = 0;
+static uint8_t poll_id = 1;
+
+// Slave state: timestamps of the current exchange
+static uint64_t t1_us = 0;
+static uint64_t t2_us = 0;
+static uint64_t t3_us = 0;
+static uint8_t sync_polled = 0x00;
+static uint8_t t3_valid = 0x00;
+
+// Slave state: receive timestamp of the previous exchange, used for the drift estimate
+static uint64_t previous_t2_us = 0;
+static uint8_t previous_valid = 0x00;
+
+// Scheduled synchronized start
+static volatile uint64_t start_time_us = 0;
+static volatile uint8_t start_pending = 0x00;
+
+// Master state: 0x01 while the START message has not been accepted by the UART5 driver
+static volatile uint8_t start_broadcast_pending = 0x00;
+
+// Status of the time synchronization
+static Time_Sync_Status sync_status;
+
+static uint8_t Time_Sync_Send(uint8_t type, uint8_t target_id, uint64_t timestamp_us, uint64_t *tx_timestamp_us);
+static void Time_Sync_Process_Frame(void);
+static void Time_Sync_Update(uint64_t t4_us);
+static void Time_Sync_RX_Task(uint8_t data, uint64_t timestamp_us);
+
+void Time_Sync_Init(uint8_t board_id, void(*start_task)(void))
+{
+	// Store the user-defined task function for use during the synchronized start
+	Time_Sync_Start_Task = start_task;
+
+	sync_board_id = board_id;
+	rx_index = 0;
+	sync_interval_count = 0;
+	poll_id = 1;
+	sync_polled = 0x00;
+	t3_valid = 0x00;
+	previous_valid = 0x00;
+	start_pending = 0x00;
+	start_broadcast_pending = 0x00;
+
+	sync_status.offset_us = 0;
+	sync_status.path_delay_us = 0;
+	sync_status.rate_trim_ppb = 0;
+	sync_status.exchanges = 0;
+	sync_status.locked = (board_id == TIME_SYNC_MASTER_ID) ? 0x01 : 0x00;
+
+	// Initialize the UART5 link and pass every received byte to the frame parser
+	UART5_Init(&Time_Sync_RX_Task);
+}
+
+void Time_Sync_Tick(void)
+{
+	// The master sends a SYNC message followed by a FOLLOW_UP message every interval
+	if (sync_board_id == TIME_SYNC_MASTER_ID)
+	{
+		sync_interval_count = sync_interval_count + 1;
+
+		// Retry the START message until the UART5 driver accepts it. It is sent before
+		// the SYNC message, which would otherwise fill the transmit buffer again.
+		// The retry stops once the start has fired, since the slaves could no longer start on time.
+		if (start_broadcast_pending == 0x01)
+		{
+			if ((start_pending == 0x00) || (Time_Sync_Send(TIME_SYNC_MSG_START, TIME_SYNC_MAX_BOARDS, start_time_us, 0) == 0x01))
+			{
+				start_broadcast_pending = 0x00;
+			}
+		}
+
+		// The SYNC message is only sent when the link is idle so that t1 is exact
+		// Otherwise, it is retried on the next tick
+		if (sync_interval_count >= TIME_SYNC_INTERVAL_MS)
+		{
+			if (Time_Sync_Send(TIME_SYNC_MSG_SYNC, poll_id, 0, &t1_us) == 0x01)
+			{
+				sync_interval_count = 0;
+				Time_Sync_Send(TIME_SYNC_MSG_FOLLOW_UP, poll_id, t1_us, 0);
+
+				// Distribute the time of day of the master's RTC to all slaves
+				Time_Sync_Send(TIME_SYNC_MSG_TIME, TIME_SYNC_MAX_BOARDS, Hibernation_RTC_Get().seconds, 0);
+
+				// Poll the next slave during the next interval
+				poll_id = poll_id + 1;
+				if (poll_id >= TIME_SYNC_MAX_BOARDS)
+				{
+					poll_id = 1;
+				}
+			}
+		}
+	}
+
+	// Fire the synchronized start on the tick that reaches the scheduled timestamp
+	if ((start_pending == 0x01) && (Time_Base_Get_Time_us() >= start_time_us))
+	{
+		start_pending = 0x00;
+		(*Time_Sync_Start_Task)();
+	}
+}
+
+uint8_t Time_Sync_Schedule_Start(void)
+{
+	if (sync_board_id != TIME_SYNC_MASTER_ID)
+	{
+		return 0x00;
+	}
+
+	// Round the start time up to a tick boundary so that every board fires on the same tick
+	uint64_t start_us = Time_Base_Get_Time_us() + TIME_SYNC_START_LEAD_US;
+	start_us = ((start_us + TIME_BASE_TICK_US - 1) / TIME_BASE_TICK_US) * TIME_BASE_TICK_US;
+
+	// Schedule the start locally. The start time and its flag are written together,
+	// since Time_Sync_Tick can interrupt this function.
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	start_time_us = start_us;
+	start_pending = 0x01;
+
+	// Broadcast the start time to all slaves, or retry it from Time_Sync_Tick if the transmit buffer is full
+	start_broadcast_pending = (Time_Sync_Send(TIME_SYNC_MSG_START, TIME_SYNC_MAX_BOARDS, start_us, 0) == 0x01) ? 0x00 : 0x01;
+
+	__set_PRIMASK(primask);
+
+	return 0x01;
+}
+
+void Time_Sync_Get_Status(Time_Sync_Status *status)
+{
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	*status = sync_status;
+
+	__set_PRIMASK(primask);
+}
+
+/**
+ * @brief Builds a frame and queues it on the UART5 link.
+ *
+ * @param type The message type.
+ *
+ * @param target_id The board ID of the receiver (TIME_SYNC_MAX_BOARDS for all boards).
+ *
+ * @param timestamp_us The timestamp carried by the frame.
+ *
+ * @param tx_timestamp_us Pointer to store the transmit timestamp of the frame, or NULL.
+ *
+ * @return 0x01 if the frame was accepted by the UART5 driver, otherwise 0x00.
+ */
+static uint8_t Time_Sync_Send(uint8_t type, uint8_t target_id, uint64_t timestamp_us, uint64_t *tx_timestamp_us)
+{
+	uint8_t frame[TIME_SYNC_FRAME_LENGTH];
+	uint8_t checksum = 0;
+
+	frame[0] = TIME_SYNC_FRAME_START;
+	frame[1] = type;
+	frame[2] = sync_board_id;
+	frame[3] = target_id;
+
+	for (uint8_t i = 0; i < 8; i++)
+	{
+		frame[4 + i] = (uint8_t)(timestamp_us >> (8 * i));
+	}
+
+	for (uint8_t i = 1; i < (TIME_SYNC_FRAME_LENGTH - 1); i++)
+	{
+		checksum = checksum + frame[i];
+	}
+	frame[TIME_SYNC_FRAME_LENGTH - 1] = checksum;
+
+	return UART5_Send_Frame(frame, TIME_SYNC_FRAME_LENGTH, tx_timestamp_us);
+}
+
+/**
+ * @brief Collects received bytes into frames.
+ *
+ * @param data The received byte.
+ *
+ * @param timestamp_us The time base value captured when the byte arrived.
+ *
+ * @return None
+ */
+static void Time_Sync_RX_Task(uint8_t data, uint64_t timestamp_us)
+{
+	// Wait for the start of a frame and remember when it arrived
+	if (rx_index == 0)
+	{
+		if (data != TIME_SYNC_FRAME_START)
+		{
+			return;
+		}
+		rx_frame_timestamp_us = timestamp_us;
+	}
+
+	rx_frame[rx_index] = data;
+	rx_index = rx_index + 1;
+
+	if (rx_index == TIME_SYNC_FRAME_LENGTH)
+	{
+		rx_index = 0;
+		Time_Sync_Process_Frame();
+	}
+}
+
+/**
+ * @brief Handles a complete frame received on the UART5 link.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Time_Sync_Process_Frame(void)
+{
+	uint8_t checksum = 0;
+	uint64_t timestamp_us = 0;
+
+	for (uint8_t i = 1; i < (TIME_SYNC_FRAME_LENGTH - 1); i++)
+	{
+		checksum = checksum + rx_frame[i];
+	}
+
+	// Drop corrupted frames
+	if (checksum != rx_frame[TIME_SYNC_FRAME_LENGTH - 1])
+	{
+		return;
+	}
+
+	for (uint8_t i = 0; i < 8; i++)
+	{
+		timestamp_us = timestamp_us | ((uint64_t)rx_frame[4 + i] << (8 * i));
+	}
+
+	uint8_t type = rx_frame[1];
+	uint8_t sender_id = rx_frame[2];
+	uint8_t target_id = rx_frame[3];
+
+	if (sync_board_id == TIME_SYNC_MASTER_ID)
+	{
+		// The master answers a DELAY_REQ message with its receive timestamp (t4)
+		if (type == TIME_SYNC_MSG_DELAY_REQ)
+		{
+			Time_Sync_Send(TIME_SYNC_MSG_DELAY_RESP, sender_id, rx_frame_timestamp_us, 0);
+		}
+
+		// A host sets the time of day of the master's RTC, which is then distributed with the next SYNC message
+		else if ((type == TIME_SYNC_MSG_SET_TIME) && (target_id == sync_board_id))
+		{
+			Hibernation_RTC_Set((uint32_t)timestamp_us);
+		}
+		return;
+	}
+
+	switch (type)
+	{
+		case TIME_SYNC_MSG_SYNC:
+		{
+			// Record the receive timestamp of the SYNC message (t2)
+			t2_us = rx_frame_timestamp_us;
+			sync_polled = (target_id == sync_board_id) ? 0x01 : 0x00;
+			t3_valid = 0x00;
+			break;
+		}
+
+		case TIME_SYNC_MSG_FOLLOW_UP:
+		{
+			// Record the transmit timestamp of the SYNC message (t1)
+			t1_us = timestamp_us;
+
+			// The polled slave sends a DELAY_REQ message and records its transmit timestamp (t3)
+			if (sync_polled == 0x01)
+			{
+				sync_polled = 0x00;
+				t3_valid = Time_Sync_Send(TIME_SYNC_MSG_DELAY_REQ, TIME_SYNC_MASTER_ID, 0, &t3_us);
+			}
+			break;
+		}
+
+		case TIME_SYNC_MSG_DELAY_RESP:
+		{
+			// Complete the exchange with the master's receive timestamp (t4)
+			if ((target_id == sync_board_id) && (t3_valid == 0x01))
+			{
+				t3_valid = 0x00;
+				Time_Sync_Update(timestamp_us);
+			}
+			break;
+		}
+
+		case TIME_SYNC_MSG_TIME:
+		{
+			// Load the master's time of day into the RTC. Small differences are kept,
+			// since loading the RTC clears its sub-seconds counter.
+			int32_t difference_s = (int32_t)((uint32_t)timestamp_us - Hibernation_RTC_Get().seconds);
+			if ((difference_s > TIME_SYNC_RTC_TOLERANCE_S) || (difference_s < -TIME_SYNC_RTC_TOLERANCE_S))
+			{
+				Hibernation_RTC_Set((uint32_t)timestamp_us);
+			}
+			break;
+		}
+
+		case TIME_SYNC_MSG_START:
+		{
+			// Schedule the synchronized start at the master's timestamp
+			// The UART5 interrupt can be interrupted by Time_Sync_Tick
+			uint32_t primask = __get_PRIMASK();
+			__disable_irq();
+
+			start_time_us = timestamp_us;
+			start_pending = 0x01;
+
+			__set_PRIMASK(primask);
+			break;
+		}
+
+		default:
+		{
+			break;
+		}
+	}
+}
+
+/**
+ * @brief Estimates the offset and drift of this board and disciplines its time base.
+ *
+ * @param t4_us The master's receive timestamp of the DELAY_REQ message.
+ *
+ * @return None
+ */
+static void Time_Sync_Update(uint64_t t4_us)
+{
+	int64_t master_to_slave_us = (int64_t)(t2_us - t1_us);
+	int64_t slave_to_master_us = (int64_t)(t4_us - t3_us);
+	int64_t offset_us = (master_to_slave_us - slave_to_master_us) / 2;
+	int64_t magnitude_us = (offset_us < 0) ? -offset_us : offset_us;
+	int32_t trim_ppb = Time_Base_Get_Rate_Trim();
+
+	if ((previous_valid == 0x00) || (magnitude_us > TIME_SYNC_STEP_THRESHOLD_US))
+	{
+		// Step the time base by whole ticks so that its tick boundaries stay on
+		// multiples of TIME_BASE_TICK_US, then slew the remaining fraction of a tick
+		int32_t step_ticks = (int32_t)((magnitude_us + (TIME_BASE_TICK_US / 2)) / TIME_BASE_TICK_US);
+		if (offset_us > 0)
+		{
+			step_ticks = -step_ticks;
+		}
+		Time_Base_Step_Ticks(step_ticks);
+		Time_Base_Adjust_Phase(-(int32_t)(offset_us + ((int64_t)step_ticks * TIME_BASE_TICK_US)));
+
+		// Restart the drift estimate if the time base has jumped
+		previous_valid = (step_ticks == 0) ? 0x01 : 0x00;
+	}
+	else
+	{
+		// The previous offset has been slewed out completely within the interval,
+		// so the offset measured now is the drift accumulated since the previous exchange
+		int64_t interval_us = (int64_t)(t2_us - previous_t2_us);
+		if (interval_us > 0)
+		{
+			int64_t drift_ppb = (offset_us * 1000000000LL) / interval_us;
+
+			// Apply half of the estimate to filter the 1 us timestamp quantization
+			trim_ppb = trim_ppb - (int32_t)(drift_ppb / 2);
+			if (trim_ppb > TIME_SYNC_MAX_TRIM_PPB)
+			{
+				trim_ppb = TIME_SYNC_MAX_TRIM_PPB;
+			}
+			else if (trim_ppb < -TIME_SYNC_MAX_TRIM_PPB)
+			{
+				trim_ppb = -TIME_SYNC_MAX_TRIM_PPB;
+			}
+			Time_Base_Set_Rate_Trim(trim_ppb);
+		}
+
+		// Slew out the measured offset
+		Time_Base_Adjust_Phase(-(int32_t)offset_us);
+	}
+
+	previous_t2_us = t2_us;
+
+	sync_status.offset_us = (int32_t)offset_us;
+	sync_status.path_delay_us = (int32_t)((master_to_slave_us + slave_to_master_us) / 2);
+	sync_status.rate_trim_ppb = trim_ppb;
+	sync_status.exchanges = sync_status.exchanges + 1;
+	sync_status.locked = (magnitude_us <= TIME_SYNC_LOCK_THRESHOLD_US) ? 0x01 : 0x00;
+}
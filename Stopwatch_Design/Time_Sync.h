@@ -0,0 +1,129 @@
+/**
+ * @file Time_Sync.h
+ *
+ * @brief Header file for the Time_Sync driver.
+ *
+ * This file contains the function definitions for the Time_Sync driver.
+ * It keeps the time bases of several boards in agreement using a PTP-style
+ * two-way timestamp exchange over the UART5 link.
+ *
+ * Board 0 is the master. Every TIME_SYNC_INTERVAL_MS it broadcasts a SYNC message and a
+ * FOLLOW_UP message that carries the transmit timestamp of the SYNC message (t1). The SYNC
+ * message polls one slave, which records the receive timestamp (t2), answers with a DELAY_REQ
+ * message sent at t3 and receives the master's receive timestamp (t4) in a DELAY_RESP message.
+ *
+ *	offset = ((t2 - t1) - (t4 - t3)) / 2
+ *	path delay = ((t2 - t1) + (t4 - t3)) / 2
+ *
+ * Each slave disciplines its own time base: large offsets are stepped in whole ticks,
+ * small offsets are slewed, and the offset accumulated between exchanges is used to
+ * estimate the frequency drift, which is applied as a rate trim.
+ *
+ * The master can schedule a synchronized start at a common future timestamp. Every board
+ * fires the start task on the same tick boundary of its disciplined time base.
+ *
+ * The master also distributes the time of day of its Hibernation RTC, so the lap logs of all
+ * boards carry the same time. After every FOLLOW_UP message it broadcasts a TIME message with
+ * its RTC seconds, and a slave loads its RTC when it differs by more than TIME_SYNC_RTC_TOLERANCE_S.
+ * The master's RTC is set by a host with a SET_TIME frame (message type 0x07) addressed to board
+ * TIME_SYNC_MASTER_ID, which carries the new RTC seconds in its timestamp field. The host can be
+ * connected to the U5Rx pin of the master through the same wired-AND as the slaves.
+ *
+ * Wiring: the master's U5Tx drives the U5Rx pin of every slave. The U5Tx pins of the slaves
+ * are combined with diodes (wired-AND) into the master's U5Rx pin. Only the polled slave transmits.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef TIME_SYNC_H
+#define TIME_SYNC_H
+
+#include "TM4C123GH6PM.h"
+#include "Time_Base.h"
+#include "UART5.h"
+#include "Hibernation_RTC.h"
+
+// Board ID of the master
+#define TIME_SYNC_MASTER_ID					0
+
+// Maximum number of boards on the link (including the master)
+#define TIME_SYNC_MAX_BOARDS				4
+
+// Interval between SYNC messages in milliseconds
+#define TIME_SYNC_INTERVAL_MS				1000
+
+// Offsets above this threshold are stepped instead of slewed
+#define TIME_SYNC_STEP_THRESHOLD_US	1000
+
+// A slave is considered locked when its offset is below this threshold
+#define TIME_SYNC_LOCK_THRESHOLD_US	5
+
+// Limit of the rate trim that is applied to the time base (100 ppm)
+#define TIME_SYNC_MAX_TRIM_PPB			100000
+
+// Time between scheduling a synchronized start and the start itself
+#define TIME_SYNC_START_LEAD_US			100000
+
+// A slave loads the master's RTC seconds when its own RTC differs by more than this
+#define TIME_SYNC_RTC_TOLERANCE_S		1
+
+typedef struct
+{
+	int32_t offset_us;			// Offset of the last exchange (slave - master)
+	int32_t path_delay_us;		// Mean path delay of the last exchange
+	int32_t rate_trim_ppb;		// Rate trim currently applied to the time base
+	uint32_t exchanges;			// Number of completed two-way exchanges
+	uint8_t locked;				// 0x01 if the last offset was below TIME_SYNC_LOCK_THRESHOLD_US
+} Time_Sync_Status;
+
+/**
+ * @brief Initializes the time synchronization on the UART5 link.
+ *
+ * Hibernation_RTC_Init must be called first.
+ *
+ * @param board_id The ID of this board. Board TIME_SYNC_MASTER_ID is the master.
+ *
+ * @param start_task A pointer to the user-defined function to be executed when a synchronized start fires.
+ *                   It is executed from the Timer 0A interrupt.
+ *
+ * @return None
+ */
+void Time_Sync_Init(uint8_t board_id, void(*start_task)(void));
+
+/**
+ * @brief Performs the periodic work of the time synchronization.
+ *
+ * On the master, it sends the SYNC and FOLLOW_UP messages. On every board,
+ * it fires the synchronized start once the time base reaches the scheduled timestamp.
+ *
+ * @note Must be called from the Timer 0A interrupt after Time_Base_Tick.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Time_Sync_Tick(void);
+
+/**
+ * @brief Schedules a synchronized start on all boards.
+ *
+ * The start timestamp is TIME_SYNC_START_LEAD_US in the future, rounded up to a tick boundary.
+ * It is scheduled locally and broadcast to all slaves. If the transmit buffer of the UART5 link
+ * is full, the broadcast is retried from Time_Sync_Tick. Only the master can schedule a start.
+ *
+ * @param None
+ *
+ * @return 0x01 if the start was scheduled, otherwise 0x00.
+ */
+uint8_t Time_Sync_Schedule_Start(void);
+
+/**
+ * @brief Returns the status of the time synchronization.
+ *
+ * @param status Pointer to the structure that receives the status.
+ *
+ * @return None
+ */
+void Time_Sync_Get_Status(Time_Sync_Status *status);
+
+#endif
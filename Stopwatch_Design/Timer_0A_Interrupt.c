@@ -5,6 +5,7 @@
  *
  * This file contains the function definitions for the Timer_0A_Interrupt driver.
  * It uses the Timer 0A module to generate periodic interrupts.
+ * The timer is configured through the GPTM driver, which also provides the Timer 0A interrupt handler.
  *
  * @note Timer 0A has been configured to generate periodic interrupts every 1 ms
  * for the Timers lab.
@@ -21,74 +22,160 @@
 #include "Timer_0A_Interrupt.h"
 
 // Declare pointer to the user-defined task
-void (*Timer_0A_Task)(void);
+static void (*Timer_0A_Task)(void);
 
-void Timer_0A_Interrupt_Init(void(*task)(void))
+// Set once Timer 0A has been configured and enabled
+static volatile uint8_t timer_0a_running = 0x00;
+
+// Latency statistics of the Timer 0A interrupt
+static Timer_0A_Jitter_Stats jitter_stats;
+
+// Cycle counter value and interval at the previous interrupt, used to detect missed ticks
+static uint32_t last_entry_cycle = 0;
+static uint32_t last_interval = 0;
+
+/**
+ * @brief Measures the latency of the Timer 0A interrupt and executes the user-defined task.
+ *
+ * This function is executed from the Timer 0A interrupt.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Timer_0A_Measured_Task(void)
 {
-	// Store the user-defined task function for use during interrupt handling
-	Timer_0A_Task = task;
+	// Sample the timer and the cycle counter before anything else
+	uint32_t value = Timer_0A_Get_Value();
+	uint32_t entry_cycle = DWT->CYCCNT;
 	
-	// Set the R0 bit (Bit 0) in the RCGCTIMER register
-	// to enable the clock for Timer 0A
-	SYSCTL->RCGCTIMER |=  0x01;
+	// The interval register still holds the length of the period that started at the time-out,
+	// the time base writes the next one from the task
+	uint32_t interval = GPTM_Get_Interval(GPTM_TIMER0, GPTM_TIMER_A);
 	
-	// Clear the TAEN bit (Bit 0) of the GPTMCTL register
-	// to disable Timer 0A
-	TIMER0->CTL &= ~0x01;
+	// The counter (Bits 15 to 0) counts down from (interval - 1) and the prescaler (Bits 23 to 16)
+	// counts down from 49 within every microsecond
+	uint32_t counter = value & 0x0000FFFF;
+	uint32_t prescaler = (value >> 16) & 0x000000FF;
+	uint32_t latency_cycles = ((interval - 1 - counter) * TIMER_0A_CYCLES_PER_US) + ((TIMER_0A_CYCLES_PER_US - 1) - prescaler);
 	
-	// Set the bits of the GPTMCFG field (Bits 2 to 0) in the GPTMCFG register
-	// 0x4 = Select the 16-bit timer configuration
-	TIMER0->CFG |= 0x04;
+	// Select the bin from the position of the most significant bit
+	uint32_t bin = 32 - __CLZ(latency_cycles >> 4);
+	if (bin >= TIMER_0A_JITTER_BINS)
+	{
+		bin = TIMER_0A_JITTER_BINS - 1;
+	}
+	jitter_stats.histogram[bin]++;
 	
-	// Set the bits of the TAMR field (Bits 1 to 0) in the GPTMTAMR register
-	// 0x2 = Periodic Timer Mode
-	TIMER0->TAMR |= 0x02;
+	if (latency_cycles < jitter_stats.min_latency_cycles)
+	{
+		jitter_stats.min_latency_cycles = latency_cycles;
+	}
 	
-	// Clear the bits of the TAPSR field (Bits 7 to 0) in the
-	// GPTMTAPR register before setting the prescale value
-	TIMER0->TAPR &= ~0x000000FF;
+	if (latency_cycles > jitter_stats.max_latency_cycles)
+	{
+		jitter_stats.max_latency_cycles = latency_cycles;
+	}
 	
-	// Set the prescale value to 50 by setting the bits of the
-	// TAPSR field (Bits 7 to 0) in the GPTMTAPR register
-	// New timer clock frequency = (50 MHz / 50) = 1 MHz
-	TIMER0->TAPR |= 50;
+	// A gap of two or more periods since the previous interrupt means that time-outs were lost
+	// while the interrupt was blocked, since the time-out flag only holds a single time-out
+	if (last_interval != 0)
+	{
+		uint32_t period_cycles = last_interval * TIMER_0A_CYCLES_PER_US;
+		uint32_t periods = ((entry_cycle - last_entry_cycle) + (period_cycles / 2)) / period_cycles;
+		
+		if (periods > 1)
+		{
+			jitter_stats.missed_ticks += periods - 1;
+		}
+	}
+	last_entry_cycle = entry_cycle;
+	last_interval = interval;
 	
-	// Set the timer interval load value by writing to the
-	// TAILR field (Bits 31 to 0) in the GPTMTAILR register
-	// (1 us * 1000) = 1 ms
-	// Timer 0A Resolution: 1 ms
-	TIMER0->TAILR = (1000 - 1);
+	(*Timer_0A_Task)();
 	
-	// Set the TATOCINT bit (Bit 0) to 1 in the GPTMICR register
-	// The TATOCINT bit will be automatically cleared when it is set to 1
-	TIMER0->ICR |= 0x01;
+	// The next time-out has already occurred if the task took longer than the rest of the period
+	if (Timer_0A_Timeout_Pending())
+	{
+		jitter_stats.overruns++;
+	}
+}
+
+void Timer_0A_Interrupt_Init(void(*task)(void))
+{
+	// Store the user-defined task function for use during interrupt handling
+	Timer_0A_Task = task;
+	Timer_0A_Reset_Jitter_Stats();
+	last_interval = 0;
 	
-	// Enable the Timer 0A interrupt by setting the TATOIM bit (Bit 0)
-	// in the GPTMIMR register
-	TIMER0->IMR |= 0x01;
+	// Configure Timer 0A as a 16-bit periodic timer with the user-defined task
+	// The prescaler divides the 50 MHz system clock by 50 (TIMER_0A_CYCLES_PER_US)
+	// New timer clock frequency = (50 MHz / 50) = 1 MHz
+	// Interval: (1 us * 1000) = 1 ms
+	// A new interval is only loaded at the next time-out. This allows the time base
+	// to trim individual periods without disturbing the period that is currently being counted
+	// The priority level of the Timer 0A interrupt (IRQ 19) is set to 1
+	GPTM_Init_Split_Periodic(GPTM_TIMER0, GPTM_TIMER_A, TIMER_0A_CYCLES_PER_US, 1000, &Timer_0A_Measured_Task, 1);
 	
-	// Set the priority level to 1 for the Timer 0A interrupt
-	// In the Interrupt 16-19 Priority (PRI4) register,
-	// the INTD field (Bits 31 to 29) corresponds to Interrupt Request (IRQ) 19
-	// Timer 0A has an IRQ of 19
-	NVIC->IPR[4] = (NVIC->IPR[4] & 0x00FFFFFF) | (1 << 29);
+	// Enable Timer 0A
+	GPTM_Enable(GPTM_TIMER0, GPTM_TIMER_A);
+	timer_0a_running = 0x01;
+}
+
+uint8_t Timer_0A_Is_Running(void)
+{
+	return timer_0a_running;
+}
+
+uint32_t Timer_0A_Get_Counter(void)
+{
+	// Only the lower 16 bits of GPTMTAV hold the counter value in
+	// the 16-bit configuration, the upper bits hold the prescaler
+	return (GPTM_Get_Count(GPTM_TIMER0, GPTM_TIMER_A) & 0x0000FFFF);
+}
+
+uint32_t Timer_0A_Get_Value(void)
+{
+	// Read the counter (Bits 15 to 0) and the prescaler (Bits 23 to 16) of GPTMTAV together
+	return GPTM_Get_Count(GPTM_TIMER0, GPTM_TIMER_A);
+}
+
+uint8_t Timer_0A_Timeout_Pending(void)
+{
+	// Read the TATORIS bit (Bit 0) of the GPTMRIS register
+	return GPTM_Timeout_Pending(GPTM_TIMER0, GPTM_TIMER_A);
+}
+
+void Timer_0A_Set_Interval(uint32_t interval_us)
+{
+	// Write the new interval load value to the GPTMTAILR register
+	// It will be loaded at the next time-out since TAILD is set
+	GPTM_Set_Interval(GPTM_TIMER0, GPTM_TIMER_A, interval_us);
+}
+
+void Timer_0A_Get_Jitter_Stats(Timer_0A_Jitter_Stats *stats)
+{
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
 	
-	// Enable IRQ 19 for Timer 0A by setting Bit 19 in the ISER[0] register
-	NVIC->ISER[0] |= (1 << 19);
+	*stats = jitter_stats;
 	
-	// Set the TAEN bit (Bit 0) in the GPTMCTL register to enable Timer 0A
-	TIMER0->CTL |= 0x01;
+	__set_PRIMASK(primask);
 }
 
-void TIMER0A_Handler(void)
+void Timer_0A_Reset_Jitter_Stats(void)
 {
-	// Read the Timer 0A time-out interrupt flag
-	if (TIMER0->MIS & 0x01)
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	
+	for (uint8_t i = 0; i < TIMER_0A_JITTER_BINS; i++)
 	{
-		// Execute the user-defined function
-		(*Timer_0A_Task)();
-		
-		// Acknowledge the Timer 0A interrupt and clear it
-		TIMER0->ICR |= 0x01;
+		jitter_stats.histogram[i] = 0;
 	}
+	jitter_stats.min_latency_cycles = 0xFFFFFFFF;
+	jitter_stats.max_latency_cycles = 0;
+	jitter_stats.overruns = 0;
+	jitter_stats.missed_ticks = 0;
+	
+	__set_PRIMASK(primask);
 }
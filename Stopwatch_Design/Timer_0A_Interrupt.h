@@ -5,10 +5,16 @@
  *
  * This file contains the function definitions for the Timer_0A_Interrupt driver.
  * It uses the Timer 0A module to generate periodic interrupts.
+ * The timer is configured through the GPTM driver, which also provides the Timer 0A interrupt handler.
  *
  * @note Timer 0A has been configured to generate periodic interrupts every 1 ms
  * for the Timers lab.
  *
+ * The timer value is sampled at the start of every interrupt to measure how long the
+ * interrupt was delayed after the time-out. The latencies are collected in a histogram,
+ * time-outs that occur while the previous one is still being handled are counted as
+ * overruns, and ticks that are lost completely are detected with the DWT cycle counter.
+ *
  * @note This driver assumes that the system clock's frequency is 50 MHz.
  * 
  * @note Refer to Table 2-9 (Interrupts) on pages 104 - 106 from the TM4C123G Microcontroller Datasheet
@@ -17,35 +23,123 @@
  *
  * @author Aaron Nanas
  */
- 
+
+#ifndef TIMER_0A_INTERRUPT_H
+#define TIMER_0A_INTERRUPT_H
+
 #include "TM4C123GH6PM.h"
+#include "GPTM.h"
 
-// Declare pointer to the user-defined task
-extern void (*Timer_0A_Task)(void);
+// Number of system clock cycles per microsecond (Timer 0A prescaler)
+#define TIMER_0A_CYCLES_PER_US			50
+
+// Number of bins of the latency histogram
+// Bin 0 counts latencies below 16 cycles, bin N counts latencies from 2^(N+3) to 2^(N+4) - 1 cycles,
+// and the last bin counts all latencies from 2^(TIMER_0A_JITTER_BINS + 2) cycles
+#define TIMER_0A_JITTER_BINS			12
+
+typedef struct
+{
+	uint32_t histogram[TIMER_0A_JITTER_BINS];	// Number of interrupts per latency bin
+	uint32_t min_latency_cycles;	// Shortest latency from the time-out to the start of the task
+	uint32_t max_latency_cycles;	// Longest latency from the time-out to the start of the task
+	uint32_t overruns;				// Number of time-outs that were pending again when the task finished
+	uint32_t missed_ticks;			// Number of time-outs that were never handled
+} Timer_0A_Jitter_Stats;
 
 /**
  * @brief Initializes the Timer 0A peripheral to generate periodic interrupts.
  *
- * This function initializes the Timer 1A peripheral to generate periodic interrupts for executing a user-defined task.
+ * This function initializes the Timer 0A peripheral to generate periodic interrupts for executing a user-defined task.
  * It configures Timer 0A with a 1 ms interval using the 50MHz system clock source.
- * The provided task function will be executed whenever Timer 0A generates an interrupt.
+ * The provided task function will be executed whenever Timer 0A generates an interrupt,
+ * after the interrupt has been cleared and the interrupt latency has been measured.
  * The priority level is set to 1.
  *
  * @param task A pointer to the user-defined function to be executed upon Timer 0A interrupt.
  *
+ * @note SysTick_Delay_Init must be called first, since missed ticks are detected with the DWT cycle counter.
+ *
  * @return None
  */
 void Timer_0A_Interrupt_Init(void(*task)(void));
 
 /**
- * @brief The interrupt service routine (ISR) for Timer 0A.
+ * @brief Reads the current value of the Timer 0A counter.
+ *
+ * Timer 0A counts down from (interval - 1) to zero at 1 MHz, so the returned value
+ * can be used to determine how many microseconds have passed within the current period.
+ *
+ * @param None
+ *
+ * @return The 16-bit counter value of Timer 0A.
+ */
+uint32_t Timer_0A_Get_Counter(void);
+
+/**
+ * @brief Reads the counter and the prescaler of Timer 0A in a single access.
+ *
+ * Bits 15 to 0 hold the counter value and Bits 23 to 16 hold the prescaler, which counts down
+ * from 49 to zero at 50 MHz within every microsecond. Together they give the position within
+ * the current period with a resolution of one system clock cycle.
+ *
+ * @param None
+ *
+ * @return The value of the GPTMTAV register of Timer 0A.
+ */
+uint32_t Timer_0A_Get_Value(void);
+
+/**
+ * @brief Indicates whether Timer 0A has been started by Timer_0A_Interrupt_Init.
  *
- * This function is the interrupt service routine (ISR) for the Timer 0A peripheral.
- * It checks the Timer 0A time-out interrupt flag and executes the user-defined task function if the flag is set.
- * After executing the task function, it acknowledges the Timer 0A interrupt and clears it.
+ * The registers of Timer 0A must not be read before, since its clock is gated until then.
  *
  * @param None
  *
+ * @return 0x01 if Timer 0A is running, otherwise 0x00.
+ */
+uint8_t Timer_0A_Is_Running(void);
+
+/**
+ * @brief Indicates whether a Timer 0A time-out has occurred that has not been handled yet.
+ *
+ * @param None
+ *
+ * @return 0x01 if the TATORIS flag is set, otherwise 0x00.
+ */
+uint8_t Timer_0A_Timeout_Pending(void);
+
+/**
+ * @brief Sets the length of a following Timer 0A period.
+ *
+ * The new interval is written to the GPTMTAILR register and is loaded at the next time-out,
+ * so the period that is currently being counted is not affected.
+ *
+ * @param interval_us The length of the period in microseconds.
+ *
  * @return None
  */
-void TIMER0A_Handler(void);
+void Timer_0A_Set_Interval(uint32_t interval_us);
+
+/**
+ * @brief Reads the interrupt latency histogram and the overrun and missed tick counters.
+ *
+ * The latency is measured in system clock cycles from the time-out to the start of the task,
+ * so it includes the fixed cost of the interrupt entry and of the GPTM interrupt handler.
+ *
+ * @param stats Pointer to the structure that receives the statistics.
+ *
+ * @return None
+ */
+void Timer_0A_Get_Jitter_Stats(Timer_0A_Jitter_Stats *stats);
+
+/**
+ * @brief Clears the interrupt latency histogram and the overrun and missed tick counters.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Timer_0A_Reset_Jitter_Stats(void);
+
+#endif
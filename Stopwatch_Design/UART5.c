@@ -0,0 +1,184 @@
+/**
+ * @file UART5.c
+ *
+ * @brief Source code for the UART5 driver.
+ *
+ * This file contains the function definitions for the UART5 driver.
+ * UART5 is used as the board-to-board link for time synchronization.
+ * The following pins are used:
+ *	- U5Rx (PE4)
+ *	- U5Tx (PE5)
+ *
+ * The UART is configured for 1 Mbps, 8 data bits, no parity, and 1 stop bit (8-N-1).
+ * The FIFOs are disabled so that every received byte generates an interrupt and can be
+ * timestamped with the time base as soon as it arrives. Transmission is interrupt-driven
+ * from a software buffer.
+ *
+ * @note This driver assumes that the system clock's frequency is 50 MHz.
+ *
+ * @author Katherine Poz
+ */
+
+#include "UART5.h"
+
+// Declare pointer to the user-defined task
+static void (*UART5_RX_Task)(uint8_t data, uint64_t timestamp_us);
+
+// Transmit buffer and its read / write indices
+static uint8_t tx_buffer[UART5_TX_BUFFER_SIZE];
+static volatile uint8_t tx_head = 0;
+static volatile uint8_t tx_tail = 0;
+static volatile uint8_t tx_count = 0;
+
+// 0x01 while UART5 holds a reference to its clock
+static uint8_t uart5_clock_acquired = 0x00;
+
+void UART5_Init(void(*rx_task)(uint8_t data, uint64_t timestamp_us))
+{
+	// Store the user-defined task function for use during interrupt handling
+	UART5_RX_Task = rx_task;
+
+	// Acquire the clock to UART5 in run and sleep mode and wait until it is ready to be accessed
+	// UART5 keeps its single reference if it is initialized again
+	if (uart5_clock_acquired == 0x00)
+	{
+		Clock_Gating_Acquire(CLOCK_GATING_UART, 0x20, CLOCK_GATING_RUN_SLEEP);
+		uart5_clock_acquired = 0x01;
+	}
+
+	// PE4 (U5Rx) and PE5 (U5Tx) are configured for UART5 by Board_Pins_Init
+
+	// Disable UART5 during configuration by clearing the UARTEN bit (Bit 0)
+	UART5->CTL &= ~0x01;
+
+	// Baud-rate divisor = 50 MHz / (16 * 1 Mbps) = 3.125
+	// Integer part = 3, fractional part = round(0.125 * 64) = 8
+	UART5->IBRD = 3;
+	UART5->FBRD = 8;
+
+	// Select 8-bit word length (WLEN = 0x3) with no parity and one stop bit
+	// Leave the FIFOs disabled (FEN = 0) so that every byte generates an interrupt
+	UART5->LCRH = 0x60;
+
+	// Use the system clock as the UART clock source
+	UART5->CC = 0x0;
+
+	// Clear any pending receive and transmit interrupts
+	UART5->ICR |= 0x30;
+
+	// Enable the receive (RXIM, Bit 4) and transmit (TXIM, Bit 5) interrupts
+	UART5->IM |= 0x30;
+
+	// Set the priority level of the interrupts to 2. UART5 has an Interrupt Request (IRQ) number of 61
+	NVIC_SetPriority(UART5_IRQn, 2);
+
+	// Enable IRQ 61 for UART5
+	NVIC_EnableIRQ(UART5_IRQn);
+
+	// Enable the transmitter (TXE, Bit 8), the receiver (RXE, Bit 9) and UART5 (UARTEN, Bit 0)
+	UART5->CTL |= 0x301;
+}
+
+void UART5_Deinit(void)
+{
+	if (uart5_clock_acquired == 0x00)
+	{
+		return;
+	}
+
+	// Disable IRQ 61 and mask the receive and transmit interrupts
+	NVIC_DisableIRQ(UART5_IRQn);
+	UART5->IM &= ~0x30;
+
+	// Disable the transmitter (TXE, Bit 8), the receiver (RXE, Bit 9) and UART5 (UARTEN, Bit 0)
+	UART5->CTL &= ~0x301;
+
+	// Discard the bytes that have not been sent
+	tx_head = 0;
+	tx_tail = 0;
+	tx_count = 0;
+
+	// Release the reference of UART5 to its clock
+	Clock_Gating_Release(CLOCK_GATING_UART, 0x20, CLOCK_GATING_RUN_SLEEP);
+	uart5_clock_acquired = 0x00;
+}
+
+uint8_t UART5_Send_Frame(const uint8_t *frame, uint8_t length, uint64_t *tx_timestamp_us)
+{
+	uint8_t accepted = 0x00;
+
+	// The buffer is shared with the UART5 interrupt
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	// The first byte can be written directly when the buffer is empty and the transmit
+	// holding register is free (TXFF, Bit 5 of the UARTFR register is cleared)
+	uint8_t start_now = (tx_count == 0) && ((UART5->FR & 0x20) == 0);
+
+	// A timestamped frame also needs an idle transmitter so that its first byte leaves immediately
+	// The BUSY bit (Bit 3) of the UARTFR register indicates an ongoing transmission
+	uint8_t idle = start_now && ((UART5->FR & 0x08) == 0);
+
+	if ((length > 0) && ((tx_count + length) <= UART5_TX_BUFFER_SIZE) && (idle || (tx_timestamp_us == 0)))
+	{
+		uint8_t index = 0;
+
+		if (start_now)
+		{
+			// Capture the transmit timestamp and send the first byte right away
+			if (tx_timestamp_us != 0)
+			{
+				*tx_timestamp_us = Time_Base_Get_Time_us();
+			}
+			UART5->DR = frame[0];
+			index = 1;
+		}
+
+		// Queue the remaining bytes, they are sent from the transmit interrupt
+		for (; index < length; index++)
+		{
+			tx_buffer[tx_head] = frame[index];
+			tx_head = (tx_head + 1) % UART5_TX_BUFFER_SIZE;
+			tx_count = tx_count + 1;
+		}
+
+		accepted = 0x01;
+	}
+
+	__set_PRIMASK(primask);
+
+	return accepted;
+}
+
+void UART5_Handler(void)
+{
+	// Capture the time base as early as possible
+	uint64_t timestamp_us = Time_Base_Get_Time_us();
+
+	// Check if the receive interrupt (RXMIS, Bit 4) has been triggered
+	if (UART5->MIS & 0x10)
+	{
+		// Read every received byte until the receiver is empty (RXFE, Bit 4 of UARTFR)
+		// Reading the data register clears the receive interrupt
+		while ((UART5->FR & 0x10) == 0)
+		{
+			uint8_t data = UART5->DR & 0xFF;
+			(*UART5_RX_Task)(data, timestamp_us);
+		}
+	}
+
+	// Check if the transmit interrupt (TXMIS, Bit 5) has been triggered
+	if (UART5->MIS & 0x20)
+	{
+		// Acknowledge the transmit interrupt and clear it
+		UART5->ICR |= 0x20;
+
+		// Send the next byte from the transmit buffer
+		if (tx_count > 0)
+		{
+			UART5->DR = tx_buffer[tx_tail];
+			tx_tail = (tx_tail + 1) % UART5_TX_BUFFER_SIZE;
+			tx_count = tx_count - 1;
+		}
+	}
+}
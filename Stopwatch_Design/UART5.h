@@ -0,0 +1,89 @@
+/**
+ * @file UART5.h
+ *
+ * @brief Header file for the UART5 driver.
+ *
+ * This file contains the function definitions for the UART5 driver.
+ * UART5 is used as the board-to-board link for time synchronization.
+ * The following pins are used:
+ *	- U5Rx (PE4)
+ *	- U5Tx (PE5)
+ *
+ * The pins are configured by Board_Pins_Init, which must be called first.
+ *
+ * The UART is configured for 1 Mbps, 8 data bits, no parity, and 1 stop bit (8-N-1).
+ * The FIFOs are disabled so that every received byte generates an interrupt and can be
+ * timestamped with the time base as soon as it arrives. Transmission is interrupt-driven
+ * from a software buffer.
+ *
+ * @note This driver assumes that the system clock's frequency is 50 MHz.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef UART5_H
+#define UART5_H
+
+#include "TM4C123GH6PM.h"
+#include "Time_Base.h"
+#include "Clock_Gating.h"
+
+// Size of the transmit buffer in bytes
+#define UART5_TX_BUFFER_SIZE		64
+
+/**
+ * @brief Initializes UART5 on PE4 and PE5 with receive and transmit interrupts.
+ *
+ * This function configures UART5 for 1 Mbps with 8-N-1 framing and disabled FIFOs.
+ * The provided task function is executed from the UART5 interrupt for every received byte.
+ * Interrupt priority is set to 2 for UART5.
+ *
+ * @param rx_task A pointer to the user-defined function to be executed for each received byte.
+ *                It receives the byte and the time base value captured at interrupt entry.
+ *
+ * @return None
+ */
+void UART5_Init(void(*rx_task)(uint8_t data, uint64_t timestamp_us));
+
+/**
+ * @brief Disables UART5 and releases its clock.
+ *
+ * The bytes that have not been sent are discarded. The clock of UART5 is gated if no other
+ * driver holds a reference to it. UART5 must be initialized again before it can be used.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void UART5_Deinit(void);
+
+/**
+ * @brief Queues a frame for transmission.
+ *
+ * If tx_timestamp_us is not NULL, the frame is only accepted when the transmitter is idle.
+ * The first byte is then written to the data register immediately and the time base value
+ * at that moment is stored in tx_timestamp_us.
+ *
+ * @param frame Pointer to the bytes to be transmitted.
+ *
+ * @param length The number of bytes to be transmitted.
+ *
+ * @param tx_timestamp_us Pointer to store the transmit timestamp of the first byte, or NULL.
+ *
+ * @return 0x01 if the frame was accepted, 0x00 if the transmitter is busy or the buffer is full.
+ */
+uint8_t UART5_Send_Frame(const uint8_t *frame, uint8_t length, uint64_t *tx_timestamp_us);
+
+/**
+ * @brief The interrupt service routine (ISR) for UART5.
+ *
+ * This function captures the time base on entry, passes every received byte to the
+ * user-defined task function, and refills the transmit holding register from the transmit buffer.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void UART5_Handler(void);
+
+#endif
@@ -0,0 +1,381 @@
+/**
+ * @file UDMA.c
+ *
+ * @brief Source code for the UDMA driver.
+ *
+ * This file contains the function definitions for the UDMA driver.
+ * It owns the 1 KB-aligned control table of the Micro Direct Memory Access (uDMA) controller,
+ * assigns the 32 channels to their users and selects the peripheral mapping (encoding) of each channel.
+ *
+ * The control table holds the primary control structures of all channels in its first 512 bytes
+ * and the alternate control structures in its second 512 bytes.
+ *
+ * @author Katherine Poz
+ */
+
+#include "UDMA.h"
+
+typedef struct
+{
+	void (*callback)(uint8_t channel, uint8_t structure);
+	uint8_t allocated;				// 0x01 if the channel is assigned to a user
+	uint8_t ping_pong;				// 0x01 if the finished structures are re-armed from the saved structures
+	UDMA_Task saved[2];				// Primary and alternate structures of a ping-pong transfer
+} UDMA_Channel_State;
+
+// Control table of the uDMA controller (primary structures followed by alternate structures)
+static UDMA_Task udma_control_table[2 * UDMA_CHANNEL_COUNT] __attribute__((aligned(1024)));
+
+static UDMA_Channel_State udma_channels[UDMA_CHANNEL_COUNT];
+
+// Number of bus errors reported by the uDMA controller
+static volatile uint32_t udma_error_count = 0;
+
+// 0x01 while the uDMA controller holds a reference to its clock
+static uint8_t udma_clock_acquired = 0x00;
+
+/**
+ * @brief Calculates the end address of a source or destination buffer.
+ *
+ * @param increment The address increment of the buffer (UDMA_INC_...).
+ *
+ * @param start The start address of the buffer.
+ *
+ * @param count The number of items in the buffer.
+ *
+ * @return The address of the last item of the buffer.
+ */
+static uint32_t UDMA_End_Address(uint32_t increment, const volatile void *start, uint16_t count)
+{
+	uint32_t address = (uint32_t)(uintptr_t)start;
+
+	if (increment == UDMA_INC_NONE)
+	{
+		return address;
+	}
+
+	return address + ((uint32_t)(count - 1) << increment);
+}
+
+/**
+ * @brief Returns the entry of a control structure in the control table.
+ *
+ * @param channel The channel number (0 to 31).
+ *
+ * @param structure UDMA_PRIMARY or UDMA_ALTERNATE.
+ *
+ * @return Pointer to the control structure.
+ */
+static UDMA_Task *UDMA_Get_Structure(uint8_t channel, uint8_t structure)
+{
+	return &udma_control_table[(structure == UDMA_ALTERNATE) ? (UDMA_CHANNEL_COUNT + channel) : channel];
+}
+
+void UDMA_Init(uint8_t priority)
+{
+	// Acquire the clock to the uDMA controller in run and sleep mode and wait until it is ready to be accessed
+	// The controller keeps its single reference if it is initialized again
+	if (udma_clock_acquired == 0x00)
+	{
+		Clock_Gating_Acquire(CLOCK_GATING_DMA, 0x01, CLOCK_GATING_RUN_SLEEP);
+		udma_clock_acquired = 0x01;
+	}
+
+	for (uint8_t i = 0; i < UDMA_CHANNEL_COUNT; i++)
+	{
+		udma_channels[i].callback = 0;
+		udma_channels[i].allocated = 0x00;
+		udma_channels[i].ping_pong = 0x00;
+	}
+
+	// Enable the uDMA controller (MASTEN, Bit 0)
+	UDMA->CFG = 0x01;
+
+	// Set the base address of the control table
+	UDMA->CTLBASE = (uint32_t)(uintptr_t)udma_control_table;
+
+	// Set the priority level of the uDMA software and error interrupts
+	NVIC_SetPriority(UDMA_IRQn, priority);
+	NVIC_SetPriority(UDMAERR_IRQn, priority);
+
+	// Enable IRQ 46 (uDMA software) and IRQ 47 (uDMA error)
+	NVIC_EnableIRQ(UDMA_IRQn);
+	NVIC_EnableIRQ(UDMAERR_IRQn);
+}
+
+uint8_t UDMA_Deinit(void)
+{
+	if (udma_clock_acquired == 0x00)
+	{
+		return 0x01;
+	}
+
+	// The controller stays enabled while any channel is assigned to a user
+	for (uint8_t i = 0; i < UDMA_CHANNEL_COUNT; i++)
+	{
+		if (udma_channels[i].allocated != 0x00)
+		{
+			return 0x00;
+		}
+	}
+
+	// Disable IRQ 46 (uDMA software) and IRQ 47 (uDMA error)
+	NVIC_DisableIRQ(UDMA_IRQn);
+	NVIC_DisableIRQ(UDMAERR_IRQn);
+
+	// Disable the uDMA controller (MASTEN, Bit 0)
+	UDMA->CFG = 0x00;
+
+	// Release the reference of the uDMA controller to its clock
+	Clock_Gating_Release(CLOCK_GATING_DMA, 0x01, CLOCK_GATING_RUN_SLEEP);
+	udma_clock_acquired = 0x00;
+
+	return 0x01;
+}
+
+uint8_t UDMA_Allocate_Channel(uint8_t channel, uint8_t encoding, void(*callback)(uint8_t channel, uint8_t structure))
+{
+	uint32_t bit = 1UL << channel;
+	uint8_t allocated = 0x00;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	if (udma_channels[channel].allocated == 0x00)
+	{
+		udma_channels[channel].allocated = 0x01;
+		udma_channels[channel].ping_pong = 0x00;
+		udma_channels[channel].callback = callback;
+
+		// Select the peripheral of the channel in the DMACHMAPn register (4 bits per channel, 8 channels per register)
+		volatile uint32_t *channel_map = &UDMA->CHMAP0 + (channel / 8);
+		uint32_t shift = (channel % 8) * 4;
+		*channel_map = (*channel_map & ~(0xFUL << shift)) | ((uint32_t)(encoding & 0xF) << shift);
+
+		// Start from a known state: disabled, requests not masked, single and burst requests,
+		// default priority, and the primary control structure
+		UDMA->ENACLR = bit;
+		UDMA->REQMASKCLR = bit;
+		UDMA->USEBURSTCLR = bit;
+		UDMA->PRIOCLR = bit;
+		UDMA->ALTCLR = bit;
+
+		allocated = 0x01;
+	}
+
+	__set_PRIMASK(primask);
+
+	return allocated;
+}
+
+void UDMA_Free_Channel(uint8_t channel)
+{
+	UDMA_Stop(channel);
+
+	udma_channels[channel].callback = 0;
+	udma_channels[channel].allocated = 0x00;
+}
+
+uint8_t UDMA_Set_Transfer(uint8_t channel, uint8_t structure, uint32_t control, uint32_t mode, const volatile void *src, volatile void *dst, uint16_t count)
+{
+	return UDMA_Set_Task(UDMA_Get_Structure(channel, structure), control, mode, src, dst, count);
+}
+
+uint8_t UDMA_Start_Transfer(uint8_t channel, uint32_t control, uint32_t mode, const volatile void *src, volatile void *dst, uint16_t count)
+{
+	uint32_t bit = 1UL << channel;
+
+	udma_channels[channel].ping_pong = 0x00;
+	if (UDMA_Set_Transfer(channel, UDMA_PRIMARY, control, mode, src, dst, count) == 0x00)
+	{
+		return 0x00;
+	}
+
+	// Use the primary control structure and enable the channel
+	UDMA->ALTCLR = bit;
+	UDMA->ENASET = bit;
+
+	return 0x01;
+}
+
+uint8_t UDMA_Start_Ping_Pong(uint8_t channel, uint32_t control, const volatile void *src_a, volatile void *dst_a, const volatile void *src_b, volatile void *dst_b, uint16_t count)
+{
+	uint32_t bit = 1UL << channel;
+	UDMA_Channel_State *state = &udma_channels[channel];
+
+	if ((count == 0) || (count > UDMA_MAX_TRANSFER))
+	{
+		return 0x00;
+	}
+
+	// Save both structures so that they can be re-armed when they have finished
+	UDMA_Set_Task(&state->saved[UDMA_PRIMARY], control, UDMA_MODE_PING_PONG, src_a, dst_a, count);
+	UDMA_Set_Task(&state->saved[UDMA_ALTERNATE], control, UDMA_MODE_PING_PONG, src_b, dst_b, count);
+
+	*UDMA_Get_Structure(channel, UDMA_PRIMARY) = state->saved[UDMA_PRIMARY];
+	*UDMA_Get_Structure(channel, UDMA_ALTERNATE) = state->saved[UDMA_ALTERNATE];
+	state->ping_pong = 0x01;
+
+	// Start with the primary control structure and enable the channel
+	UDMA->ALTCLR = bit;
+	UDMA->ENASET = bit;
+
+	return 0x01;
+}
+
+uint8_t UDMA_Set_Task(UDMA_Task *task, uint32_t control, uint32_t mode, const volatile void *src, volatile void *dst, uint16_t count)
+{
+	// XFERSIZE (Bits 13 to 4) holds the number of items minus one
+	if ((count == 0) || (count > UDMA_MAX_TRANSFER))
+	{
+		return 0x00;
+	}
+
+	task->src_end = UDMA_End_Address((control >> 26) & 0x3, src, count);
+	task->dst_end = UDMA_End_Address((control >> 30) & 0x3, dst, count);
+	task->control = control | ((uint32_t)(count - 1) << 4) | mode;
+	task->unused = 0;
+
+	return 0x01;
+}
+
+uint8_t UDMA_Start_Scatter_Gather(uint8_t channel, const UDMA_Task *tasks, uint16_t num_tasks, uint8_t peripheral)
+{
+	uint32_t bit = 1UL << channel;
+	UDMA_Task *primary = UDMA_Get_Structure(channel, UDMA_PRIMARY);
+
+	// Every task is copied as 4 words, so the list must fit into one transfer of the primary structure
+	if ((num_tasks == 0) || (num_tasks > (UDMA_MAX_TRANSFER / 4)))
+	{
+		return 0x00;
+	}
+
+	udma_channels[channel].ping_pong = 0x00;
+
+	// The primary structure copies one task (4 words) at a time from the task list
+	// into the alternate structure, which then executes the task
+	primary->src_end = (uint32_t)(uintptr_t)&tasks[num_tasks - 1].unused;
+	primary->dst_end = (uint32_t)(uintptr_t)&UDMA_Get_Structure(channel, UDMA_ALTERNATE)->unused;
+	primary->control = UDMA_CONTROL(UDMA_INC_32, UDMA_INC_32, UDMA_SIZE_32, 2)
+		| ((uint32_t)((num_tasks * 4) - 1) << 4)
+		| ((peripheral != 0x00) ? UDMA_MODE_PERIPHERAL_SG : UDMA_MODE_MEMORY_SG);
+
+	// Start with the primary control structure and enable the channel
+	UDMA->ALTCLR = bit;
+	UDMA->ENASET = bit;
+
+	return 0x01;
+}
+
+void UDMA_Request(uint8_t channel)
+{
+	UDMA->SWREQ = 1UL << channel;
+}
+
+void UDMA_Stop(uint8_t channel)
+{
+	uint32_t bit = 1UL << channel;
+
+	UDMA->ENACLR = bit;
+	udma_channels[channel].ping_pong = 0x00;
+
+	// Discard a completion that has not been serviced yet
+	UDMA->CHIS = bit;
+}
+
+uint16_t UDMA_Get_Remaining(uint8_t channel, uint8_t structure)
+{
+	uint32_t control = UDMA_Get_Structure(channel, structure)->control;
+
+	if ((control & 0x7) == UDMA_MODE_STOP)
+	{
+		return 0;
+	}
+
+	// XFERSIZE (Bits 13 to 4) holds the number of remaining items minus one
+	return (uint16_t)(((control >> 4) & 0x3FF) + 1);
+}
+
+void UDMA_Service_Channel(uint8_t channel)
+{
+	uint32_t bit = 1UL << channel;
+	UDMA_Channel_State *state = &udma_channels[channel];
+
+	// Check and clear the completion flag of the channel
+	if ((UDMA->CHIS & bit) == 0)
+	{
+		return;
+	}
+	UDMA->CHIS = bit;
+
+	if (state->ping_pong == 0x01)
+	{
+		// Re-arm every structure that has finished, then report it
+		for (uint8_t structure = UDMA_PRIMARY; structure <= UDMA_ALTERNATE; structure++)
+		{
+			UDMA_Task *entry = UDMA_Get_Structure(channel, structure);
+
+			if ((entry->control & 0x7) == UDMA_MODE_STOP)
+			{
+				*entry = state->saved[structure];
+
+				if (state->callback != 0)
+				{
+					(*state->callback)(channel, structure);
+				}
+			}
+		}
+	}
+	else if ((UDMA->ENASET & bit) == 0)
+	{
+		// The channel disables itself when a basic, auto or scatter-gather transfer is done
+		if (state->callback != 0)
+		{
+			(*state->callback)(channel, UDMA_PRIMARY);
+		}
+	}
+}
+
+uint32_t UDMA_Get_Error_Count(void)
+{
+	return udma_error_count;
+}
+
+/**
+ * @brief The interrupt service routine for the uDMA software interrupt.
+ *
+ * It reports the completed transfers of all channels that use software requests.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void UDMA_Handler(void)
+{
+	uint32_t status = UDMA->CHIS;
+
+	for (uint8_t channel = 0; channel < UDMA_CHANNEL_COUNT; channel++)
+	{
+		if (status & (1UL << channel))
+		{
+			UDMA_Service_Channel(channel);
+		}
+	}
+}
+
+/**
+ * @brief The interrupt service routine for the uDMA error interrupt.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void UDMAERR_Handler(void)
+{
+	// Clear the bus error flag (ERRCLR, Bit 0)
+	if (UDMA->ERRCLR & 0x01)
+	{
+		UDMA->ERRCLR = 0x01;
+		udma_error_count++;
+	}
+}
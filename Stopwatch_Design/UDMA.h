@@ -0,0 +1,284 @@
+/**
+ * @file UDMA.h
+ *
+ * @brief Header file for the UDMA driver.
+ *
+ * This file contains the function definitions for the UDMA driver.
+ * It owns the 1 KB-aligned control table of the Micro Direct Memory Access (uDMA) controller,
+ * assigns the 32 channels to their users and selects the peripheral mapping (encoding) of each channel.
+ *
+ * The following transfer modes are supported:
+ *	- Basic and Auto: A single transfer that stops the channel when it is done.
+ *	- Ping-Pong: The primary and alternate control structures are used alternately. The structure
+ *	  that has finished is re-armed with the same parameters before the callback is executed,
+ *	  so the user only has to process (or refill) the buffer that was just completed.
+ *	- Scatter-Gather: The channel executes a list of tasks (UDMA_Task) that is copied by the controller
+ *	  into the alternate control structure one task at a time.
+ *
+ * Completion is reported through the callback of the channel with the control structure that has finished.
+ * Transfers requested by software are completed in the uDMA software interrupt. Transfers requested by a
+ * peripheral complete on the peripheral's own interrupt, so its handler must call UDMA_Service_Channel.
+ *
+ * @note Refer to Table 9-1 (uDMA Channel Assignments) on page 587 of the TM4C123G Microcontroller Datasheet
+ * to view the channel and encoding of each peripheral.
+ *
+ * @author Katherine Poz
+ */
+
+#ifndef UDMA_H
+#define UDMA_H
+
+#include "TM4C123GH6PM.h"
+#include "Clock_Gating.h"
+
+// Number of uDMA channels
+#define UDMA_CHANNEL_COUNT				32
+
+// Maximum number of items of one control structure (10-bit XFERSIZE field)
+#define UDMA_MAX_TRANSFER				1024
+
+// Control structure selection
+#define UDMA_PRIMARY					0x00
+#define UDMA_ALTERNATE					0x01
+
+// Data size of each item (SRCSIZE and DSTSIZE fields)
+#define UDMA_SIZE_8						0x0
+#define UDMA_SIZE_16					0x1
+#define UDMA_SIZE_32					0x2
+
+// Address increment (SRCINC and DSTINC fields)
+#define UDMA_INC_8						0x0
+#define UDMA_INC_16						0x1
+#define UDMA_INC_32						0x2
+#define UDMA_INC_NONE					0x3
+
+// Transfer modes (XFERMODE field)
+#define UDMA_MODE_STOP					0x0
+#define UDMA_MODE_BASIC					0x1
+#define UDMA_MODE_AUTO					0x2
+#define UDMA_MODE_PING_PONG				0x3
+#define UDMA_MODE_MEMORY_SG				0x4
+#define UDMA_MODE_ALT_MEMORY_SG			0x5
+#define UDMA_MODE_PERIPHERAL_SG			0x6
+#define UDMA_MODE_ALT_PERIPHERAL_SG		0x7
+
+/**
+ * Builds the fixed part of a channel control word (DMACHCTL).
+ * The arbitration size is given as a power of two (0 = 1 item, ..., 10 = 1024 items).
+ * The transfer size and mode are added by the driver.
+ */
+#define UDMA_CONTROL(dst_inc, src_inc, size, arb_log2) \
+	(((uint32_t)(dst_inc) << 30) | ((uint32_t)(size) << 28) | \
+	 ((uint32_t)(src_inc) << 26) | ((uint32_t)(size) << 24) | \
+	 ((uint32_t)(arb_log2) << 14))
+
+// One entry of the control table, also used as a task of a scatter-gather list
+typedef struct
+{
+	volatile uint32_t src_end;		// Address of the last source item (DMASRCENDP)
+	volatile uint32_t dst_end;		// Address of the last destination item (DMADSTENDP)
+	volatile uint32_t control;		// Channel control word (DMACHCTL)
+	volatile uint32_t unused;
+} UDMA_Task;
+
+/**
+ * @brief Initializes the uDMA controller.
+ *
+ * This function enables the controller, installs the control table and enables the
+ * uDMA software and error interrupts.
+ *
+ * @param priority The interrupt priority level (0 to 7) of the uDMA software and error interrupts.
+ *
+ * @return None
+ */
+void UDMA_Init(uint8_t priority);
+
+/**
+ * @brief Disables the uDMA controller and releases its clock.
+ *
+ * The clock of the controller is gated if no other driver holds a reference to it.
+ * UDMA_Init must be called again before the controller can be used.
+ *
+ * @param None
+ *
+ * @return 0x01 if the controller was released, 0x00 if a channel is still allocated.
+ */
+uint8_t UDMA_Deinit(void);
+
+/**
+ * @brief Assigns a channel and selects its peripheral mapping.
+ *
+ * @param channel The channel number (0 to 31).
+ *
+ * @param encoding The channel encoding (0 to 4) that selects the peripheral of the channel.
+ *
+ * @param callback The function executed when a control structure of the channel has finished, or NULL.
+ *                 It receives the channel and the finished control structure (UDMA_PRIMARY or UDMA_ALTERNATE).
+ *
+ * @return 0x01 if the channel was assigned, 0x00 if it is already in use.
+ */
+uint8_t UDMA_Allocate_Channel(uint8_t channel, uint8_t encoding, void(*callback)(uint8_t channel, uint8_t structure));
+
+/**
+ * @brief Stops a channel and releases it.
+ *
+ * @param channel The channel number (0 to 31).
+ *
+ * @return None
+ */
+void UDMA_Free_Channel(uint8_t channel);
+
+/**
+ * @brief Writes one control structure of a channel without enabling the channel.
+ *
+ * @param channel The channel number (0 to 31).
+ *
+ * @param structure UDMA_PRIMARY or UDMA_ALTERNATE.
+ *
+ * @param control The fixed part of the control word built with UDMA_CONTROL.
+ *
+ * @param mode The transfer mode (UDMA_MODE_...).
+ *
+ * @param src The start address of the source.
+ *
+ * @param dst The start address of the destination.
+ *
+ * @param count The number of items to transfer (1 to 1024).
+ *
+ * @return 0x01 if the structure was written, 0x00 if count is out of range.
+ */
+uint8_t UDMA_Set_Transfer(uint8_t channel, uint8_t structure, uint32_t control, uint32_t mode, const volatile void *src, volatile void *dst, uint16_t count);
+
+/**
+ * @brief Starts a single (basic or auto) transfer on a channel.
+ *
+ * Auto mode is used for memory-to-memory transfers requested by software. Basic mode is used
+ * for transfers requested by a peripheral. A transfer requested by software starts when
+ * UDMA_Request is called.
+ *
+ * @param channel The channel number (0 to 31).
+ *
+ * @param control The fixed part of the control word built with UDMA_CONTROL.
+ *
+ * @param mode UDMA_MODE_BASIC or UDMA_MODE_AUTO.
+ *
+ * @param src The start address of the source.
+ *
+ * @param dst The start address of the destination.
+ *
+ * @param count The number of items to transfer (1 to 1024).
+ *
+ * @return 0x01 if the transfer was started, 0x00 if count is out of range.
+ */
+uint8_t UDMA_Start_Transfer(uint8_t channel, uint32_t control, uint32_t mode, const volatile void *src, volatile void *dst, uint16_t count);
+
+/**
+ * @brief Starts a continuous ping-pong transfer on a channel.
+ *
+ * The primary structure transfers between src_a and dst_a, the alternate structure between
+ * src_b and dst_b. Either the sources or the destinations are typically the same peripheral register.
+ *
+ * @param channel The channel number (0 to 31).
+ *
+ * @param control The fixed part of the control word built with UDMA_CONTROL.
+ *
+ * @param src_a The source of the primary structure.
+ *
+ * @param dst_a The destination of the primary structure.
+ *
+ * @param src_b The source of the alternate structure.
+ *
+ * @param dst_b The destination of the alternate structure.
+ *
+ * @param count The number of items of each structure (1 to 1024).
+ *
+ * @return 0x01 if the transfer was started, 0x00 if count is out of range.
+ */
+uint8_t UDMA_Start_Ping_Pong(uint8_t channel, uint32_t control, const volatile void *src_a, volatile void *dst_a, const volatile void *src_b, volatile void *dst_b, uint16_t count);
+
+/**
+ * @brief Fills in one task of a scatter-gather list.
+ *
+ * @param task Pointer to the task.
+ *
+ * @param control The fixed part of the control word built with UDMA_CONTROL.
+ *
+ * @param mode The mode of the task: UDMA_MODE_AUTO or UDMA_MODE_BASIC for the last task,
+ *             UDMA_MODE_ALT_MEMORY_SG or UDMA_MODE_ALT_PERIPHERAL_SG for all other tasks.
+ *
+ * @param src The start address of the source.
+ *
+ * @param dst The start address of the destination.
+ *
+ * @param count The number of items to transfer (1 to 1024).
+ *
+ * @return 0x01 if the structure was written, 0x00 if count is out of range.
+ */
+uint8_t UDMA_Set_Task(UDMA_Task *task, uint32_t control, uint32_t mode, const volatile void *src, volatile void *dst, uint16_t count);
+
+/**
+ * @brief Starts a scatter-gather transfer on a channel.
+ *
+ * @param channel The channel number (0 to 31).
+ *
+ * @param tasks The list of tasks filled in with UDMA_Set_Task. It must stay valid until the transfer is done.
+ *
+ * @param num_tasks The number of tasks in the list (1 to 256).
+ *
+ * @param peripheral 0x01 if the tasks are requested by a peripheral, 0x00 for memory scatter-gather.
+ *
+ * @return 0x01 if the transfer was started, 0x00 if num_tasks is out of range.
+ */
+uint8_t UDMA_Start_Scatter_Gather(uint8_t channel, const UDMA_Task *tasks, uint16_t num_tasks, uint8_t peripheral);
+
+/**
+ * @brief Generates a software request on a channel.
+ *
+ * @param channel The channel number (0 to 31).
+ *
+ * @return None
+ */
+void UDMA_Request(uint8_t channel);
+
+/**
+ * @brief Stops a channel.
+ *
+ * @param channel The channel number (0 to 31).
+ *
+ * @return None
+ */
+void UDMA_Stop(uint8_t channel);
+
+/**
+ * @brief Returns the number of items that the control structure still has to transfer.
+ *
+ * @param channel The channel number (0 to 31).
+ *
+ * @param structure UDMA_PRIMARY or UDMA_ALTERNATE.
+ *
+ * @return The number of remaining items, or 0 if the structure has finished.
+ */
+uint16_t UDMA_Get_Remaining(uint8_t channel, uint8_t structure);
+
+/**
+ * @brief Reports the completed transfers of a channel.
+ *
+ * This function must be called from the interrupt handler of a peripheral that uses a
+ * uDMA channel. It re-arms finished ping-pong structures and executes the channel's callback.
+ *
+ * @param channel The channel number (0 to 31).
+ *
+ * @return None
+ */
+void UDMA_Service_Channel(uint8_t channel);
+
+/**
+ * @brief Returns the number of bus errors reported by the uDMA controller.
+ *
+ * @param None
+ *
+ * @return The number of bus errors since UDMA_Init was called.
+ */
+uint32_t UDMA_Get_Error_Count(void);
+
+#endif
@@ -6,8 +6,8 @@
  * This file contains the main entry point and function definitions for the Stopwatch_Design program.
  * This lab involves designing a basic stopwatch. It demonstrates edge-triggered interrupts, 
  * and it interfaces with the following:
- *  - User LED (RGB) Tiva C Series TM4C123G LaunchPad
- *	- EduBase Board LEDs (LED0 - LED3)
+ *  - User LED (RGB) Tiva C Series TM4C123G LaunchPad, driven by PWM outputs
+ *	- EduBase Board LEDs (LED0 - LED3), driven by timer PWM outputs
  *	- EduBase Board Push Buttons (SW2 - SW3)
  *	- EduBase Board Seven-Segment Display
  *	- PMOD BTN module
@@ -19,14 +19,85 @@
  * stopwatch (milliseconds, seconds, and minutes) will increment in the Timer 0A
  * periodic task. The PMOD BTN module will be used to control the stopwatch.
  *
+ * Several boards can be connected over UART5 (PE4 and PE5) to keep their time bases
+ * synchronized. On the master board (TIME_SYNC_BOARD_ID = 0), BTN0 schedules a
+ * synchronized start that fires on the same tick on every board.
+ *
+ * Every start from a cleared stopwatch begins a new session, and BTN3 records a lap.
+ * The display holds the split time of the lap while the stopwatch keeps running, until
+ * BTN3 is pressed again and the display catches up with the running time. While the
+ * stopwatch is stopped, BTN3 pages through the split times of the most recent session
+ * from the lap log, and returns to the stopwatch value after the last lap.
+ * Sessions and laps are timestamped with the time of day from the Hibernation module RTC.
+ * The lap times are taken from the microsecond timestamps of the button presses, so they
+ * are not quantized to the Timer 0A tick or to the tenths of the display.
+ *
+ * The display shows the stopwatch time from the microsecond time base in one of three
+ * resolutions, which BTN1 selects while the stopwatch is stopped:
+ *	- Tenths: M.SS.t
+ *	- Hundredths: SS.hh during the first minute, then M.SS.t
+ *	- Thousandths: S.mmm during the first 10 seconds, then SS.hh and M.SS.t
+ * The stopwatch value stops at about 71.6 minutes, the range of the 32-bit lap times,
+ * and the display then shows EEEE until the stopwatch is reset.
+ *
+ * The button interrupts and Timer 0A only capture the event or count the tick. The button
+ * handlers and the clearing of the stopwatch value are deferred to the PendSV interrupt at
+ * the lowest priority, so the high-priority handlers stay short.
+ *
+ * SW4 starts and stops a recording of the input events, and SW5 replays the recording.
+ * Both reset the stopwatch first, so a replay repeats the recorded run tick for tick.
+ *
+ * A photogate on PC6 records laps as well. Its edges are timestamped by Wide Timer 1A and
+ * moved into a RAM ring by the uDMA controller, and the main loop turns the first edge of
+ * every pass into a lap. If its uDMA channel cannot be allocated, the RGB LED blinks red for
+ * two seconds at startup and the photogate is not used.
+ *
  * @Katherine Poz
  */
 #include "TM4C123GH6PM.h"
+#include "Floating_Point.h"
+#include "Clock_Gating.h"
+#include "Deferred_Work.h"
+#include "Board_Pins.h"
 #include "GPIO.h"
 #include "PMOD_BTN_Interrupt.h"
 #include "EduBase_Button_Interrupt.h"
 #include "Seven_Segment_Display.h"
 #include "Timer_0A_Interrupt.h"
+#include "Time_Base.h"
+#include "Time_Sync.h"
+#include "Hibernation_RTC.h"
+#include "Lap_Log.h"
+#include "Input_Recorder.h"
+#include "EduBase_LED_PWM.h"
+#include "RGB_LED_PWM.h"
+#include "Temperature_Compensation.h"
+#include "Profiler.h"
+#include "UDMA.h"
+#include "Edge_Logger.h"
+
+// ID of this board on the time synchronization link (0 = master)
+#define TIME_SYNC_BOARD_ID 0
+
+// Sampling rate of the profiler in Hz (prime, so the samples are not locked to the 1 ms tick)
+#define PROFILER_RATE_HZ 997
+
+// Minimum time between two photogate laps in microseconds
+// Further edges of the same pass (e.g. arms and legs of a runner) are ignored
+#define PHOTOGATE_HOLDOFF_US 200000
+
+// Blink period and duration of the error shown by the RGB LED if the photogate cannot be started
+#define PHOTOGATE_ERROR_BLINK_MS 250
+#define PHOTOGATE_ERROR_TIME_MS 2000
+
+// Largest stopwatch value in microseconds (about 71.6 minutes), since laps are stored as 32-bit values
+// The stopwatch value saturates there and the display shows EEEE
+#define STOPWATCH_MAX_US 0xFFFFFFFFUL
+#define DISPLAY_OVERFLOW_DIGIT 0x0E
+
+// Scan schedule of the display: 0x01 for the adaptive scan, 0x00 to scan all four digits
+// The SSI traffic of both schedules is measured in display_telemetry
+#define DISPLAY_ADAPTIVE_SCAN 0x01
 
 //Declare the user-defined function prototype for PMOD_BTN_Interrupt
 void PMOD_BTN_Handler(uint8_t pmod_btn_status);
@@ -34,68 +105,266 @@ void PMOD_BTN_Handler(uint8_t pmod_btn_status);
 //Declare the user-defined function prototype for EduBase_Button_Interrupt
 void EduBase_Button_Handler(uint8_t edubase_button_status);
 
+// Declare the function prototypes for the interrupt tasks that defer the button handlers
+void PMOD_BTN_Interrupt_Task(uint8_t pmod_btn_status);
+void EduBase_Button_Interrupt_Task(uint8_t edubase_button_status);
+
+// Frequency error of this board's oscillator over temperature
+// Each entry is (temperature in 0.01 degrees Celsius, frequency error in parts per billion)
+// The curve of this board has not been measured yet, so a single point with no error is used
+// and the temperature compensation leaves the time base unchanged. Replace it with the points
+// measured during calibration of the board.
+static const Temperature_Compensation_Point board_temperature_curve[] =
+{
+	{  2500,      0 }
+};
+
 //Initialize a global variable for an 8-bit counter
 static uint8_t counter = 0; 
 
+// Display resolutions of the stopwatch value
+#define DISPLAY_TENTHS					0x00
+#define DISPLAY_HUNDREDTHS				0x01
+#define DISPLAY_THOUSANDTHS			0x02
+#define DISPLAY_RESOLUTION_COUNT		3
+
 // * Declare the function prototype for the function that calculates
 //stopwatch value and stores it in an array
-void Calculate_Stopwatch_Value(uint8_t stopwatch_value[]);
+uint8_t Calculate_Stopwatch_Value(uint8_t stopwatch_value[]);
 
 // Declare the function prototype for the user-defined function for Timer 0A
 void Timer_0A_Periodic_Task(void);
 
-// Initialize a global variable for Timer 0A to keep track of elapsed time in milliseconds
-static uint8_t ms_elapsed = 0;
+// Declare the function prototype for the deferred task that clears the stopwatch value
+void Stopwatch_Reset_Task(uint8_t data);
+
+// Declare the function prototype for the synchronized start of the stopwatch
+void Synchronized_Start_Task(void);
+
+// Declare the function prototype for the function that starts the stopwatch
+void Start_Stopwatch(uint64_t start_us);
 
-// Initialize global variable to keep track of the stopwatch value (i.e. milliseconds, seconds, and minutes)
-// "milliseconds" is updated every 100 ms (Range 0 to 999 ms)
-// "seconds" is updated every 1000 ms (Range 0 to 59 sec)
-// "minutes" is updated every 60 seconds (Range 0 to 9 minutes)
-static uint8_t milliseconds = 0;
-static uint8_t seconds = 0;
-static uint8_t minutes = 0;
+// Declare the function prototype for the function that returns the stopwatch value in milliseconds
+uint32_t Get_Stopwatch_Time_ms(void);
+
+// Declare the function prototype for the function that returns the stopwatch value at a given time in microseconds
+uint32_t Get_Stopwatch_Time_us(uint64_t time_us);
+
+// Declare the function prototype for the function that returns the time of the button press being handled
+uint64_t Get_Button_Time_us(void);
+
+// Declare the function prototype for the function that resets the state of the stopwatch
+void Reset_Stopwatch_State(void);
+
+// Declare the function prototypes for the functions that hold and release the split time
+void Hold_Split(uint32_t split_us);
+void Release_Split(void);
+
+// Declare the function prototype for the function that pages through the laps of the most recent session
+void Show_Next_History_Lap(void);
+
+// Declare the function prototypes for the photogate lap task and its deferred handler
+void Photogate_Lap_Task(uint64_t event_us);
+void Photogate_Lap_Handler(uint8_t data);
+
+// Initialize a global variable for the split time in microseconds that is latched while the display is held
+static uint32_t split_time_us = 0;
+
+// Initialize a global flag that is set if the photogate edges are logged
+static uint8_t photogate_enabled = 0;
+
+// Initialize a global flag that is set while the display holds the split time
+static volatile uint8_t split_held = 0;
+
+// Initialize a global variable for the lap of the most recent session that is shown while paging
+// 0 while no lap is shown
+static uint8_t history_lap = 0;
+
+// Initialize a global variable for the selected display resolution
+static uint8_t display_resolution = DISPLAY_TENTHS;
+
+// Initialize global variables for the stopwatch time with microsecond resolution
+// "run_start_us" is the time base value when the stopwatch was last started
+// "run_total_us" is the stopwatch time that was accumulated before that start
+static uint64_t run_start_us = 0;
+static uint32_t run_total_us = 0;
 
 // Initialize global flags for starting and resetting the stopwatch
-static uint8_t start_stopwatch = 0;
+// "start_stopwatch", "run_start_us" and "run_total_us" are written together with interrupts
+// disabled, since the main loop, PendSV and Timer 0A all read them
+static volatile uint8_t start_stopwatch = 0;
 static uint8_t reset_stopwatch = 0;
 
+// Display telemetry of the last second, read by the debugger (SSI transactions per second and bus load)
+volatile Seven_Segment_Display_Telemetry display_telemetry;
+
 int main(void)
 {
-	// Initialize the push buttons on the PMOD BTN module (Port A)
-	PMOD_BTN_Interrupt_Init(&PMOD_BTN_Handler);
+	// Enable the FPU with lazy stacking of the floating-point context
+	Floating_Point_Init();
+	
+	// Gate the clocks of all peripherals until they are acquired by the drivers
+	Clock_Gating_Init();
+	
+	// Configure every pin of the board from the board pin table
+	Board_Pins_Init();
+	
+	// Initialize the queue of the tasks that are deferred to the PendSV interrupt
+	Deferred_Work_Init();
 	
-	// Initialize the LEDs on the EduBase board (Port B)
-	EduBase_LEDs_Init();
+	// Initialize the input recorder, which passes the button events to the handlers
+	// SW4 and SW5 (0x02 and 0x01) control the recorder and are not recorded
+	Input_Recorder_Init(&PMOD_BTN_Interrupt_Task, &EduBase_Button_Interrupt_Task, 0x03, &Reset_Stopwatch_State);
 	
-	// Initialize the SysTick timer used to provide blocking delay functions
+	// Initialize and calibrate the cycle counter used to provide blocking delay functions
+	// The measured interrupt entry latency is used to timestamp the button presses
 	SysTick_Delay_Init();
 	
+	// Initialize the push buttons on the PMOD BTN module (Port A)
+	PMOD_BTN_Interrupt_Init(&Input_Recorder_PMOD_BTN_Input);
+	
+	// Initialize the PWM outputs of the LEDs on the EduBase board (Port B, Timer 2 and Timer 3)
+	EduBase_LED_PWM_Init();
+	
 	// Initialize the Seven Segment Display (Port B and C)
 	Seven_Segment_Display_Init();
+	Seven_Segment_Display_Set_Adaptive_Scan(DISPLAY_ADAPTIVE_SCAN);
+	
+	// Initialize the SW2 to SW5 on the EduBase board with interrupts enable (Port D)
+	EduBase_Button_Interrupt_Init(&Input_Recorder_EduBase_Button_Input);
+	
+	// Initialize the PWM outputs of the RGB LED (Port F, PWM Module 1 and Timer 4A)
+	RGB_LED_PWM_Init();
 	
-	// Initialize the SW2 and SW3 on the EduBase board with interrupts enable (Port D)
-	EduBase_Button_Interrupt_Init(&EduBase_Button_Handler);
+	// Initialize the Hibernation module RTC used to timestamp sessions and laps
+	Hibernation_RTC_Init();
 	
-	// Initialize the RGB LED (Port F)
-	RGB_LED_Init();
+	// Restore the lap log and its session index from the flash memory
+	Lap_Log_Init();
+	
+	// Initialize the microsecond time base that is driven by Timer 0A
+	Time_Base_Init();
+	
+	// Initialize the temperature compensation of the time base (ADC0 and Timer 1A)
+	Temperature_Compensation_Init(board_temperature_curve, sizeof(board_temperature_curve) / sizeof(board_temperature_curve[0]));
+	
+	// Initialize the time synchronization with the other boards (Port E, UART5)
+	Time_Sync_Init(TIME_SYNC_BOARD_ID, &Synchronized_Start_Task);
 	
 	// Initialize Timer 0A to generate periodic interrupts every 1ms
 	Timer_0A_Interrupt_Init(&Timer_0A_Periodic_Task);
 	
+	// Initialize the uDMA controller and log the photogate edges on PC6 (Wide Timer 1A)
+	UDMA_Init(5);
+	photogate_enabled = Edge_Logger_Init(GPTM_EDGE_FALLING, PHOTOGATE_HOLDOFF_US, &Photogate_Lap_Task, 2);
+	
+	// Blink the RGB LED red for two seconds if the uDMA channel of the photogate is not available
+	if (photogate_enabled == 0x00)
+	{
+		RGB_LED_PWM_Start_Pattern(RGB_LED_PWM_BLINK, RGB_LED_PWM_MAX, 0, 0, PHOTOGATE_ERROR_BLINK_MS);
+		SysTick_Delay1ms(PHOTOGATE_ERROR_TIME_MS);
+		RGB_LED_PWM_Set_Color(0, 0, 0);
+	}
+	
+	// Sample the program counter with Wide Timer 5A to profile the application
+	Profiler_Init(PROFILER_RATE_HZ);
+	Profiler_Start();
+	
 	// Initialize a uint8_t array to store each digit of the stopwatch value
 	uint8_t stopwatch_value[4] = {0};
 	
 	while(1)
 	{
-		Calculate_Stopwatch_Value(stopwatch_value);
-		Seven_Segment_Display_Stopwatch(stopwatch_value); 
+		uint8_t decimal_points = Calculate_Stopwatch_Value(stopwatch_value);
+		Seven_Segment_Display_Stopwatch(stopwatch_value, decimal_points);
+		
+		// Publish the display and SSI2 rates of the last second for the debugger
+		Seven_Segment_Display_Telemetry telemetry;
+		Seven_Segment_Display_Get_Telemetry(&telemetry);
+		display_telemetry = telemetry;
+		
+		// Program new lap records into the flash memory
+		// Flash blocks are only erased while the stopwatch is stopped
+		Lap_Log_Service(start_stopwatch == 0x00);
+		
+		// Turn the captured photogate edges into laps
+		if (photogate_enabled == 0x01)
+		{
+			Edge_Logger_Service();
+		}
 	}
 }
 
 
+/**
+* @brief Defers the handling of a PMOD button press to the PendSV interrupt.
+*
+* This function is executed from the GPIO Port A interrupt, or from the input recorder
+* during a replay. It only queues the button status with the time of the press.
+*
+* @param pmod_btn_status The status of the PMOD buttons.
+*
+* @return None
+*/
+void PMOD_BTN_Interrupt_Task(uint8_t pmod_btn_status)
+{
+	Deferred_Work_Post(&PMOD_BTN_Handler, pmod_btn_status, Get_Button_Time_us());
+}
+
+/**
+* @brief Defers the handling of an EduBase button press to the PendSV interrupt.
+*
+* @param edubase_button_status The status of the EduBase buttons.
+*
+* @return None
+*/
+void EduBase_Button_Interrupt_Task(uint8_t edubase_button_status)
+{
+	Deferred_Work_Post(&EduBase_Button_Handler, edubase_button_status, Time_Base_Get_Time_us());
+}
+
+/**
+* @brief Defers a photogate lap to the PendSV interrupt.
+*
+* This function is executed from Edge_Logger_Service in the main loop. The lap is handled
+* by PendSV like a button press, so the stopwatch state is only changed from one context.
+*
+* @param event_us The time of the edge that starts the lap in microseconds.
+*
+* @return None
+*/
+void Photogate_Lap_Task(uint64_t event_us)
+{
+	Deferred_Work_Post(&Photogate_Lap_Handler, 0x00, event_us);
+}
+
+/**
+* @brief Records a photogate lap and holds its split time on the display.
+*
+* This function is executed as a deferred task from the PendSV interrupt.
+* Edges are ignored while the stopwatch is stopped.
+*
+* @param data Not used.
+*
+* @return None
+*/
+void Photogate_Lap_Handler(uint8_t data)
+{
+	(void)data;
+	
+	if (start_stopwatch == 0x01)
+	{
+		uint32_t lap_us = Get_Stopwatch_Time_us(Deferred_Work_Get_Timestamp_us());
+		Hold_Split(lap_us);
+		Lap_Log_Add_Lap(lap_us);
+	}
+}
+
 /**
 * @brief Handle the PMOD button press and performs the action to interrupt
 *
+* This function is executed as a deferred task from the PendSV interrupt.
+*
 * @param PMOD_BTN_Status of the PMOD buttons. Each button is represented differently
 * 				0x04 for BTN0
 *					0x08 for BTN1
@@ -109,33 +378,68 @@ void PMOD_BTN_Handler(uint8_t pmod_btn_status)
 	switch(pmod_btn_status)
 	{
 		// BTN0 (PA2) is pressed
+		// The master schedules a synchronized start on all boards
 		case 0x04:
 		{
-			RGB_LED_Output(RGB_LED_GREEN);
-			start_stopwatch = 0x01;
+			if (Time_Sync_Schedule_Start() == 0x00)
+			{
+				Start_Stopwatch(Deferred_Work_Get_Timestamp_us());
+			}
 			break;
 		}
 		
 		// BTN1 (PA3) is pressed
+		// Stop the stopwatch, or select the next display resolution while it is stopped
 		case 0x08:
 		{
-			RGB_LED_Output(RGB_LED_RED);
-			start_stopwatch = 0x00;
+			if (start_stopwatch == 0x01)
+			{
+				RGB_LED_PWM_Set_Color(RGB_LED_PWM_MAX, 0, 0);
+				
+				uint32_t primask = __get_PRIMASK();
+				__disable_irq();
+				
+				run_total_us = Get_Stopwatch_Time_us(Deferred_Work_Get_Timestamp_us());
+				start_stopwatch = 0x00;
+				
+				__set_PRIMASK(primask);
+			}
+			else
+			{
+				display_resolution = (display_resolution + 1) % DISPLAY_RESOLUTION_COUNT;
+			}
 			break;
 		}
 		
 		// BTN2 (PA4) is pressed
 		case 0x10:
 		{
-			RGB_LED_Output(RGB_LED_OFF);
+			RGB_LED_PWM_Set_Color(0, 0, 0);
+			Release_Split();
 			reset_stopwatch = 0x01;
 			break;
 		}
 		
 		//BTN3 (PA5) is pressed
+		// Record a lap and hold its split time on the display while the stopwatch is running
+		// Pressing it again while a split is held releases the display to the running time
+		// While the stopwatch is stopped, page through the laps of the most recent session
 		case 0x20:
 		{
-			//GPIOB->DATA = GPIOB->DATA ^ 0x08;
+			if (start_stopwatch == 0x00)
+			{
+				Show_Next_History_Lap();
+			}
+			else if (split_held == 0x01)
+			{
+				Release_Split();
+			}
+			else
+			{
+				uint32_t lap_us = Get_Stopwatch_Time_us(Deferred_Work_Get_Timestamp_us());
+				Hold_Split(lap_us);
+				Lap_Log_Add_Lap(lap_us);
+			}
 			break;
 		}
 		
@@ -155,6 +459,8 @@ void PMOD_BTN_Handler(uint8_t pmod_btn_status)
 * @param	EduBase_button_status
 *					-0x08: Increment the counter
 *					-0x04: Decrement the counter
+*					-0x02: Start or stop a recording of the input events
+*					-0x01: Start or stop the replay of the recording
 *
 * @return
 */
@@ -188,53 +494,114 @@ void EduBase_Button_Handler(uint8_t edubase_button_status)
 			break;
 		}
 		
+		// SW4 (PD1) is pressed
+		case 0x02:
+		{
+			if (Input_Recorder_Get_State() == INPUT_RECORDER_IDLE)
+			{
+				Input_Recorder_Start_Recording();
+			}
+			else
+			{
+				Input_Recorder_Stop();
+			}
+			break;
+		}
+		
+		// SW5 (PD0) is pressed
+		case 0x01:
+		{
+			if (Input_Recorder_Get_State() == INPUT_RECORDER_IDLE)
+			{
+				Input_Recorder_Start_Replay();
+			}
+			else
+			{
+				Input_Recorder_Stop();
+			}
+			break;
+		}
+		
 		default:
 		{
 			break;
 		}
 	}
+	
+	// Show the counter as a bar graph on the EduBase LEDs
+	EduBase_LED_PWM_Show_Bar(counter, 15);
 }
 
 /**
 * @brief Calculates and stores the stopwatch time values into a provided array
 *
-*	This function extract the current stopwatch values. Each element of the array
-* has specific stopwatch time:
-* -Index 0: Milliseconds
-* -Index 1: Least significant digit of seconds
-* -Index 2: Most significant digit of seconds
-* -Index 3: Minutes
+*	This function formats the stopwatch time that is shown on the display, which is
+* the split time while a split is held and the running stopwatch value from the
+* microsecond time base otherwise. The format follows the selected resolution and
+* switches to a coarser format as the time grows:
+* - S.mmm below 10 seconds (thousandths)
+* - SS.hh below 1 minute (hundredths and thousandths)
+* - M.SS.t otherwise
+* Index 0 of the array holds the rightmost digit. A saturated stopwatch value is shown as EEEE.
 *
 * @param uint8_t stopwatch_value[]
 *
-* @return None
+* @return The digits that show a decimal point (Bit N for Index N).
 */
-void Calculate_Stopwatch_Value(uint8_t stopwatch_value[])
+uint8_t Calculate_Stopwatch_Value(uint8_t stopwatch_value[])
 {
-	// Store the "milliseconds" value in the first index of the array
-	stopwatch_value[0] = milliseconds;
+	uint32_t time_us = (split_held == 0x01) ? split_time_us : Get_Stopwatch_Time_us(Time_Base_Get_Time_us());
 	
-	// Store the least significant digit of the "seconds" value
-	// in the second index of the array
-	stopwatch_value[1] = seconds % 10;
+	// Show EEEE once the stopwatch value has saturated
+	if (time_us == STOPWATCH_MAX_US)
+	{
+		for (uint8_t i = 0; i < DISPLAY_DIGIT_COUNT; i++)
+		{
+			stopwatch_value[i] = DISPLAY_OVERFLOW_DIGIT;
+		}
+		return 0x00;
+	}
+	
+	// The display shows up to 9:59.9, like the tick counters
+	uint32_t time_ms = (time_us / 1000) % 600000;
+	uint32_t seconds = time_ms / 1000;
 	
-	// Store the most significant digit of the "seconds" value
-	// in the third index of the array
-	stopwatch_value[2] = seconds / 10;
+	if ((display_resolution == DISPLAY_THOUSANDTHS) && (time_ms < 10000))
+	{
+		// S.mmm
+		stopwatch_value[0] = time_ms % 10;
+		stopwatch_value[1] = (time_ms / 10) % 10;
+		stopwatch_value[2] = (time_ms / 100) % 10;
+		stopwatch_value[3] = seconds;
+		return 0x08;
+	}
 	
-	// Store the "minutes" value in the fourth index of the array
-	stopwatch_value[3] = minutes;
+	if ((display_resolution != DISPLAY_TENTHS) && (time_ms < 60000))
+	{
+		// SS.hh
+		stopwatch_value[0] = (time_ms / 10) % 10;
+		stopwatch_value[1] = (time_ms / 100) % 10;
+		stopwatch_value[2] = seconds % 10;
+		stopwatch_value[3] = seconds / 10;
+		return 0x04;
+	}
+	
+	// M.SS.t
+	stopwatch_value[0] = (time_ms / 100) % 10;
+	stopwatch_value[1] = (seconds % 60) % 10;
+	stopwatch_value[2] = (seconds % 60) / 10;
+	stopwatch_value[3] = seconds / 60;
+	return 0x0A;
 }
 
 /**
 * @brief The Periodic task will manage the stopwatch's time progression.
 *
-*	It increments the millisecond, second, and minute values of stopwatch
-* when the start stopwatch flag is set. The stopwatch will reset when the
-* the reset stopwatch flag is set. 
-* - Milliseconds increment after every 100ms
-* - Seconds increment after 10 milliseconds
-* - Minutes increment after every 60 seconds
+*	It advances the time base by one tick. The stopwatch value is calculated from the
+* time base values of the starts and stops, so the tick does not count it. When the
+* reset stopwatch flag is set while the stopwatch is running, the stopwatch is stopped
+* and a deferred task clears the stopwatch value. The synchronized start and the
+* replay of the recorded input events are also driven by the tick.
 *
 * @param None
 *
@@ -242,41 +609,251 @@ void Calculate_Stopwatch_Value(uint8_t stopwatch_value[])
 */
 void Timer_0A_Periodic_Task(void)
 {
-	if (start_stopwatch == 0x01)
+	// Advance the microsecond time base by one tick
+	Time_Base_Tick();
+	
+	if ((start_stopwatch == 0x01) && (reset_stopwatch == 0x01))
 	{
-		ms_elapsed++;
-		if(ms_elapsed > 99)
+		// Stop the stopwatch now and clear the stopwatch value from the PendSV interrupt
+		// The reset is tried again on the next tick if the queue is full
+		if (Deferred_Work_Post(&Stopwatch_Reset_Task, 0, 0) == 0x01)
 		{
-			ms_elapsed = 0;
-			milliseconds++;
+			reset_stopwatch = 0x00;
+			start_stopwatch = 0x00;
 		}
-		
-		if(milliseconds > 9)
+	}
+	
+	// Send the periodic synchronization messages and fire a scheduled start.
+	// This is done after the stopwatch update so that the first tick after
+	// a synchronized start is counted on every board at the same time.
+	Time_Sync_Tick();
+	
+	// Replay the input events that happened after this tick, so that their
+	// deferred handlers run before the next tick as they did during the recording
+	Input_Recorder_Tick();
+}
+
+/**
+* @brief Starts the stopwatch when the synchronized start fires.
+*
+* This function is executed from the Timer 0A interrupt on the tick
+* that reaches the start timestamp scheduled by the master board.
+*
+* @param None
+*
+* @return None
+*/
+void Synchronized_Start_Task(void)
+{
+	Start_Stopwatch(Time_Base_Get_Time_us());
+}
+
+/**
+* @brief Starts the stopwatch.
+*
+* A start from a cleared stopwatch begins a new session in the lap log.
+*
+* @param start_us The time base value of the start in microseconds.
+*
+* @return None
+*/
+void Start_Stopwatch(uint64_t start_us)
+{
+	if (start_stopwatch == 0x00)
+	{
+		if (Get_Stopwatch_Time_ms() == 0)
 		{
-			milliseconds = 0;
-			seconds++;
+			Lap_Log_Start_Session();
 		}
 		
-		if (seconds > 59)
-		{
-			seconds = 0;
-			minutes++;
-		}
+		// The start time and the flag are written together, since Timer 0A can interrupt this function
+		uint32_t primask = __get_PRIMASK();
+		__disable_irq();
 		
-		if (minutes > 9)
-		{
-			minutes = 0;
-			
-		}
+		run_start_us = start_us;
+		start_stopwatch = 0x01;
 		
-		if (reset_stopwatch == 0x01)
-		{
-			reset_stopwatch = 0x00;
-			start_stopwatch = 0x00;
-			ms_elapsed = 0;
-			milliseconds = 0;
-			seconds = 0;
-			minutes = 0;
-		}
+		__set_PRIMASK(primask);
+	}
+	
+	// Leave the lap history and show the running time
+	if (history_lap != 0)
+	{
+		history_lap = 0;
+		Release_Split();
+	}
+	
+	// Breathe green while the stopwatch is running
+	RGB_LED_PWM_Start_Pattern(RGB_LED_PWM_BREATHE, 0, RGB_LED_PWM_MAX, 0, 2000);
+}
+
+/**
+* @brief Returns the current stopwatch value in milliseconds.
+*
+* The value is 0 while the stopwatch is cleared, since the accumulated time
+* "run_total_us" is only cleared by a reset.
+*
+* @param None
+*
+* @return The stopwatch value in milliseconds.
+*/
+uint32_t Get_Stopwatch_Time_ms(void)
+{
+	return Get_Stopwatch_Time_us(Time_Base_Get_Time_us()) / 1000;
+}
+
+/**
+* @brief Returns the stopwatch value at a given time in microseconds.
+*
+* The value is calculated from the time base values of the starts and stops, so it
+* has microsecond resolution regardless of the Timer 0A tick. It saturates at
+* STOPWATCH_MAX_US instead of wrapping around.
+*
+* @param time_us The time base value in microseconds (e.g. the time of a button press).
+*
+* @return The stopwatch value in microseconds.
+*/
+uint32_t Get_Stopwatch_Time_us(uint64_t time_us)
+{
+	// Read the state of the stopwatch in one piece, since a start or stop can interrupt the main loop
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	
+	uint8_t running = start_stopwatch;
+	uint64_t start_us = run_start_us;
+	uint32_t total_us = run_total_us;
+	
+	__set_PRIMASK(primask);
+	
+	if ((running == 0x00) || (time_us < start_us))
+	{
+		return total_us;
+	}
+	
+	uint64_t value_us = (uint64_t)total_us + (time_us - start_us);
+	
+	return (value_us > STOPWATCH_MAX_US) ? STOPWATCH_MAX_US : (uint32_t)value_us;
+}
+
+/**
+* @brief Returns the time of the button press that is being handled.
+*
+* Live button presses are timestamped at the start of the GPIO interrupt. Replayed
+* button presses are dispatched at the end of a tick by the input recorder, so they
+* use the recorded time of the press relative to the start of the replay.
+*
+* @param None
+*
+* @return The time base value of the button press in microseconds.
+*/
+uint64_t Get_Button_Time_us(void)
+{
+	if (Input_Recorder_Get_State() == INPUT_RECORDER_REPLAYING)
+	{
+		return Input_Recorder_Get_Replay_Time_us();
+	}
+	
+	return PMOD_BTN_Get_Timestamp_us();
+}
+
+/**
+* @brief Resets the stopwatch and the EduBase counter to their initial state.
+*
+* This function is executed by the input recorder at the start of a recording
+* and of a replay.
+*
+* @param None
+*
+* @return None
+*/
+void Reset_Stopwatch_State(void)
+{
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	
+	start_stopwatch = 0x00;
+	run_total_us = 0;
+	
+	__set_PRIMASK(primask);
+	
+	reset_stopwatch = 0x00;
+	counter = 0;
+	history_lap = 0;
+	Release_Split();
+	
+	RGB_LED_PWM_Set_Color(0, 0, 0);
+	EduBase_LED_PWM_Show_Bar(counter, 15);
+}
+
+/**
+* @brief Holds the split time on the display while the stopwatch keeps running.
+*
+* The split time is latched and the display is switched to read it instead of the
+* running stopwatch value. Timer 0A keeps counting, so holding a split does not add
+* any work to the periodic task.
+*
+* @param split_us The stopwatch value of the split in microseconds.
+*
+* @return None
+*/
+void Hold_Split(uint32_t split_us)
+{
+	split_time_us = split_us;
+	split_held = 0x01;
+}
+
+/**
+* @brief Shows the split time of the next lap of the most recent session from the lap log.
+*
+* This function is executed as a deferred task from the PendSV interrupt while the stopwatch
+* is stopped. Each lap is read through the session index of the lap log in constant time.
+* After the last lap, the display returns to the stopwatch value.
+*
+* @param None
+*
+* @return None
+*/
+void Show_Next_History_Lap(void)
+{
+	Lap_Record record;
+	
+	history_lap++;
+	
+	if ((history_lap != 0) && (Lap_Log_Get_Lap(0, history_lap, &record) == 0x01))
+	{
+		Hold_Split(record.elapsed_us);
+	}
+	else
+	{
+		history_lap = 0;
+		Release_Split();
 	}
-}
\ No newline at end of file
+}
+
+/**
+* @brief Releases the split time, so the display catches up with the running stopwatch value.
+*
+* @param None
+*
+* @return None
+*/
+void Release_Split(void)
+{
+	split_held = 0x00;
+}
+
+/**
+* @brief Clears the stopwatch value after a reset.
+*
+* This function is executed as a deferred task from the PendSV interrupt.
+*
+* @param data Not used.
+*
+* @return None
+*/
+void Stopwatch_Reset_Task(uint8_t data)
+{
+	(void)data;
+	
+	run_total_us = 0;
+}